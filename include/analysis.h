@@ -0,0 +1,40 @@
+/*********************************************************************************/
+/*!
+ * \file      analysis.h
+ *
+ * \brief     The Same Game v0.1 --> ANALYSIS File
+ *
+ * \details   Facts about a position which are known without a search. A dead
+ * \n         position could never be cleared, an upper bound limits the
+ * \n         points which are still to get. Both only look at the counts of
+ * \n         the colors and the pairs, which every move keeps up to date, so
+ * \n         each check is O(colors) and cheap enough for every node of a
+ * \n         search.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include "samegame.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Function prototypes                                                          */
+/*-------------------------------------------------------------------------------*/
+bool ANA_IsDead(const SAGA_Board *pBoard);
+bool ANA_IsClearable(const SAGA_Board *pBoard);
+int  ANA_GetUpperBound(const SAGA_Board *pBoard);
+
+//---------------------------------------------------------------------------------
+#endif // ANALYSIS_H
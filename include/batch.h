@@ -0,0 +1,77 @@
+/*********************************************************************************/
+/*!
+ * \file      batch.h
+ *
+ * \brief     The Same Game v0.1 --> BATCH File
+ *
+ * \details   Random playouts of many boards in lockstep. The boards live in
+ * \n         the lanes of byte vectors, one vector for each block position,
+ * \n         so every step of a move, finding the removable blocks, the
+ * \n         flood fill of the group and the falling and sliding blocks, is
+ * \n         done for all lanes with the same vector operations. The moves
+ * \n         are the same as the ones of SAGA_BoardDeleteBlocks, and a lane
+ * \n         plays the same game as BAT_ScalarPlayout on its board.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#ifndef BATCH_H
+#define BATCH_H
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "samegame.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// boards of a batch, one byte lane each. Two words of ARMv6 SIMD on the
+// 3DS, one AVX2 register or two SSE2 registers on a host
+#ifndef BAT_LANES
+#ifdef _3DS
+#define BAT_LANES   8
+#else
+#define BAT_LANES  32
+#endif
+#endif
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+// one byte of every board, 0xFF and 0x00 in a mask
+typedef unsigned char BAT_Vec __attribute__((vector_size(BAT_LANES)));
+
+typedef struct {  // boards in lanes, the block arrays are laid out like SAGA_Board
+	BAT_Vec arrCells[SAGA_MAXCELLS];     // color index of the block in every lane
+	BAT_Vec arrMarks[SAGA_MAXCELLS];     // removable blocks, then the group of the move
+	BAT_Vec arrSame[SAGA_MAXCELLS];      // blocks with the color of the move
+	int nColumns, nRows;                 // size of all boards
+	int nUsedColumns;                    // columns used by any lane
+	uint32_t arrRandom[BAT_LANES][4];    // generator of each lane, see SAGA_Random
+	int arrScores[BAT_LANES];            // points of each lane
+	int arrRemaining[BAT_LANES];         // blocks of each lane
+	int arrMoves[BAT_LANES];             // moves played in each lane
+	SAGA_Cell arrTaps[BAT_LANES][SAGA_MAXGROUPS]; // tapped block of every move
+}BAT_Batch;
+
+/*-------------------------------------------------------------------------------*/
+/*  Function prototypes                                                          */
+/*-------------------------------------------------------------------------------*/
+void BAT_Init(BAT_Batch *pBatch, int nColumns, int nRows);
+void BAT_Load(BAT_Batch *pBatch, int nLane, const SAGA_Board *pBoard);
+void BAT_Store(const BAT_Batch *pBatch, int nLane, SAGA_Board *pBoard);
+int  BAT_Step(BAT_Batch *pBatch);
+void BAT_Playout(BAT_Batch *pBatch);
+int  BAT_ScalarPlayout(SAGA_Board *pBoard, SAGA_Cell *pTaps);
+
+//---------------------------------------------------------------------------------
+#endif // BATCH_H
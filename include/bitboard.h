@@ -0,0 +1,80 @@
+/*********************************************************************************/
+/*!
+ * \file      bitboard.h
+ *
+ * \brief     The Same Game v0.1 --> BITBOARD File
+ *
+ * \details   Alternative game engine backend which stores one bitmask per
+ * \n         color plus an occupancy mask. Groups are found with shift based
+ * \n         flood fills and the board is compacted with bit operations.
+ * \n         A search expands its positions about twice as fast with it on
+ * \n         10x7 boards, less on wide boards with long groups, see
+ * \n         tools/samebits. samebeam -b uses it.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria               
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "samegame.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// every column owns 8 bits of the 128 bit mask, bit 0 is the bottom block
+// and bit 7 stays empty as guard between the columns
+#define BITB_MAXCOLUMNS  16
+#define BITB_MAXROWS      7
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // 128 bit mask, columns 0-7 in lo and 8-15 in hi
+	uint64_t lo, hi;
+}BITB_Mask;
+
+typedef struct {  // bitboard, same rules as SAGA_Board
+	int nColumns;                        // board size information
+	int nRows;                           // board size information
+	int nRemaining;                      // number of remaining blocks
+	int nColors;                         // number of colors
+	BITB_Mask occupied;                  // all blocks on the board
+	BITB_Mask arrColors[SAGA_MAXCOLORS]; // blocks of color 1 .. nColors
+}BITB_Board;
+
+typedef struct {  // deletable group found by the move generator
+	BITB_Mask group;                     // all blocks of the group
+	unsigned char row, col;              // one block of the group
+	unsigned char color;                 // color index of the group
+	unsigned char size;                  // number of blocks
+}BITB_Move;
+
+/*-------------------------------------------------------------------------------*/
+/*  Function prototypes                                                          */
+/*-------------------------------------------------------------------------------*/
+void BITB_Init(void);
+bool BITB_FromBoard(BITB_Board *pBits, const SAGA_Board *pBoard);
+void BITB_ToBoard(const BITB_Board *pBits, SAGA_Board *pBoard);
+bool BITB_Equals(const BITB_Board *pBits, const SAGA_Board *pBoard);
+uint64_t BITB_GetCanonicalHash(const BITB_Board *pBits);
+int  BITB_GetBlock(const BITB_Board *pBits, int row, int col);
+bool BITB_IsGameOver(const BITB_Board *pBits);
+BITB_Mask BITB_GetGroup(const BITB_Board *pBits, int row, int col);
+int  BITB_DeleteBlocks(BITB_Board *pBits, int row, int col);
+void BITB_ApplyMove(BITB_Board *pBits, const BITB_Move *pMove);
+int  BITB_GenerateMoves(const BITB_Board *pBits, BITB_Move *pMoves, int nMaxMoves);
+
+//---------------------------------------------------------------------------------
+#endif // BITBOARD_H
@@ -0,0 +1,68 @@
+/*********************************************************************************/
+/*!
+ * \file      codec.h
+ *
+ * \brief     The Same Game v0.1 --> BOARD CODEC File
+ *
+ * \details   Compact binary form of a board for save files, replays, solver
+ * \n         caches and test fixtures. The full form stores every cell with
+ * \n         as few bits as the colors need and has a fixed size for a board
+ * \n         size, the short form only stores the blocks of the used columns
+ * \n         and is canonical, equal positions always give equal bytes.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#ifndef CODEC_H
+#define CODEC_H
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "samegame.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// columns, rows and colors lead both forms, one byte each
+#define CDC_HEADER     3
+
+// largest encoding of any board, 3 bits for a cell and 5 bits for a height
+#define CDC_MAXBYTES  (CDC_HEADER + (SAGA_MAXCELLS * 3 + SAGA_MAXCOLUMNS * 5 + 7) / 8)
+
+// saved game, the short form of the board follows the file header
+#define CDC_MAGIC      "SGSV"
+#define CDC_VERSION    1
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // start of a saved game
+	char arrMagic[4];                    // CDC_MAGIC
+	uint8_t nVersion;                    // CDC_VERSION
+	uint8_t arrReserved[3];
+	int32_t nScore;                      // points of the moves so far
+	uint64_t nGame;                      // game number of the board
+}CDC_File;
+
+/*-------------------------------------------------------------------------------*/
+/*  Function prototypes                                                          */
+/*-------------------------------------------------------------------------------*/
+int  CDC_PackedSize(int nColumns, int nRows, int nColors);
+int  CDC_Pack(const SAGA_Board *pBoard, uint8_t *pData, int nSize);
+int  CDC_Unpack(SAGA_Board *pBoard, const uint8_t *pData, int nSize);
+int  CDC_PackShort(const SAGA_Board *pBoard, uint8_t *pData, int nSize);
+int  CDC_UnpackShort(SAGA_Board *pBoard, const uint8_t *pData, int nSize);
+bool CDC_SaveGame(const SAGA_Board *pBoard, const char *pPath);
+bool CDC_LoadGame(SAGA_Board *pBoard, const char *pPath);
+
+//---------------------------------------------------------------------------------
+#endif // CODEC_H
@@ -0,0 +1,70 @@
+/*********************************************************************************/
+/*!
+ * \file      hint.h
+ *
+ * \brief     The Same Game v0.1 --> HINT File
+ *
+ * \details   Anytime search for the best group of a position. The search is
+ * \n         done in slices of a given number of microseconds, so it runs
+ * \n         in the spare time of every frame without blocking the main
+ * \n         loop. It keeps the best game found so far and starts over by
+ * \n         itself when the board it is given has another hash or score.
+ * \n         With an endgame tablebase the games end as soon as few enough
+ * \n         blocks are left.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#ifndef HINT_H
+#define HINT_H
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "samegame.h"
+#include "tablebase.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// search time of each frame in microseconds, run after RDR_SceneRender
+#define HINT_SLICE  2000
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // search state, lives from frame to frame
+	SAGA_Board Board;                    // position the hint is searched for
+	bool bValid;                         // Board and the groups are set up
+	SAGA_Group arrGroups[SAGA_MAXGROUPS]; // moves of the position
+	int nGroups;                         // number of moves
+	int nNext;                           // move of the next playout
+	const TBL_Table *pBase;              // endgame tablebase or NULL
+	uint64_t nSeed;                      // start of the random stream of a position
+	uint64_t nRandom;                    // state of the random stream
+	uint32_t nPlayouts;                  // games played from the position
+	int nBestScore;                      // score of the best game, -1 before the first
+	int nBestMoves;                      // number of moves of the best game
+	SAGA_Cell arrBest[SAGA_MAXGROUPS];   // best game, the first move is the hint
+}HINT_Search;
+
+/*-------------------------------------------------------------------------------*/
+/*  Function prototypes                                                          */
+/*-------------------------------------------------------------------------------*/
+void HINT_Init(HINT_Search *pHint, uint64_t nSeed);
+void HINT_SetTablebase(HINT_Search *pHint, const TBL_Table *pBase);
+void HINT_Invalidate(HINT_Search *pHint);
+int  HINT_Step(HINT_Search *pHint, const SAGA_Board *pBoard, uint32_t nMicros);
+int  HINT_GetBest(const HINT_Search *pHint, SAGA_Cell *pMove);
+int  HINT_GetGroup(const HINT_Search *pHint, SAGA_Cell *pCells);
+
+//---------------------------------------------------------------------------------
+#endif // HINT_H
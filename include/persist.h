@@ -0,0 +1,79 @@
+/*********************************************************************************/
+/*!
+ * \file      persist.h
+ *
+ * \brief     The Same Game v0.1 --> PERSISTENT BOARD File
+ *
+ * \details   Immutable boards which share their columns. The columns live
+ * \n         in a reference counted pool, a move only allocates the columns
+ * \n         it changes and all other columns are shared with the parent,
+ * \n         so search trees branch from a position without copying it.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#ifndef PERSIST_H
+#define PERSIST_H
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "samegame.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// index 0 of the pool is never used, it marks a missing column
+#define PERS_NOCOLUMN  0
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // shared column, bottom block first like in SAGA_Board
+	unsigned char arrCells[SAGA_MAXROWS];  // blocks of the column
+	unsigned char nHeight;                 // number of blocks
+	uint32_t nRefs;                        // boards using the column, 0 if free
+	uint32_t nNext;                        // next free column
+}PERS_Column;
+
+typedef struct {  // pool of columns, one per thread
+	PERS_Column *pColumns;               // storage, grows when it is full
+	uint32_t nSize;                      // number of columns in the storage
+	uint32_t nFree;                      // first free column
+	uint32_t nUsed;                      // columns in use
+}PERS_Pool;
+
+typedef struct {  // immutable board, only the column indices are its own
+	int nColumns;                        // board size information
+	int nRows;                           // board size information
+	int nRemaining;                      // number of remaining blocks
+	int nColors;                         // number of colors
+	int nUsedColumns;                    // non empty columns, always the leftmost ones
+	int nScore;                          // points of the moves so far
+	uint32_t arrColumns[SAGA_MAXCOLUMNS]; // pool index of each column
+}PERS_Board;
+
+/*-------------------------------------------------------------------------------*/
+/*  Function prototypes                                                          */
+/*-------------------------------------------------------------------------------*/
+bool PERS_PoolInit(PERS_Pool *pPool, uint32_t nSize);
+void PERS_PoolFree(PERS_Pool *pPool);
+bool PERS_FromBoard(PERS_Pool *pPool, PERS_Board *pPers, const SAGA_Board *pBoard);
+void PERS_ToBoard(const PERS_Pool *pPool, const PERS_Board *pPers, SAGA_Board *pBoard);
+void PERS_Retain(PERS_Pool *pPool, const PERS_Board *pPers);
+void PERS_Release(PERS_Pool *pPool, PERS_Board *pPers);
+int  PERS_GetBlock(const PERS_Pool *pPool, const PERS_Board *pPers, int row, int col);
+bool PERS_IsGameOver(const PERS_Pool *pPool, const PERS_Board *pPers);
+int  PERS_DeleteBlocks(PERS_Pool *pPool, const PERS_Board *pParent, int row, int col,
+                       PERS_Board *pChild);
+
+//---------------------------------------------------------------------------------
+#endif // PERSIST_H
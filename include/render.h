@@ -43,6 +43,12 @@
 #define YELLOW_SPRITE   2
 #define BLACK_SPRITE    7
 
+// position of the sprite of a block in 8.8 fixed point and the speed of
+// falling and sliding blocks in fixed point pixels per frame
+#define SPRITE_X(col)   (((col) * 32) << 8)
+#define SPRITE_Y(row)   (((row) * 32 + 7) << 8)
+#define SPRITE_SPEED    (8 << 8)
+
 
 /*-------------------------------------------------------------------------------*/
 /*  Type definitions                                                             */
@@ -60,10 +66,12 @@ typedef struct {  // simple sprite struct
 void RDR_DisplayInit(void);
 void RDR_DrawSprite( int x, int y, int width, int height, int image );
 void RDR_SceneInit(void);
-void RDR_MoveSprites(void);
+bool RDR_MoveSprites(void);
 void RDR_SceneRender(void);
 void RDR_SceneExit(void);
 void RDR_DrawGameBoard(void);
+void RDR_UpdateGameBoard(const SAGA_Event *pEvents, int nEvents);
+void RDR_SetHint(const SAGA_Cell *pCells, int nCells);
 void RDR_DrawSplashScreen(gfxScreen_t screen, const u8 image[], u32 image_size, u8 leftOrRight);
 
 //---------------------------------------------------------------------------------
@@ -0,0 +1,316 @@
+/*********************************************************************************/
+/*!
+ * \file      sagakernel.h
+ *
+ * \brief     The Same Game v0.1 --> ENGINE KERNEL File
+ *
+ * \details   The inner loops of the engine, written once and included by
+ * \n         samegame.c for every board height it specializes. Before the
+ * \n         include KERN_ROWS is set to the number of rows, either a
+ * \n         constant or (pBoard)->nRows for the generic kernels, and
+ * \n         KERN_NAME(name) gives the functions their names. With a
+ * \n         constant height the compiler unrolls the column loops and
+ * \n         turns every neighbor offset into an immediate.
+ * \n         With a constant height KERN_WORDS could be set to the number of
+ * \n         64 bit words a column needs, then the pairs are counted eight
+ * \n         blocks at a time. The bytes of a word are in little endian
+ * \n         order, like on the 3DS and the x86 hosts.
+ * \n         There is no include guard, the macros are undefined at the end.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#if !defined(KERN_ROWS) || !defined(KERN_NAME)
+#error "KERN_ROWS and KERN_NAME must be defined before including sagakernel.h"
+#endif
+
+#ifdef KERN_WORDS
+#if KERN_ROWS > 8 * KERN_WORDS || \
+    (SAGA_MAXCOLUMNS - 1) * KERN_ROWS + 8 * KERN_WORDS > SAGA_MAXCELLS
+#error "KERN_WORDS words must hold a column of KERN_ROWS and stay inside arrCells"
+#endif
+#ifndef KERN_SAME
+// bit 7 of every byte where both words hold the same block, but no hole.
+// Color indices are below 0x80, so adding 0x7F to a byte never carries
+#define KERN_SAME(a, b)  (~(((a) ^ (b)) + 0x7F7F7F7F7F7F7F7Full) & \
+                          ((a) + 0x7F7F7F7F7F7F7F7Full) & 0x8080808080808080ull)
+// the lowest n bytes of a word, none for n <= 0
+#define KERN_LANES(n)    ((n) <= 0 ? 0 : (n) >= 8 ? ~0ull : ((uint64_t)1 << (8 * (n))) - 1)
+// number of bytes with bit 7 set, the multiply adds them up in the top byte
+#define KERN_COUNT(x)    (int)((((x) >> 7) * 0x0101010101010101ull) >> 56)
+#endif
+#endif
+
+//*==============================================================================*/
+/*  KERN_NAME(CountPairs)                                                        */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Count touching blocks with the same color
+ *
+ * \details   Count the same colored pairs inside the columns nFirst .. nLast
+ * \n         and between these columns and their left and right neighbors.
+ * \n         Holes left by a deletion don't count as pairs.
+ *
+ * \param     pBoard --> board context, nFirst, nLast --> column range
+ *
+ * \return    number of pairs
+ */
+/*===============================================================================*/
+static int KERN_NAME(CountPairs)(const SAGA_Board *pBoard, int nFirst, int nLast)
+{
+  const int nRows = KERN_ROWS;
+#ifdef KERN_WORDS
+  uint64_t arrColumn[KERN_WORDS], arrNext[KERN_WORDS], nUp;
+  int w;
+#else
+  const unsigned char *pColumn;
+  int h;
+#endif
+  int col, nHeight, nPairs = 0;
+
+  if(nLast > pBoard->nUsedColumns - 1)
+    nLast = pBoard->nUsedColumns - 1;
+
+#ifdef KERN_WORDS
+  //  Every column is loaded into words, all its blocks are compared at once
+  //  with the block above and the block right of them. The bytes above the
+  //  heights belong to the next column and are masked off
+  for(col = nFirst > 0 ? nFirst - 1 : 0; col <= nLast; col++)
+  {
+    memcpy(arrColumn, &pBoard->arrCells[col * nRows], sizeof(arrColumn));
+    nHeight = pBoard->arrHeights[col];
+    if(col >= nFirst)
+      for(w = 0; w < KERN_WORDS; w++)
+      {
+        nUp = arrColumn[w] >> 8;
+        if(w + 1 < KERN_WORDS)
+          nUp |= arrColumn[w + 1] << 56;
+        nPairs += KERN_COUNT(KERN_SAME(arrColumn[w], nUp) & KERN_LANES(nHeight - 1 - 8 * w));
+      }
+    if(col + 1 >= pBoard->nUsedColumns)
+      break;
+    memcpy(arrNext, &pBoard->arrCells[(col + 1) * nRows], sizeof(arrNext));
+    if(nHeight > pBoard->arrHeights[col + 1])
+      nHeight = pBoard->arrHeights[col + 1];
+    for(w = 0; w < KERN_WORDS; w++)
+      nPairs += KERN_COUNT(KERN_SAME(arrColumn[w], arrNext[w]) & KERN_LANES(nHeight - 8 * w));
+  }
+#else
+  //  Pairs above each other
+  for(col = nFirst; col <= nLast; col++)
+  {
+    pColumn = &pBoard->arrCells[col * nRows];
+    for(h = pBoard->arrHeights[col] - 1; h > 0; h--)
+      nPairs += pColumn[h] != 0 && pColumn[h] == pColumn[h - 1];
+  }
+
+  //  Pairs next to each other, including the left and right border column
+  for(col = nFirst > 0 ? nFirst - 1 : 0; col <= nLast && col + 1 < pBoard->nUsedColumns; col++)
+  {
+    pColumn = &pBoard->arrCells[col * nRows];
+    nHeight = pBoard->arrHeights[col];
+    if(nHeight > pBoard->arrHeights[col + 1])
+      nHeight = pBoard->arrHeights[col + 1];
+    for(h = 0; h < nHeight; h++)
+      nPairs += pColumn[h] != 0 && pColumn[h] == pColumn[h + nRows];
+  }
+#endif
+  return nPairs;
+}
+
+//*==============================================================================*/
+/*  KERN_NAME(DeleteNeighborBlocks)                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Deleting a group of blocks
+ *
+ * \details   Kernel of SAGA_BoardDeleteNeighborBlocks, the flood fill with
+ * \n         the column stride known at compile time.
+ *
+ * \param     pBoard --> board context, row, column, color,
+ * \n         pRemoved --> list of deleted blocks or NULL
+ *
+ * \return    nCount --> number of deleted pieces
+ */
+/*===============================================================================*/
+static int KERN_NAME(DeleteNeighborBlocks)(SAGA_Board *pBoard, int row, int col, int color,
+                                           SAGA_Cell *pRemoved)
+{
+  SAGA_Cell arrQueue[SAGA_MAXCELLS];
+  SAGA_Cell *pQueue = pRemoved ? pRemoved : arrQueue;
+  const int nRows = KERN_ROWS;
+  unsigned char *pCells = pBoard->arrCells;
+  int nHead = 0, nCount = 0, nPairs = 0, h, cell;
+
+  //  Check if it is on the board and has the same color
+  if(row < 0 || row >= nRows || col < 0 || col >= pBoard->nColumns)
+    return 0;
+  if(pCells[col * nRows + nRows - 1 - row] != color)
+    return 0;
+
+  pCells[col * nRows + nRows - 1 - row] = SAGA_MARK;
+  pQueue[nCount].row = row;
+  pQueue[nCount++].col = col;
+
+  while(nHead < nCount)
+  {
+    row = pQueue[nHead].row;
+    col = pQueue[nHead++].col;
+    h = nRows - 1 - row;
+    cell = col * nRows + h;
+    pBoard->nDirtyColumns |= 1u << col;
+    //  Check up
+    if(h + 1 < pBoard->arrHeights[col])
+    {
+      if(pCells[cell + 1] == color)
+      {
+        pCells[cell + 1] = SAGA_MARK;
+        pQueue[nCount].row = row - 1;
+        pQueue[nCount++].col = col;
+      }
+      nPairs += pCells[cell + 1] == SAGA_MARK;
+    }
+    //  Check down
+    if(h > 0)
+    {
+      if(pCells[cell - 1] == color)
+      {
+        pCells[cell - 1] = SAGA_MARK;
+        pQueue[nCount].row = row + 1;
+        pQueue[nCount++].col = col;
+      }
+      nPairs += pCells[cell - 1] == SAGA_MARK;
+    }
+    //  Check left
+    if(col > 0)
+    {
+      if(pCells[cell - nRows] == color)
+      {
+        pCells[cell - nRows] = SAGA_MARK;
+        pQueue[nCount].row = row;
+        pQueue[nCount++].col = col - 1;
+      }
+      nPairs += pCells[cell - nRows] == SAGA_MARK;
+    }
+    //  Check right
+    if(col + 1 < pBoard->nUsedColumns)
+    {
+      if(pCells[cell + nRows] == color)
+      {
+        pCells[cell + nRows] = SAGA_MARK;
+        pQueue[nCount].row = row;
+        pQueue[nCount++].col = col + 1;
+      }
+      nPairs += pCells[cell + nRows] == SAGA_MARK;
+    }
+  }
+
+  //  Now really delete the marked blocks
+  for(nHead = 0; nHead < nCount; nHead++)
+  {
+    col = pQueue[nHead].col;
+    h = nRows - 1 - pQueue[nHead].row;
+    pCells[col * nRows + h] = 0;
+    pBoard->arrColorHashes[color] ^= SAGA_PlaceKey(col, h);
+  }
+
+  //  Every pair inside the group was seen from both of its blocks
+  pBoard->nPairs -= nPairs / 2;
+  pBoard->arrColorCounts[color] -= nCount;
+  pBoard->nHash = SAGA_CombineHashes(pBoard);
+  return nCount;
+}
+
+//*==============================================================================*/
+/*  KERN_NAME(Compact)                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compact a gameboard
+ *
+ * \details   Kernel of SAGA_BoardCompact, every column offset and the size
+ * \n         of a removed column are known at compile time.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void KERN_NAME(Compact)(SAGA_Board *pBoard)
+{
+  const int nRows = KERN_ROWS;
+  unsigned char *pColumn, *pShift;
+  int col, h, nRead, nWrite, nHeight, nMove, nFirst, nLast, nShift;
+
+  if(pBoard->nDirtyColumns == 0)
+    return;
+
+  //  Forget the pairs around the touched columns
+  nFirst = __builtin_ctz(pBoard->nDirtyColumns);
+  nLast = 31 - __builtin_clz(pBoard->nDirtyColumns);
+  pBoard->nPairs -= KERN_NAME(CountPairs)(pBoard, nFirst, nLast);
+
+  //  Right to left, so removing a column doesn't move a dirty one
+  for(col = nLast; col >= nFirst; col--)
+  {
+    if(!(pBoard->nDirtyColumns & (1u << col)))
+      continue;
+
+    //  First move everything down, starting at the lowest hole
+    pColumn = &pBoard->arrCells[col * nRows];
+    nHeight = pBoard->arrHeights[col];
+    for(nWrite = 0; nWrite < nHeight && pColumn[nWrite] != 0; nWrite++)
+      ;
+    for(nRead = nWrite + 1; nRead < nHeight; nRead++)
+    {
+      if(pColumn[nRead] != 0)
+      {
+        pBoard->arrColorHashes[pColumn[nRead]] ^= SAGA_PlaceKey(col, nRead) ^
+                                                  SAGA_PlaceKey(col, nWrite);
+        pColumn[nWrite++] = pColumn[nRead];
+        pColumn[nRead] = 0;
+      }
+    }
+    pBoard->arrHeights[col] = nWrite;
+
+    //  Then remove the column if it got empty, all blocks right of it
+    //  get a new position. The keys depend on the column, so each of these
+    //  blocks is rehashed, O(blocks right of it). Relocatable hashes would
+    //  need a hash per column and color in every board and make each copy
+    //  larger.
+    if(nWrite == 0)
+    {
+      for(nShift = col + 1; nShift < pBoard->nUsedColumns; nShift++)
+      {
+        pShift = &pBoard->arrCells[nShift * nRows];
+        for(h = 0; h < pBoard->arrHeights[nShift]; h++)
+          pBoard->arrColorHashes[pShift[h]] ^= SAGA_PlaceKey(nShift, h) ^
+                                               SAGA_PlaceKey(nShift - 1, h);
+      }
+      nMove = pBoard->nUsedColumns - col - 1;
+      memmove(pColumn, pColumn + nRows, nMove * nRows);
+      memmove(&pBoard->arrHeights[col], &pBoard->arrHeights[col + 1], nMove);
+      pBoard->nUsedColumns--;
+      memset(&pBoard->arrCells[pBoard->nUsedColumns * nRows], 0, nRows);
+      pBoard->arrHeights[pBoard->nUsedColumns] = 0;
+      nLast--;
+    }
+  }
+  pBoard->nDirtyColumns = 0;
+
+  //  Count the pairs of the compacted columns and their new neighbors
+  pBoard->nPairs += KERN_NAME(CountPairs)(pBoard, nFirst, nLast);
+  pBoard->nHash = SAGA_CombineHashes(pBoard);
+  SAGA_CHECK(pBoard);
+}
+
+#undef KERN_ROWS
+#undef KERN_NAME
+#undef KERN_WORDS
+//----------------------------------- END --------------------------------------
@@ -24,6 +24,12 @@
 #ifndef _SAMEGAME_H
 #define _SAMEGAME_H
 
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
 /*-------------------------------------------------------------------------------*/
 /*  Defines                                                                      */
 /*-------------------------------------------------------------------------------*/
@@ -42,18 +48,94 @@
 #define BLOCKWIDTH   32
 #define NUMOFCOLORS   3
 
+// limits of the static board storage, one byte per block
+#define SAGA_MAXCOLUMNS  20
+#define SAGA_MAXROWS     16
+#define SAGA_MAXCELLS   256
+#define SAGA_MAXCOLORS    7
+#define SAGA_MAXGROUPS  (SAGA_MAXCELLS / 2)
+
+// label of blocks which don't belong to a deletable group
+#define SAGA_NOGROUP   0xFF
+
+// points of a cleared board on top of the points of its groups
+#define SAGA_CLEARBONUS  1000
+
+// game numbers with this bit set give boards which could be cleared, see
+// SAGA_BoardSetupClearableGame
+#define SAGA_CLEARABLEGAME  (1ull << 63)
+
+// changes of the board caused by a move, a block is removed or moved at
+// most once, so one event per block and one per column are enough
+#define SAGA_EVENT_REMOVE  0
+#define SAGA_EVENT_FALL    1
+#define SAGA_EVENT_SHIFT   2
+#define SAGA_MAXEVENTS  (SAGA_MAXCELLS + SAGA_MAXCOLUMNS)
+
 #define false   0
 #define true    1
 //#define RAND_MAX  10
 
-// direction enumeration for deleting blocks
-enum Direction
-{
-  DIRECTION_UP,
-  DIRECTION_DOWN,
-  DIRECTION_LEFT,
-  DIRECTION_RIGHT
-};
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // position of a single block
+  unsigned char row, col;
+}SAGA_Cell;
+
+typedef struct {  // deletable group of blocks
+  unsigned char row, col;              // representative, lowest block of the leftmost column
+  unsigned short size;                 // number of blocks, all SAGA_MAXCELLS of one color
+  unsigned char color;                 // color index of the group
+}SAGA_Group;
+
+typedef struct {  // independent game board, all engine state lives in here
+  int nColumns;                        // board size information
+  int nRows;                           // board size information
+  int nRemaining;                      // number of remaining blocks
+  int nColors;                         // number of colors
+  int nUsedColumns;                    // non empty columns, always the leftmost ones
+  unsigned int nDirtyColumns;          // columns touched since the last compaction
+  int nPairs;                          // touching blocks with the same color
+  int nKernel;                         // engine kernels for the board height
+  int nScore;                          // points of the moves so far
+  uint64_t nHash;                      // hash of all blocks and their colors
+  uint64_t nGame;                      // game number of the last numbered setup
+  uint32_t arrRandom[4];               // xoshiro128** state, own stream of each board
+  // Zobrist hash of the positions of each color, the keys don't depend on
+  // the color, so renaming the colors only swaps these hashes
+  uint64_t arrColorHashes[SAGA_MAXCOLORS + 1];
+  unsigned short arrColorCounts[SAGA_MAXCOLORS + 1]; // blocks of each color, 0 is unused
+  unsigned char arrHeights[SAGA_MAXCOLUMNS]; // number of blocks in each column
+  // packed game data, one byte per block, stored column by column with the
+  // bottom block first, so block h of column col is arrCells[col * nRows + h]
+  unsigned char arrCells[SAGA_MAXCELLS];
+}SAGA_Board;
+
+typedef struct {  // delta record of one move
+  unsigned short nFirst;               // first removed block in arrCells of the journal
+  unsigned short nCount;               // number of removed blocks
+  unsigned char nColor;                // color index of the removed blocks
+  unsigned int nCollapsed;             // columns which got empty, layout before the move
+  int nPairs;                          // pair count before the move
+  uint64_t nHash;                      // hash before the move
+  uint64_t arrColorHashes[SAGA_MAXCOLORS + 1]; // color hashes before the move
+}SAGA_JournalMove;
+
+typedef struct {  // undo/redo journal of one line of play
+  int nMoves;                          // moves done, the next undo takes back nMoves - 1
+  int nTop;                            // moves recorded, above nMoves after an undo
+  // every block is removed once in a line of play, so the records never
+  // need more than one slot per block and one move per two blocks
+  SAGA_JournalMove arrMoves[SAGA_MAXGROUPS];
+  SAGA_Cell arrCells[SAGA_MAXCELLS];   // removed blocks, layout before their move
+}SAGA_Journal;
+
+typedef struct {  // change of the board by a move
+  unsigned char type;                  // SAGA_EVENT_REMOVE, _FALL or _SHIFT
+  unsigned char row, col;              // block before the move, row is 0 for a column
+  unsigned char newRow, newCol;        // block or column after the move
+}SAGA_Event;
 
 /*-------------------------------------------------------------------------------*/
 /*  Function prototypes                                                          */
@@ -64,12 +146,67 @@ char SAGA_GetBlockColor(int row, int col);
 int  SAGA_GetColumns(void);
 int  SAGA_GetRows(void);
 bool SAGA_IsGameOver(void);
+bool SAGA_IsGameLost(void);
 int  SAGA_GetRemainingCount(void);
 int  SAGA_DeleteBlocks(int row, int col);
 int  SAGA_GetNumColors(void);
 void SAGA_CreateBoard(void);
 void SAGA_DeleteBoard(void);
-int  SAGA_DeleteNeighborBlocks(int row, int col, int color, enum Direction direction);
+int  SAGA_DeleteNeighborBlocks(int row, int col, int color, SAGA_Cell *pRemoved);
 void SAGA_CompactBoard(void);
+int  SAGA_EnumerateMoves(SAGA_Group *pGroups, int nMaxGroups);
+int  SAGA_UndoMove(void);
+uint64_t SAGA_GetHash(void);
+void SAGA_SetupGame(uint64_t nGame);
+void SAGA_SetupClearableBoard(void);
+uint64_t SAGA_GetGameNumber(void);
+int  SAGA_RedoMove(void);
+int  SAGA_GetMoveEvents(SAGA_Event *pEvents);
+int  SAGA_GetScore(void);
+int  SAGA_GetMoveScore(int nCount);
+const SAGA_Board *SAGA_GetBoard(void);
+bool SAGA_ResumeBoard(const SAGA_Board *pBoard);
+
+// reentrant functions working on an explicit board context
+bool SAGA_BoardIsValidSize(int nColumns, int nRows, int nColors);
+bool SAGA_BoardInit(SAGA_Board *pBoard, int nColumns, int nRows, int nColors);
+void SAGA_BoardClear(SAGA_Board *pBoard);
+void SAGA_BoardSetup(SAGA_Board *pBoard);
+void SAGA_BoardRefresh(SAGA_Board *pBoard);
+void SAGA_BoardSeed(SAGA_Board *pBoard, uint64_t nSeed);
+uint32_t SAGA_BoardRandom(SAGA_Board *pBoard);
+uint32_t SAGA_Random(uint32_t *s);
+void SAGA_BoardSetupGame(SAGA_Board *pBoard, uint64_t nGame);
+int  SAGA_BoardSetupClearableGame(SAGA_Board *pBoard, uint64_t nGame, SAGA_Cell *pSolution);
+void SAGA_BoardGenerate(SAGA_Board *pBoards, int nBoards, int nColumns, int nRows, int nColors,
+                        uint64_t nFirstGame);
+int  SAGA_BoardSetupClearable(SAGA_Board *pBoard, SAGA_Cell *pSolution);
+bool SAGA_BoardVerifySolution(const SAGA_Board *pBoard, const SAGA_Cell *pSolution, int nMoves);
+void SAGA_BoardCopy(SAGA_Board *pDest, const SAGA_Board *pSrc);
+SAGA_Board *SAGA_BoardClone(const SAGA_Board *pSrc);
+void SAGA_BoardFree(SAGA_Board *pBoard);
+int  SAGA_BoardGetBlock(const SAGA_Board *pBoard, int row, int col);
+char SAGA_BoardGetBlockColor(const SAGA_Board *pBoard, int row, int col);
+bool SAGA_BoardIsGameOver(const SAGA_Board *pBoard);
+uint64_t SAGA_BoardGetHash(const SAGA_Board *pBoard);
+uint64_t SAGA_BoardGetCanonicalHash(const SAGA_Board *pBoard);
+uint64_t SAGA_GetCanonicalHash(const uint64_t *pColorHashes, int nColors);
+uint64_t SAGA_GetPlaceKey(int col, int h);
+int  SAGA_BoardCanonicalize(SAGA_Board *pBoard, unsigned char *pMap);
+int  SAGA_BoardDeleteBlocks(SAGA_Board *pBoard, int row, int col);
+int  SAGA_BoardDeleteBlocksEx(SAGA_Board *pBoard, int row, int col, SAGA_Cell *pRemoved);
+int  SAGA_BoardDeleteNeighborBlocks(SAGA_Board *pBoard, int row, int col, int color,
+                                    SAGA_Cell *pRemoved);
+void SAGA_BoardCompact(SAGA_Board *pBoard);
+int  SAGA_BoardEnumerateMoves(const SAGA_Board *pBoard, SAGA_Group *pGroups, int nMaxGroups,
+                              unsigned char *pLabels);
+
+// make/unmake with a journal of deltas
+void SAGA_JournalClear(SAGA_Journal *pJournal);
+int  SAGA_BoardMakeMove(SAGA_Board *pBoard, int row, int col, SAGA_Journal *pJournal);
+int  SAGA_BoardUnmakeMove(SAGA_Board *pBoard, SAGA_Journal *pJournal);
+int  SAGA_BoardRedoMove(SAGA_Board *pBoard, SAGA_Journal *pJournal);
+int  SAGA_BoardGetMoveEvents(const SAGA_Board *pBoard, const SAGA_Journal *pJournal,
+                             SAGA_Event *pEvents);
 
 #endif	/* _SAMEGAME_H */
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*********************************************************************************/
+/*!
+ * \file      solver.h
+ *
+ * \brief     The Same Game v0.1 --> SOLVER File
+ *
+ * \details   Exact search whether a board could be cleared completely. The
+ * \n         positions proven to be dead are kept in a table, which could be
+ * \n         shared by any number of threads searching the same or other
+ * \n         boards at the same time. With an endgame tablebase the search
+ * \n         stops as soon as few enough blocks are left.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#ifndef SOLVER_H
+#define SOLVER_H
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "samegame.h"
+#include "tablebase.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// results of a search besides the number of moves of a solution
+#define SOLV_DEAD     -1               // proven that the board can't be cleared
+#define SOLV_STOPPED  -2               // stopped before there was a result
+
+// slots of the table which are searched for a key
+#define SOLV_BUCKET    4
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // table of dead positions, shared without locks
+	uint64_t *pKeys;                     // position keys, 0 marks an empty slot
+	uint64_t nMask;                      // number of slots - 1, a power of 2
+	const TBL_Table *pBase;              // endgame tablebase or NULL, set by the caller
+	bool bExact;                         // key on the colors too, set by the caller
+}SOLV_Table;
+
+typedef struct {  // counters of a search
+	uint64_t nNodes;                     // positions searched
+	uint64_t nProbes;                    // table lookups
+	uint64_t nHits;                      // lookups which found a dead position
+	uint64_t nEndgames;                  // positions decided by the tablebase
+}SOLV_Stats;
+
+/*-------------------------------------------------------------------------------*/
+/*  Function prototypes                                                          */
+/*-------------------------------------------------------------------------------*/
+bool SOLV_TableInit(SOLV_Table *pTable, int nBits);
+void SOLV_TableFree(SOLV_Table *pTable);
+void SOLV_TableClear(SOLV_Table *pTable);
+uint64_t SOLV_GetKey(const SAGA_Board *pBoard);
+int  SOLV_Solve(const SAGA_Board *pBoard, SOLV_Table *pTable, int nOrder, int *pStop,
+                SAGA_Cell *pSolution, SOLV_Stats *pStats);
+
+//---------------------------------------------------------------------------------
+#endif // SOLVER_H
@@ -28,10 +28,13 @@
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
+#include <sys/stat.h>
 
 // project related headers
 #include "lodepng.h"
 #include "samegame.h"
+#include "codec.h"
+#include "hint.h"
 #include "render.h"
 
 // these headers are generated by the build process
@@ -52,6 +55,11 @@
 #define NEW_GAME_MODE   2
 #define GAME_END_MODE   3
 #define POWER_OFF_MODE  4
+// endgame tablebase of tools/sametb, the game runs without it as well
+#define ENDGAME_FILE    "sdmc:/3ds/samegame/endgame.tb"
+// game left with START, it is continued at the next start
+#define SAVE_DIR        "sdmc:/3ds/samegame"
+#define SAVE_FILE       SAVE_DIR "/game.sav"
 #define VALID_NEW_TOUCH_POS touch.px > 0 && touch.py > 0 && touch.px != t_queue.px && touch.py != t_queue.py
 
 /*-------------------------------------------------------------------------------*/
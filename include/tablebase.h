@@ -0,0 +1,97 @@
+/*********************************************************************************/
+/*!
+ * \file      tablebase.h
+ *
+ * \brief     The Same Game v0.1 --> ENDGAME TABLEBASE File
+ *
+ * \details   Exact values of all compacted positions with a few blocks left.
+ * \n         The positions are numbered without gaps by their block count,
+ * \n         their column heights and their colors, so the number is a
+ * \n         perfect hash and a lookup is one array access. Positions which
+ * \n         only differ by renamed colors have the same value and share
+ * \n         one number, the colors are renamed in the order they appear
+ * \n         like SAGA_BoardCanonicalize does. The file is a small header
+ * \n         and the array of values, it could be mapped into memory as it
+ * \n         is.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+#include "samegame.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// up to this many blocks the clear bonus outweighs any other score, so the
+// best line of a clearable position always clears it
+#define TBL_MAXBLOCKS  32
+
+// a value holds the best score still to get and whether it clears the board
+#define TBL_CLEAR      0x8000
+#define TBL_SCORE(v)   ((v) & 0x7FFF)
+
+// index of a position which isn't in the table
+#define TBL_NONE       UINT64_MAX
+
+#define TBL_MAGIC      "SGTB"
+#define TBL_VERSION    2
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // start of the file, the values follow
+	char arrMagic[4];                    // TBL_MAGIC
+	uint8_t nVersion;                    // TBL_VERSION
+	uint8_t nColumns;                    // largest board of the table
+	uint8_t nRows;
+	uint8_t nColors;                     // positions with up to nColors colors
+	uint8_t nBlocks;                     // positions with up to nBlocks blocks
+	uint8_t arrReserved[3];
+	uint32_t nBonus;                     // SAGA_CLEARBONUS of the values
+	uint64_t nEntries;                   // number of values
+}TBL_Header;
+
+typedef struct {  // loaded or generated table
+	int nColumns, nRows, nColors, nBlocks;
+	uint64_t nEntries;                   // number of positions
+	// arrShapes[m][n] counts the heights of up to m columns with n blocks
+	uint64_t arrShapes[SAGA_MAXCOLUMNS + 1][TBL_MAXBLOCKS + 1];
+	// arrColorings[n][m] counts the colorings of n more blocks after m colors
+	// were used, a new color is always the next one
+	uint64_t arrColorings[TBL_MAXBLOCKS + 1][SAGA_MAXCOLORS + 1];
+	uint64_t arrFirst[TBL_MAXBLOCKS + 2];  // index of the first position with n blocks
+	uint16_t *pValues;                   // one value for each position
+	void *pData;                         // memory of the values, mapped or allocated
+	size_t nSize;                        // size of pData
+	bool bMapped;                        // pData is a mapping of the file
+}TBL_Table;
+
+/*-------------------------------------------------------------------------------*/
+/*  Function prototypes                                                          */
+/*-------------------------------------------------------------------------------*/
+bool TBL_Init(TBL_Table *pTable, int nColumns, int nRows, int nColors, int nBlocks);
+bool TBL_Open(TBL_Table *pTable, const char *pPath);
+bool TBL_Save(const TBL_Table *pTable, const char *pPath);
+void TBL_Free(TBL_Table *pTable);
+uint64_t TBL_GetIndex(const TBL_Table *pTable, const SAGA_Board *pBoard);
+void TBL_SetupBoard(const TBL_Table *pTable, uint64_t nIndex, SAGA_Board *pBoard);
+int  TBL_Probe(const TBL_Table *pTable, const SAGA_Board *pBoard);
+int  TBL_GetBestMove(const TBL_Table *pTable, const SAGA_Board *pBoard, SAGA_Cell *pMove);
+
+//---------------------------------------------------------------------------------
+#endif // TABLEBASE_H
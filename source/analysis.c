@@ -0,0 +1,119 @@
+/*********************************************************************************/
+/*!
+ * \file      analysis.c
+ *
+ * \brief     The Same Game v0.1 --> ANALYSIS File
+ *
+ * \details   Proofs about a position without a search. A move removes two or
+ * \n         more blocks of one color and never changes the color of a
+ * \n         block, so a color with a single block left keeps it for ever.
+ * \n         The points of a color are largest if all its blocks go in one
+ * \n         move, (a + b - 2)^2 is more than (a - 2)^2 + (b - 2)^2 for all
+ * \n         groups a, b of at least two blocks. Arguments on the parity of
+ * \n         the colors in a column don't hold, every group of two or more
+ * \n         blocks could be removed and blocks fall across the rows, so no
+ * \n         parity is kept by a move.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include "analysis.h"
+
+//*==============================================================================*/
+/*  ANA_IsDead                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Could the board never be cleared?
+ *
+ * \details   A board with blocks is dead if there is no move left or if a
+ * \n         color has a single block, it could never be removed. A search
+ * \n         could cut a dead position at once. An empty board is not dead.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    true if the board is proven to be dead
+ */
+/*===============================================================================*/
+bool ANA_IsDead(const SAGA_Board *pBoard)
+{
+  int i;
+
+  if(pBoard->nRemaining == 0)
+    return false;
+  if(pBoard->nPairs == 0)
+    return true;
+  for(i = 1; i <= pBoard->nColors; i++)
+    if(pBoard->arrColorCounts[i] == 1)
+      return true;
+  return false;
+}
+
+//*==============================================================================*/
+/*  ANA_IsClearable                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Could the board be cleared for sure?
+ *
+ * \details   True for an empty board and for a board with a single color of
+ * \n         two or more blocks. The columns are compacted to the bottom
+ * \n         left, so all blocks touch each other and go in one move. Most
+ * \n         boards are neither dead nor proven to be clearable.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    true if the board is proven to be clearable
+ */
+/*===============================================================================*/
+bool ANA_IsClearable(const SAGA_Board *pBoard)
+{
+  int i;
+
+  for(i = 1; i <= pBoard->nColors; i++)
+    if(pBoard->arrColorCounts[i] != 0 && pBoard->arrColorCounts[i] != pBoard->nRemaining)
+      return false;
+  return pBoard->nRemaining != 1;
+}
+
+//*==============================================================================*/
+/*  ANA_GetUpperBound                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Most points still to get
+ *
+ * \details   Every color is taken as if all its blocks went in one move and
+ * \n         the clear bonus is added unless the board is dead. No line of
+ * \n         play gets more, so a search for the best score could cut every
+ * \n         position whose score plus this bound doesn't beat the best
+ * \n         game so far. The bound is exact for a single color.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    upper bound of the points on top of the score of the board
+ */
+/*===============================================================================*/
+int ANA_GetUpperBound(const SAGA_Board *pBoard)
+{
+  int i, nBound = 0;
+
+  if(pBoard->nRemaining == 0 || pBoard->nPairs == 0)
+    return 0;
+  for(i = 1; i <= pBoard->nColors; i++)
+    if(pBoard->arrColorCounts[i] >= 2)
+      nBound += SAGA_GetMoveScore(pBoard->arrColorCounts[i]);
+  if(!ANA_IsDead(pBoard))
+    nBound += SAGA_CLEARBONUS;
+  return nBound;
+}
+
+//----------------------------------- END --------------------------------------
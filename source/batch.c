@@ -0,0 +1,505 @@
+/*********************************************************************************/
+/*!
+ * \file      batch.c
+ *
+ * \brief     The Same Game v0.1 --> BATCH File
+ *
+ * \details   Lockstep playouts of BAT_LANES boards. Block i of every board
+ * \n         is byte i of the vector arrCells[i], so a step of the move is
+ * \n         one pass over the positions of the largest board with vector
+ * \n         operations, no matter how many lanes there are. The vectors
+ * \n         are GCC vector extensions, they become SSE2 or AVX2 on a host.
+ * \n         The ARM11 of the 3DS has no vector unit, but its ARMv6 SIMD
+ * \n         instructions work on the four bytes of a word, uadd8 adds them
+ * \n         and usub8 with sel compares them, the rest is plain bit logic.
+ * \n         The move of a lane is a random removable block, picked with
+ * \n         the generator of its board like BAT_ScalarPlayout does, so a
+ * \n         lane plays exactly the game of the scalar engine.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <string.h>
+#include "batch.h"
+#ifdef __ARM_FEATURE_SIMD32
+#include <arm_acle.h>
+#endif
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef union {  // vector as words, for the ARMv6 SIMD instructions
+  BAT_Vec v;
+  uint32_t w[BAT_LANES / 4];
+}BAT_Words;
+
+//*==============================================================================*/
+/*  BAT_Eq                                                                       */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compare the lanes of two vectors
+ *
+ * \details   usub8 sets the GE flag of every byte of the difference which
+ * \n         isn't 0, sel then takes 0x00 for these bytes and 0xFF for
+ * \n         the others.
+ *
+ * \param     a, b --> vectors
+ *
+ * \return    0xFF in every lane where a and b are equal, 0x00 elsewhere
+ */
+/*===============================================================================*/
+static inline BAT_Vec BAT_Eq(BAT_Vec a, BAT_Vec b)
+{
+#ifdef __ARM_FEATURE_SIMD32
+  BAT_Words x = { a ^ b }, r;
+  int i;
+
+  for(i = 0; i < BAT_LANES / 4; i++)
+  {
+    (void)__usub8(x.w[i], 0x01010101);
+    r.w[i] = __sel(0x00000000, 0xFFFFFFFF);
+  }
+  return r.v;
+#else
+  return (BAT_Vec)(a == b);
+#endif
+}
+
+//*==============================================================================*/
+/*  BAT_Add                                                                      */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Add the lanes of two vectors, modulo 256
+ *
+ * \param     a, b --> vectors
+ *
+ * \return    sum of every lane
+ */
+/*===============================================================================*/
+static inline BAT_Vec BAT_Add(BAT_Vec a, BAT_Vec b)
+{
+#ifdef __ARM_FEATURE_SIMD32
+  BAT_Words x = { a }, y = { b };
+  int i;
+
+  for(i = 0; i < BAT_LANES / 4; i++)
+    x.w[i] = __uadd8(x.w[i], y.w[i]);
+  return x.v;
+#else
+  return a + b;
+#endif
+}
+
+//*==============================================================================*/
+/*  BAT_Any                                                                      */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Is any lane of a vector set?
+ *
+ * \param     a --> vector
+ *
+ * \return    true if a lane isn't 0
+ */
+/*===============================================================================*/
+static inline bool BAT_Any(BAT_Vec a)
+{
+  BAT_Words x = { a };
+  uint32_t nAny = 0;
+  int i;
+
+  for(i = 0; i < BAT_LANES / 4; i++)
+    nAny |= x.w[i];
+  return nAny != 0;
+}
+
+//*==============================================================================*/
+/*  BAT_Grow                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Grow the groups into one block position
+ *
+ * \details   A block joins the group of its lane if it has the color of the
+ * \n         move and a neighbor which is already in the group.
+ *
+ * \param     pBatch --> batch, col, h --> height in the column
+ *
+ * \return    lanes where the block joined
+ */
+/*===============================================================================*/
+static inline BAT_Vec BAT_Grow(BAT_Batch *pBatch, int col, int h)
+{
+  BAT_Vec *pMarks = pBatch->arrMarks;
+  const int nRows = pBatch->nRows;
+  const int i = col * nRows + h;
+  BAT_Vec vOld = pMarks[i], vGroup = vOld;
+
+  if(h > 0)
+    vGroup |= pMarks[i - 1];
+  if(h + 1 < nRows)
+    vGroup |= pMarks[i + 1];
+  if(col > 0)
+    vGroup |= pMarks[i - nRows];
+  if(col + 1 < pBatch->nUsedColumns)
+    vGroup |= pMarks[i + nRows];
+  //  The picked blocks have the color of the move, so no mark gets lost
+  pMarks[i] = vGroup & pBatch->arrSame[i];
+  return pMarks[i] & ~vOld;
+}
+
+//*==============================================================================*/
+/*  BAT_Init                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Initialize a batch
+ *
+ * \details   All lanes are empty boards of the given size, an empty lane
+ * \n         has no move and never plays. The batch must be aligned to
+ * \n         BAT_LANES bytes, static storage and the stack are.
+ *
+ * \param     pBatch --> batch, nColumns, nRows --> size of all boards
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void BAT_Init(BAT_Batch *pBatch, int nColumns, int nRows)
+{
+  memset(pBatch, 0, sizeof(BAT_Batch));
+  pBatch->nColumns = nColumns;
+  pBatch->nRows = nRows;
+}
+
+//*==============================================================================*/
+/*  BAT_Load                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Put a board into a lane
+ *
+ * \details   The blocks, the score and the state of the random generator
+ * \n         are taken over, the moves of the lane start from 0.
+ *
+ * \param     pBatch --> batch, nLane --> lane, pBoard --> board of the
+ * \n         size of the batch
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void BAT_Load(BAT_Batch *pBatch, int nLane, const SAGA_Board *pBoard)
+{
+  const int nRows = pBatch->nRows;
+  int col, h;
+
+  for(col = 0; col < pBatch->nColumns; col++)
+    for(h = 0; h < nRows; h++)
+      pBatch->arrCells[col * nRows + h][nLane] =
+        col < pBoard->nUsedColumns && h < pBoard->arrHeights[col] ? pBoard->arrCells[col * nRows + h] : 0;
+  if(pBoard->nUsedColumns > pBatch->nUsedColumns)
+    pBatch->nUsedColumns = pBoard->nUsedColumns;
+  memcpy(pBatch->arrRandom[nLane], pBoard->arrRandom, sizeof(pBoard->arrRandom));
+  pBatch->arrScores[nLane] = pBoard->nScore;
+  pBatch->arrRemaining[nLane] = pBoard->nRemaining;
+  pBatch->arrMoves[nLane] = 0;
+}
+
+//*==============================================================================*/
+/*  BAT_Store                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the board of a lane
+ *
+ * \details   The blocks, the score and the random generator of the lane are
+ * \n         written to the board and its derived state is refreshed, so
+ * \n         it could be played on with the engine.
+ *
+ * \param     pBatch --> batch, nLane --> lane, pBoard --> board initialized
+ * \n         with the size of the batch
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void BAT_Store(const BAT_Batch *pBatch, int nLane, SAGA_Board *pBoard)
+{
+  const int nRows = pBatch->nRows;
+  int col, h;
+
+  SAGA_BoardClear(pBoard);
+  for(col = 0; col < pBatch->nColumns; col++)
+  {
+    for(h = 0; h < nRows && pBatch->arrCells[col * nRows + h][nLane] != 0; h++)
+      pBoard->arrCells[col * nRows + h] = pBatch->arrCells[col * nRows + h][nLane];
+    pBoard->arrHeights[col] = h;
+    if(h > 0)
+      pBoard->nUsedColumns = col + 1;
+  }
+  memcpy(pBoard->arrRandom, pBatch->arrRandom[nLane], sizeof(pBoard->arrRandom));
+  pBoard->nScore = pBatch->arrScores[nLane];
+  pBoard->nRemaining = pBatch->arrRemaining[nLane];
+  SAGA_BoardRefresh(pBoard);
+}
+
+//*==============================================================================*/
+/*  BAT_Step                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Play one move in every lane
+ *
+ * \details   All blocks with a neighbor of the same color are marked and
+ * \n         counted, a lane with n of them takes the random number r of
+ * \n         SAGA_Random times n / 2^32 and picks its r-th marked block
+ * \n         in the order of the block array. The groups grow from the
+ * \n         picked blocks by forward and backward sweeps until nothing
+ * \n         changes, then they are removed, the blocks fall down column
+ * \n         by column and empty columns slide to the left. Counts are
+ * \n         kept modulo 256 in the lanes, a lane with a move has at least
+ * \n         two marked blocks, so 0 there means 256.
+ *
+ * \param     pBatch --> batch
+ *
+ * \return    number of lanes which moved, 0 if every lane is over
+ */
+/*===============================================================================*/
+int BAT_Step(BAT_Batch *pBatch)
+{
+  BAT_Vec *pCells = pBatch->arrCells;
+  BAT_Vec *pMarks = pBatch->arrMarks;
+  BAT_Vec *pColumn;
+  const int nRows = pBatch->nRows;
+  int nUsed = pBatch->nUsedColumns;
+  const int nCells = nUsed * nRows;
+  const BAT_Vec vZero = { 0 }, vOne = vZero | 1;
+  BAT_Vec vCount = vZero, vAny = vZero, vPick = vZero, vFound = vZero, vColor = vZero;
+  BAT_Vec vTap = vZero, vSolid, vPair, vChanged, vEmpty;
+  bool arrTouched[SAGA_MAXCOLUMNS] = { false };
+  SAGA_Cell *pTap;
+  int i, h, col, nLane, nCount, nMoved = 0;
+
+  //  Mark the blocks with a neighbor of the same color, each pair once
+  memset(pMarks, 0, nCells * sizeof(BAT_Vec));
+  for(col = 0; col < nUsed; col++)
+  {
+    for(h = 0; h < nRows; h++)
+    {
+      i = col * nRows + h;
+      vSolid = ~BAT_Eq(pCells[i], vZero);
+      if(h + 1 < nRows)
+      {
+        vPair = vSolid & BAT_Eq(pCells[i], pCells[i + 1]);
+        pMarks[i] |= vPair;
+        pMarks[i + 1] |= vPair;
+      }
+      if(col + 1 < nUsed)
+      {
+        vPair = vSolid & BAT_Eq(pCells[i], pCells[i + nRows]);
+        pMarks[i] |= vPair;
+        pMarks[i + nRows] |= vPair;
+      }
+      //  The blocks below and to the left are done, so the mark is final
+      vCount = BAT_Add(vCount, pMarks[i] & vOne);
+      vAny |= pMarks[i];
+    }
+  }
+
+  //  Draw the block of every lane which has one
+  for(nLane = 0; nLane < BAT_LANES; nLane++)
+  {
+    nCount = vCount[nLane] != 0 ? vCount[nLane] : vAny[nLane] != 0 ? 256 : 0;
+    if(nCount == 0)
+      continue;
+    vPick[nLane] = ((uint64_t)SAGA_Random(pBatch->arrRandom[nLane]) * nCount) >> 32;
+    nMoved++;
+  }
+  if(nMoved == 0)
+    return 0;
+
+  //  Count down to the picked block, it is the only mark left
+  for(i = 0; i < nCells; i++)
+  {
+    vPair = pMarks[i] & ~vFound;
+    pMarks[i] = vPair & BAT_Eq(vPick, vZero);
+    vFound |= pMarks[i];
+    vColor |= pCells[i] & pMarks[i];
+    vTap |= pMarks[i] & (unsigned char)i;
+    vPick = BAT_Add(vPick, vPair & ~pMarks[i]);
+  }
+
+  //  Grow the groups, a lane without a move has no mark to grow from
+  for(i = 0; i < nCells; i++)
+    pBatch->arrSame[i] = BAT_Eq(pCells[i], vColor);
+  do
+  {
+    vChanged = vZero;
+    for(col = 0; col < nUsed; col++)
+      for(h = 0; h < nRows; h++)
+        vChanged |= BAT_Grow(pBatch, col, h);
+    for(col = nUsed - 1; col >= 0; col--)
+      for(h = nRows - 1; h >= 0; h--)
+        vChanged |= BAT_Grow(pBatch, col, h);
+  }
+  while(BAT_Any(vChanged));
+
+  //  Remove the groups and count their blocks
+  vCount = vZero;
+  for(i = 0; i < nCells; i++)
+  {
+    if(!BAT_Any(pMarks[i]))
+      continue;
+    arrTouched[i / nRows] = true;
+    pCells[i] &= ~pMarks[i];
+    vCount = BAT_Add(vCount, pMarks[i] & vOne);
+  }
+
+  //  Let the blocks fall, every pass closes the lowest hole of a column
+  for(col = 0; col < nUsed; col++)
+  {
+    if(!arrTouched[col])
+      continue;
+    pColumn = &pCells[col * nRows];
+    do
+    {
+      vChanged = vZero;
+      for(h = 0; h + 1 < nRows; h++)
+      {
+        vEmpty = BAT_Eq(pColumn[h], vZero);
+        vPair = pColumn[h + 1] & vEmpty;
+        pColumn[h] |= vPair;
+        pColumn[h + 1] &= ~vEmpty;
+        vChanged |= vPair;
+      }
+    }
+    while(BAT_Any(vChanged));
+  }
+
+  //  Slide the columns to the left, every pass closes one empty column
+  do
+  {
+    vChanged = vZero;
+    for(col = 0; col + 1 < nUsed; col++)
+    {
+      vEmpty = BAT_Eq(pCells[col * nRows], vZero);
+      if(!BAT_Any(vEmpty & ~BAT_Eq(pCells[(col + 1) * nRows], vZero)))
+        continue;
+      for(h = 0; h < nRows; h++)
+      {
+        vPair = pCells[(col + 1) * nRows + h] & vEmpty;
+        pCells[col * nRows + h] |= vPair;
+        pCells[(col + 1) * nRows + h] &= ~vEmpty;
+        vChanged |= vPair;
+      }
+    }
+  }
+  while(BAT_Any(vChanged));
+  while(nUsed > 0 && !BAT_Any(pCells[(nUsed - 1) * nRows]))
+    nUsed--;
+  pBatch->nUsedColumns = nUsed;
+
+  //  Score the moves like SAGA_BoardDeleteBlocksEx
+  for(nLane = 0; nLane < BAT_LANES; nLane++)
+  {
+    if(vFound[nLane] == 0)
+      continue;
+    nCount = vCount[nLane] != 0 ? vCount[nLane] : 256;
+    pBatch->arrRemaining[nLane] -= nCount;
+    pBatch->arrScores[nLane] += SAGA_GetMoveScore(nCount);
+    if(pBatch->arrRemaining[nLane] == 0)
+      pBatch->arrScores[nLane] += SAGA_CLEARBONUS;
+    pTap = &pBatch->arrTaps[nLane][pBatch->arrMoves[nLane]++];
+    pTap->col = vTap[nLane] / nRows;
+    pTap->row = nRows - 1 - vTap[nLane] % nRows;
+  }
+  return nMoved;
+}
+
+//*==============================================================================*/
+/*  BAT_Playout                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Play every lane to the end
+ *
+ * \param     pBatch --> batch
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void BAT_Playout(BAT_Batch *pBatch)
+{
+  while(BAT_Step(pBatch) > 0)
+    ;
+}
+
+//*==============================================================================*/
+/*  BAT_IsRemovable                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Has a block a neighbor of the same color?
+ *
+ * \param     pBoard --> board context, col, h --> height in the column
+ *
+ * \return    true or false
+ */
+/*===============================================================================*/
+static inline bool BAT_IsRemovable(const SAGA_Board *pBoard, int col, int h)
+{
+  const int nRows = pBoard->nRows;
+  const unsigned char *pCell = &pBoard->arrCells[col * nRows + h];
+
+  return (h > 0 && pCell[-1] == *pCell) ||
+         (h + 1 < pBoard->arrHeights[col] && pCell[1] == *pCell) ||
+         (col > 0 && h < pBoard->arrHeights[col - 1] && pCell[-nRows] == *pCell) ||
+         (col + 1 < pBoard->nUsedColumns && h < pBoard->arrHeights[col + 1] && pCell[nRows] == *pCell);
+}
+
+//*==============================================================================*/
+/*  BAT_ScalarPlayout                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Play a board to the end with the scalar engine
+ *
+ * \details   The same moves as a lane of a batch: the removable blocks are
+ * \n         counted, the r-th one in the order of the block array is
+ * \n         tapped with SAGA_BoardDeleteBlocks, r is drawn from the
+ * \n         generator of the board. The reference for a batch.
+ *
+ * \param     pBoard --> board context, pTaps --> tapped blocks,
+ * \n         SAGA_MAXGROUPS entries
+ *
+ * \return    number of moves
+ */
+/*===============================================================================*/
+int BAT_ScalarPlayout(SAGA_Board *pBoard, SAGA_Cell *pTaps)
+{
+  int col, h, nCount, nPick, nMoves = 0;
+
+  while(pBoard->nPairs > 0)
+  {
+    nCount = 0;
+    for(col = 0; col < pBoard->nUsedColumns; col++)
+      for(h = 0; h < pBoard->arrHeights[col]; h++)
+        nCount += BAT_IsRemovable(pBoard, col, h);
+    nPick = ((uint64_t)SAGA_BoardRandom(pBoard) * nCount) >> 32;
+    //  Walk the blocks until the picked one is passed
+    for(col = 0, h = -1; nPick >= 0; nPick -= BAT_IsRemovable(pBoard, col, h))
+    {
+      if(++h == pBoard->arrHeights[col])
+      {
+        col++;
+        h = 0;
+      }
+    }
+    pTaps[nMoves].row = pBoard->nRows - 1 - h;
+    pTaps[nMoves++].col = col;
+    SAGA_BoardDeleteBlocks(pBoard, pBoard->nRows - 1 - h, col);
+  }
+  return nMoves;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,622 @@
+/*********************************************************************************/
+/*!
+ * \file      bitboard.c
+ *
+ * \brief     The Same Game v0.1 --> BITBOARD File
+ *
+ * \details   Alternative game engine backend which stores one bitmask per
+ * \n         color plus an occupancy mask. Groups are found with shift based
+ * \n         flood fills and the board is compacted with bit operations.
+ * \n         A search expands its positions about twice as fast with it on
+ * \n         10x7 boards, less on wide boards with long groups, see
+ * \n         tools/samebits. samebeam -b uses it.
+ * \n         Each column owns one byte of a 128 bit mask, bit 0 of the byte
+ * \n         is the bottom block. Bit 7 of every byte stays empty as guard,
+ * \n         so carries and shifts never leak into a neighboring column.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <string.h>
+#include "bitboard.h"
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// bit position of a block, rows are counted from the top like in samegame.c
+#define BITB_BIT(pBits, row, col)  ((col) * 8 + (pBits)->nRows - 1 - (row))
+
+/*-------------------------------------------------------------------------------*/
+/*  Global variables                                                             */
+/*-------------------------------------------------------------------------------*/
+// XOR of the Zobrist keys of all blocks of a column byte, see BITB_Init
+static uint64_t m_arrPlaceKeys[BITB_MAXCOLUMNS][128];
+
+//*==============================================================================*/
+/*  BITB_TestBit                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Test a single bit of a mask
+ *
+ * \param     pMask --> mask, nBit --> bit position 0 .. 127
+ *
+ * \return    true if the bit is set
+ */
+/*===============================================================================*/
+static inline bool BITB_TestBit(const BITB_Mask *pMask, int nBit)
+{
+  if(nBit < 64)
+    return (pMask->lo >> nBit) & 1;
+  return (pMask->hi >> (nBit - 64)) & 1;
+}
+
+//*==============================================================================*/
+/*  BITB_SetBit                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Set a single bit of a mask
+ *
+ * \param     pMask --> mask, nBit --> bit position 0 .. 127
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static inline void BITB_SetBit(BITB_Mask *pMask, int nBit)
+{
+  if(nBit < 64)
+    pMask->lo |= (uint64_t)1 << nBit;
+  else
+    pMask->hi |= (uint64_t)1 << (nBit - 64);
+}
+
+//*==============================================================================*/
+/*  BITB_FillUp                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Fill seeds upwards inside their column runs
+ *
+ * \details   Adding the seeds to the color mask lets the carry run through
+ * \n         all blocks above a seed, so a whole vertical run is filled in
+ * \n         one step. The empty guard bit stops the carry at the column end.
+ *
+ * \param     nSeed --> seed bits, nColor --> color bits
+ *
+ * \return    seeds and all same colored blocks above them
+ */
+/*===============================================================================*/
+static inline uint64_t BITB_FillUp(uint64_t nSeed, uint64_t nColor)
+{
+  return (((nColor + nSeed) ^ nColor) & nColor) | nSeed;
+}
+
+//*==============================================================================*/
+/*  BITB_Flood                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Shift based flood fill
+ *
+ * \details   Grow the seed inside the color mask until it doesn't change.
+ * \n         Each pass fills complete runs upwards and one step down, left
+ * \n         and right.
+ *
+ * \param     seed --> start blocks, pColor --> color mask
+ *
+ * \return    connected group
+ */
+/*===============================================================================*/
+static BITB_Mask BITB_Flood(BITB_Mask seed, const BITB_Mask *pColor)
+{
+  uint64_t lo = seed.lo, hi = seed.hi, nLo, nHi;
+
+  for(;;)
+  {
+    lo = BITB_FillUp(lo, pColor->lo);
+    hi = BITB_FillUp(hi, pColor->hi);
+    //  Down, left and right neighbors
+    nLo = lo | (lo >> 1) | (lo << 8) | (lo >> 8) | (hi << 56);
+    nHi = hi | (hi >> 1) | (hi << 8) | (hi >> 8) | (lo >> 56);
+    nLo &= pColor->lo;
+    nHi &= pColor->hi;
+    if(nLo == lo && nHi == hi)
+      break;
+    lo = nLo;
+    hi = nHi;
+  }
+
+  seed.lo = lo;
+  seed.hi = hi;
+  return seed;
+}
+
+//*==============================================================================*/
+/*  BITB_Squeeze                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Drop the blocks of one column byte
+ *
+ * \details   Remove the bits marked in nRemoved and move everything above
+ * \n         them down, like pext with the inverted removed mask.
+ *
+ * \param     nByte --> column bits, nRemoved --> removed bits
+ *
+ * \return    compacted column bits
+ */
+/*===============================================================================*/
+static inline unsigned BITB_Squeeze(unsigned nByte, unsigned nRemoved)
+{
+#ifdef __BMI2__
+  return _pext_u32(nByte, ~nRemoved & 0xFF);
+#else
+  unsigned nLow;
+  int nBit;
+
+  //  Top down, so the lower removed positions are not shifted yet
+  while(nRemoved)
+  {
+    nBit = 31 - __builtin_clz(nRemoved);
+    nRemoved &= ~(1u << nBit);
+    nLow = (1u << nBit) - 1;
+    nByte = (nByte & nLow) | ((nByte >> 1) & ~nLow);
+  }
+  return nByte;
+#endif
+}
+
+//*==============================================================================*/
+/*  BITB_SqueezeColumn                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Drop the blocks of one column in a mask
+ *
+ * \param     pMask --> mask, col --> column, nRemoved --> removed bits
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static inline void BITB_SqueezeColumn(BITB_Mask *pMask, int col, unsigned nRemoved)
+{
+  uint64_t *pWord = col < 8 ? &pMask->lo : &pMask->hi;
+  int nShift = (col & 7) * 8;
+  unsigned nByte = (*pWord >> nShift) & 0xFF;
+
+  if(nByte == 0)
+    return;
+  nByte = BITB_Squeeze(nByte, nRemoved);
+  *pWord = (*pWord & ~((uint64_t)0xFF << nShift)) | ((uint64_t)nByte << nShift);
+}
+
+//*==============================================================================*/
+/*  BITB_RemoveColumn                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Remove one column of a mask
+ *
+ * \details   Shift all columns right of col one byte to the left.
+ *
+ * \param     pMask --> mask, col --> column
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static inline void BITB_RemoveColumn(BITB_Mask *pMask, int col)
+{
+  uint64_t nKeep;
+
+  if(col < 8)
+  {
+    nKeep = col ? ((uint64_t)1 << (col * 8)) - 1 : 0;
+    pMask->lo = (pMask->lo & nKeep) | ((pMask->lo >> 8) & ~nKeep) | (pMask->hi << 56);
+    pMask->hi >>= 8;
+  }
+  else
+  {
+    nKeep = col > 8 ? ((uint64_t)1 << ((col - 8) * 8)) - 1 : 0;
+    pMask->hi = (pMask->hi & nKeep) | ((pMask->hi >> 8) & ~nKeep);
+  }
+}
+
+//*==============================================================================*/
+/*  BITB_Pairs                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Blocks with a same colored neighbor
+ *
+ * \details   Only these blocks belong to a deletable group, all other blocks
+ * \n         of the color are singles.
+ *
+ * \param     pColor --> color mask
+ *
+ * \return    blocks of the color touching another block of the color
+ */
+/*===============================================================================*/
+static inline BITB_Mask BITB_Pairs(const BITB_Mask *pColor)
+{
+  BITB_Mask pairs;
+  uint64_t lo = pColor->lo, hi = pColor->hi;
+
+  pairs.lo = lo & ((lo << 1) | (lo >> 1) | (lo << 8) | (lo >> 8) | (hi << 56));
+  pairs.hi = hi & ((hi << 1) | (hi >> 1) | (hi << 8) | (hi >> 8) | (lo >> 56));
+  return pairs;
+}
+
+//*==============================================================================*/
+/*  BITB_Init                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Set up the key tables of the canonical hash
+ *
+ * \details   For every column and every byte of blocks the XOR of their
+ * \n         Zobrist keys, so the hash of a color takes one lookup per
+ * \n         column. Call it once before BITB_GetCanonicalHash is used,
+ * \n         before any threads are started.
+ *
+ * \param     none
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void BITB_Init(void)
+{
+  int col, nByte;
+
+  for(col = 0; col < BITB_MAXCOLUMNS; col++)
+  {
+    m_arrPlaceKeys[col][0] = 0;
+    for(nByte = 1; nByte < 128; nByte++)
+      m_arrPlaceKeys[col][nByte] = m_arrPlaceKeys[col][nByte & (nByte - 1)] ^
+                                   SAGA_GetPlaceKey(col, __builtin_ctz(nByte));
+  }
+}
+
+//*==============================================================================*/
+/*  BITB_FromBoard                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Convert a board into a bitboard
+ *
+ * \details   Only boards up to BITB_MAXCOLUMNS x BITB_MAXROWS fit into the
+ * \n         128 bit masks. The blocks are read column by column from the
+ * \n         packed cells, block h of a column is bit h of its byte.
+ *
+ * \param     pBits --> bitboard, pBoard --> source board
+ *
+ * \return    false if the board is too large
+ */
+/*===============================================================================*/
+bool BITB_FromBoard(BITB_Board *pBits, const SAGA_Board *pBoard)
+{
+  const unsigned char *pColumn;
+  int col, h;
+
+  if(pBoard->nColumns > BITB_MAXCOLUMNS || pBoard->nRows > BITB_MAXROWS)
+    return false;
+
+  memset(pBits, 0, sizeof(BITB_Board));
+  pBits->nColumns = pBoard->nColumns;
+  pBits->nRows = pBoard->nRows;
+  pBits->nColors = pBoard->nColors;
+  pBits->nRemaining = pBoard->nRemaining;
+
+  for(col = 0; col < pBoard->nUsedColumns; col++)
+  {
+    pColumn = &pBoard->arrCells[col * pBoard->nRows];
+    for(h = 0; h < pBoard->arrHeights[col]; h++)
+    {
+      BITB_SetBit(&pBits->occupied, col * 8 + h);
+      BITB_SetBit(&pBits->arrColors[pColumn[h] - 1], col * 8 + h);
+    }
+  }
+  return true;
+}
+
+//*==============================================================================*/
+/*  BITB_ToBoard                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Convert a bitboard back into a board
+ *
+ * \param     pBits --> bitboard, pBoard --> destination board
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void BITB_ToBoard(const BITB_Board *pBits, SAGA_Board *pBoard)
+{
+  int row, col, nHeight;
+
+  SAGA_BoardInit(pBoard, pBits->nColumns, pBits->nRows, pBits->nColors);
+  for(col = 0; col < pBits->nColumns; col++)
+  {
+    //  Columns are contiguous from the bottom, so the height is the last row
+    for(nHeight = 0, row = pBits->nRows - 1; row >= 0; row--, nHeight++)
+    {
+      pBoard->arrCells[col * pBoard->nRows + nHeight] = BITB_GetBlock(pBits, row, col);
+      if(pBoard->arrCells[col * pBoard->nRows + nHeight] == 0)
+        break;
+    }
+    pBoard->arrHeights[col] = nHeight;
+    if(nHeight > 0)
+      pBoard->nUsedColumns = col + 1;
+  }
+  pBoard->nRemaining = pBits->nRemaining;
+  SAGA_BoardRefresh(pBoard);
+}
+
+//*==============================================================================*/
+/*  BITB_Equals                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compare a bitboard with a board
+ *
+ * \details   Used to cross check both engines on the same move sequence.
+ *
+ * \param     pBits --> bitboard, pBoard --> board
+ *
+ * \return    true if all blocks and the remaining count are the same
+ */
+/*===============================================================================*/
+bool BITB_Equals(const BITB_Board *pBits, const SAGA_Board *pBoard)
+{
+  int row, col;
+
+  if(pBits->nRemaining != pBoard->nRemaining)
+    return false;
+  for(row = 0; row < pBits->nRows; row++)
+    for(col = 0; col < pBits->nColumns; col++)
+      if(BITB_GetBlock(pBits, row, col) != SAGA_BoardGetBlock(pBoard, row, col))
+        return false;
+  return true;
+}
+
+//*==============================================================================*/
+/*  BITB_GetCanonicalHash                                                        */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the hash of a bitboard that ignores the color names
+ *
+ * \details   The same hash as SAGA_BoardGetCanonicalHash of the same board,
+ * \n         so both engines could be mixed in one search. Needs BITB_Init.
+ *
+ * \param     pBits --> bitboard
+ *
+ * \return    64 bit hash, 0 for an empty board
+ */
+/*===============================================================================*/
+uint64_t BITB_GetCanonicalHash(const BITB_Board *pBits)
+{
+  uint64_t arrHashes[SAGA_MAXCOLORS + 1] = { 0 };
+  uint64_t nWord;
+  int nColor, col;
+
+  for(nColor = 1; nColor <= pBits->nColors; nColor++)
+  {
+    //  The loops end after the last column with blocks of the color
+    for(col = 0, nWord = pBits->arrColors[nColor - 1].lo; nWord != 0; col++, nWord >>= 8)
+      arrHashes[nColor] ^= m_arrPlaceKeys[col][nWord & 0x7F];
+    for(col = 8, nWord = pBits->arrColors[nColor - 1].hi; nWord != 0; col++, nWord >>= 8)
+      arrHashes[nColor] ^= m_arrPlaceKeys[col][nWord & 0x7F];
+  }
+  return SAGA_GetCanonicalHash(arrHashes, pBits->nColors);
+}
+
+//*==============================================================================*/
+/*  BITB_GetBlock                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the color index of specific block
+ *
+ * \param     pBits --> bitboard, row, column
+ *
+ * \return    color index, 0 is background
+ */
+/*===============================================================================*/
+int BITB_GetBlock(const BITB_Board *pBits, int row, int col)
+{
+  int nBit, nColor;
+
+  if(row < 0 || row >= pBits->nRows || col < 0 || col >= pBits->nColumns)
+    return 0;
+  nBit = BITB_BIT(pBits, row, col);
+  if(!BITB_TestBit(&pBits->occupied, nBit))
+    return 0;
+  for(nColor = 0; nColor < pBits->nColors; nColor++)
+    if(BITB_TestBit(&pBits->arrColors[nColor], nBit))
+      return nColor + 1;
+  return 0;
+}
+
+//*==============================================================================*/
+/*  BITB_IsGameOver                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Is the game over?
+ *
+ * \details   A color still has a move if any block touches a block of the
+ * \n         same color above or to the right.
+ *
+ * \param     pBits --> bitboard
+ *
+ * \return    true or false
+ */
+/*===============================================================================*/
+bool BITB_IsGameOver(const BITB_Board *pBits)
+{
+  const BITB_Mask *pColor;
+  int nColor;
+
+  for(nColor = 0; nColor < pBits->nColors; nColor++)
+  {
+    pColor = &pBits->arrColors[nColor];
+    if((pColor->lo & ((pColor->lo << 1) | (pColor->lo << 8))) ||
+       (pColor->hi & ((pColor->hi << 1) | (pColor->hi << 8) | (pColor->lo >> 56))))
+      return false;
+  }
+  return true;
+}
+
+//*==============================================================================*/
+/*  BITB_GetGroup                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the group of a block
+ *
+ * \param     pBits --> bitboard, row, column
+ *
+ * \return    all connected blocks with the same color, empty for background
+ */
+/*===============================================================================*/
+BITB_Mask BITB_GetGroup(const BITB_Board *pBits, int row, int col)
+{
+  BITB_Mask seed = { 0, 0 };
+  int nColor = BITB_GetBlock(pBits, row, col);
+
+  if(nColor == 0)
+    return seed;
+  BITB_SetBit(&seed, BITB_BIT(pBits, row, col));
+  return BITB_Flood(seed, &pBits->arrColors[nColor - 1]);
+}
+
+//*==============================================================================*/
+/*  BITB_DeleteBlocks                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Delete blocks if possible
+ *
+ * \details   Same semantics as SAGA_BoardDeleteBlocks.
+ *
+ * \param     pBits --> bitboard, row, column
+ *
+ * \return    number of deleted pieces or -1
+ */
+/*===============================================================================*/
+int BITB_DeleteBlocks(BITB_Board *pBits, int row, int col)
+{
+  BITB_Move move;
+  int nSize;
+
+  if(row < 0 || row >= pBits->nRows || col < 0 || col >= pBits->nColumns)
+    return -1;
+  move.color = BITB_GetBlock(pBits, row, col);
+  if(move.color == 0)
+    return -1;
+
+  move.group = BITB_GetGroup(pBits, row, col);
+  nSize = __builtin_popcountll(move.group.lo) + __builtin_popcountll(move.group.hi);
+  if(nSize < 2)
+    return -1;
+  move.size = nSize;
+  BITB_ApplyMove(pBits, &move);
+  return nSize;
+}
+
+//*==============================================================================*/
+/*  BITB_ApplyMove                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Remove a group and compact the bitboard
+ *
+ * \details   Every touched column is compacted with a squeeze of its byte,
+ * \n         columns which got empty are removed with one 128 bit shift.
+ *
+ * \param     pBits --> bitboard, pMove --> group from BITB_GenerateMoves
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void BITB_ApplyMove(BITB_Board *pBits, const BITB_Move *pMove)
+{
+  const BITB_Mask *pGroup = &pMove->group;
+  unsigned nRemoved, nHeight;
+  int col, nColor;
+
+  //  Remove the group
+  pBits->occupied.lo &= ~pGroup->lo;
+  pBits->occupied.hi &= ~pGroup->hi;
+  pBits->arrColors[pMove->color - 1].lo &= ~pGroup->lo;
+  pBits->arrColors[pMove->color - 1].hi &= ~pGroup->hi;
+  pBits->nRemaining -= pMove->size;
+
+  //  Let the blocks of each touched column fall down, right to left so
+  //  removing an empty column doesn't move a column we still have to do
+  for(col = pBits->nColumns - 1; col >= 0; col--)
+  {
+    nRemoved = ((col < 8 ? pGroup->lo : pGroup->hi) >> ((col & 7) * 8)) & 0xFF;
+    if(nRemoved == 0)
+      continue;
+
+    for(nColor = 0; nColor < pBits->nColors; nColor++)
+      BITB_SqueezeColumn(&pBits->arrColors[nColor], col, nRemoved);
+    BITB_SqueezeColumn(&pBits->occupied, col, nRemoved);
+
+    //  Column got empty, move everything right of it to the left
+    nHeight = ((col < 8 ? pBits->occupied.lo : pBits->occupied.hi) >> ((col & 7) * 8)) & 0xFF;
+    if(nHeight == 0)
+    {
+      for(nColor = 0; nColor < pBits->nColors; nColor++)
+        BITB_RemoveColumn(&pBits->arrColors[nColor], col);
+      BITB_RemoveColumn(&pBits->occupied, col);
+    }
+  }
+}
+
+//*==============================================================================*/
+/*  BITB_GenerateMoves                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Find all deletable groups
+ *
+ * \details   Flood fill from the lowest unvisited block with a same colored
+ * \n         neighbor until every such block belongs to a group. Single
+ * \n         blocks are never visited. The moves are sorted by color.
+ *
+ * \param     pBits --> bitboard, pMoves --> output, nMaxMoves --> size of pMoves
+ *
+ * \return    number of moves written
+ */
+/*===============================================================================*/
+int BITB_GenerateMoves(const BITB_Board *pBits, BITB_Move *pMoves, int nMaxMoves)
+{
+  BITB_Mask rest, seed;
+  BITB_Move *pMove;
+  int nMoves = 0, nBit, nColor;
+
+  for(nColor = 0; nColor < pBits->nColors; nColor++)
+  {
+    //  Single blocks are skipped, every flood fill yields a move
+    rest = BITB_Pairs(&pBits->arrColors[nColor]);
+    while((rest.lo || rest.hi) && nMoves < nMaxMoves)
+    {
+      //  Lowest block not yet part of a group
+      seed.lo = rest.lo & (0 - rest.lo);
+      seed.hi = seed.lo ? 0 : rest.hi & (0 - rest.hi);
+      nBit = seed.lo ? __builtin_ctzll(seed.lo) : 64 + __builtin_ctzll(seed.hi);
+
+      pMove = &pMoves[nMoves++];
+      pMove->group = BITB_Flood(seed, &pBits->arrColors[nColor]);
+      rest.lo &= ~pMove->group.lo;
+      rest.hi &= ~pMove->group.hi;
+
+      pMove->row = pBits->nRows - 1 - (nBit & 7);
+      pMove->col = nBit >> 3;
+      pMove->color = nColor + 1;
+      pMove->size = __builtin_popcountll(pMove->group.lo) + __builtin_popcountll(pMove->group.hi);
+    }
+  }
+  return nMoves;
+}
+
+//------------------------------------ END ---------------------------------------
@@ -0,0 +1,460 @@
+/*********************************************************************************/
+/*!
+ * \file      codec.c
+ *
+ * \brief     The Same Game v0.1 --> BOARD CODEC File
+ *
+ * \details   Compact binary form of a board. Both forms start with one byte
+ * \n         each for the columns, rows and colors, followed by a stream of
+ * \n         bits which is filled from the least significant bit of each
+ * \n         byte on.
+ * \n         The full form stores all cells column by column from the
+ * \n         bottom, like arrCells of the board, with the bits needed for
+ * \n         the colors and the empty cell, e.g. 2 bits for 3 colors, so the
+ * \n         10x7 board takes 140 bits. Its size only depends on the board
+ * \n         size and the colors, it suits fixed size records.
+ * \n         The short form stores the height of every used column followed
+ * \n         by its blocks and a height of 0 after the last used column, if
+ * \n         there is an unused one. There are no empty cells inside the
+ * \n         columns, so a block needs one value less. The short form is
+ * \n         canonical, equal positions always give equal bytes, e.g. for
+ * \n         hashing or as a key of a solver cache.
+ * \n         A saved game is a small file header with the score and the game
+ * \n         number followed by the short form of the board.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "codec.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// bits of a cell in the full form, of a block and of a height in the short form
+#define CDC_CELLBITS(nColors)    (32 - __builtin_clz(nColors))
+#define CDC_BLOCKBITS(nColors)   ((nColors) > 1 ? 32 - __builtin_clz((nColors) - 1) : 0)
+#define CDC_HEIGHTBITS(nRows)    (32 - __builtin_clz(nRows))
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // bit stream writer, the space is checked before
+  uint8_t *pData;                      // next byte to write
+  uint64_t nBits;                      // bits not written yet
+  int nCount;                          // number of bits not written yet
+}CDC_Writer;
+
+typedef struct {  // bit stream reader
+  const uint8_t *pData;                // data after the header
+  int nSize;                           // number of bytes after the header
+  int nPos;                            // next byte to read
+  uint64_t nBits;                      // bits read but not used yet
+  int nCount;                          // number of bits read but not used yet
+  bool bError;                         // set when reading past the end
+}CDC_Reader;
+
+//*==============================================================================*/
+/*  CDC_Put                                                                      */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Write bits
+ *
+ * \param     pWriter --> writer, nValue --> value, nBits --> bits of the value
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static inline void CDC_Put(CDC_Writer *pWriter, unsigned int nValue, int nBits)
+{
+  pWriter->nBits |= (uint64_t)nValue << pWriter->nCount;
+  pWriter->nCount += nBits;
+  if(pWriter->nCount >= 32)
+  {
+    pWriter->pData[0] = (uint8_t)pWriter->nBits;
+    pWriter->pData[1] = (uint8_t)(pWriter->nBits >> 8);
+    pWriter->pData[2] = (uint8_t)(pWriter->nBits >> 16);
+    pWriter->pData[3] = (uint8_t)(pWriter->nBits >> 24);
+    pWriter->pData += 4;
+    pWriter->nBits >>= 32;
+    pWriter->nCount -= 32;
+  }
+}
+
+//*==============================================================================*/
+/*  CDC_Flush                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Write the remaining bits
+ *
+ * \details   The unused bits of the last byte are 0.
+ *
+ * \param     pWriter --> writer
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void CDC_Flush(CDC_Writer *pWriter)
+{
+  for(; pWriter->nCount > 0; pWriter->nCount -= 8)
+  {
+    *pWriter->pData++ = (uint8_t)pWriter->nBits;
+    pWriter->nBits >>= 8;
+  }
+}
+
+//*==============================================================================*/
+/*  CDC_Get                                                                      */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Read bits
+ *
+ * \details   Reading past the end gives 0 and sets the error flag.
+ *
+ * \param     pReader --> reader, nBits --> bits of the value
+ *
+ * \return    value
+ */
+/*===============================================================================*/
+static inline unsigned int CDC_Get(CDC_Reader *pReader, int nBits)
+{
+  unsigned int nValue;
+
+  while(pReader->nCount < nBits)
+  {
+    if(pReader->nPos >= pReader->nSize)
+    {
+      pReader->bError = true;
+      return 0;
+    }
+    pReader->nBits |= (uint64_t)pReader->pData[pReader->nPos++] << pReader->nCount;
+    pReader->nCount += 8;
+  }
+  nValue = (unsigned int)pReader->nBits & ((1u << nBits) - 1);
+  pReader->nBits >>= nBits;
+  pReader->nCount -= nBits;
+  return nValue;
+}
+
+//*==============================================================================*/
+/*  CDC_ReadHeader                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Start decoding a board
+ *
+ * \details   Check the board size and the colors and initialize the board
+ * \n         and the reader for the bits after the header.
+ *
+ * \param     pBoard --> board context, pReader --> reader,
+ * \n         pData --> encoded board, nSize --> bytes available
+ *
+ * \return    true if the header is valid
+ */
+/*===============================================================================*/
+static bool CDC_ReadHeader(SAGA_Board *pBoard, CDC_Reader *pReader, const uint8_t *pData,
+                           int nSize)
+{
+  int nColumns, nRows, nColors;
+
+  if(nSize < CDC_HEADER)
+    return false;
+  nColumns = pData[0];
+  nRows = pData[1];
+  nColors = pData[2];
+  if(!SAGA_BoardIsValidSize(nColumns, nRows, nColors))
+    return false;
+
+  SAGA_BoardInit(pBoard, nColumns, nRows, nColors);
+  memset(pReader, 0, sizeof(CDC_Reader));
+  pReader->pData = pData + CDC_HEADER;
+  pReader->nSize = nSize - CDC_HEADER;
+  return true;
+}
+
+//*==============================================================================*/
+/*  CDC_PackedSize                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Size of the full form
+ *
+ * \details   The full form of all boards with the same size and colors has
+ * \n         the same size. The short form is never bigger than this plus
+ * \n         the heights, CDC_MAXBYTES is enough for any board.
+ *
+ * \param     nColumns, nRows, nColors
+ *
+ * \return    number of bytes
+ */
+/*===============================================================================*/
+int CDC_PackedSize(int nColumns, int nRows, int nColors)
+{
+  return CDC_HEADER + (nColumns * nRows * CDC_CELLBITS(nColors) + 7) / 8;
+}
+
+//*==============================================================================*/
+/*  CDC_Pack                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Encode a board in the full form
+ *
+ * \details   The cells are already stored column by column from the bottom,
+ * \n         so they are packed in one run.
+ *
+ * \param     pBoard --> board context, pData --> buffer, nSize --> its size
+ *
+ * \return    number of bytes written, -1 if the buffer is too small
+ */
+/*===============================================================================*/
+int CDC_Pack(const SAGA_Board *pBoard, uint8_t *pData, int nSize)
+{
+  CDC_Writer Writer = { pData + CDC_HEADER, 0, 0 };
+  int nBits = CDC_CELLBITS(pBoard->nColors);
+  int nCells = pBoard->nColumns * pBoard->nRows;
+  int nPacked = CDC_PackedSize(pBoard->nColumns, pBoard->nRows, pBoard->nColors);
+  int i;
+
+  if(nSize < nPacked)
+    return -1;
+  pData[0] = pBoard->nColumns;
+  pData[1] = pBoard->nRows;
+  pData[2] = pBoard->nColors;
+  for(i = 0; i < nCells; i++)
+    CDC_Put(&Writer, pBoard->arrCells[i], nBits);
+  CDC_Flush(&Writer);
+  return nPacked;
+}
+
+//*==============================================================================*/
+/*  CDC_Unpack                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Decode a board in the full form
+ *
+ * \details   The board gets the size and the colors of the encoded one.
+ * \n         A color out of range, an empty cell below a block or an empty
+ * \n         column left of a used one are rejected.
+ *
+ * \param     pBoard --> board context, pData --> encoded board,
+ * \n         nSize --> bytes available
+ *
+ * \return    number of bytes read, -1 if the data is invalid
+ */
+/*===============================================================================*/
+int CDC_Unpack(SAGA_Board *pBoard, const uint8_t *pData, int nSize)
+{
+  CDC_Reader Reader;
+  unsigned char *pColumn;
+  int i, col, h, nBits, nCells;
+
+  if(!CDC_ReadHeader(pBoard, &Reader, pData, nSize))
+    return -1;
+  nBits = CDC_CELLBITS(pBoard->nColors);
+  nCells = pBoard->nColumns * pBoard->nRows;
+  for(i = 0; i < nCells; i++)
+  {
+    pBoard->arrCells[i] = CDC_Get(&Reader, nBits);
+    if(pBoard->arrCells[i] > pBoard->nColors)
+      return -1;
+  }
+  if(Reader.bError)
+    return -1;
+
+  //  The blocks of a column start at the bottom, the used columns at the left
+  for(col = 0; col < pBoard->nColumns; col++)
+  {
+    pColumn = &pBoard->arrCells[col * pBoard->nRows];
+    for(h = 0; h < pBoard->nRows && pColumn[h] != 0; h++)
+      ;
+    pBoard->arrHeights[col] = h;
+    pBoard->nRemaining += h;
+    for(; h < pBoard->nRows; h++)
+      if(pColumn[h] != 0)
+        return -1;
+    if(pBoard->arrHeights[col] > 0 && pBoard->nUsedColumns++ != col)
+      return -1;
+  }
+  SAGA_BoardRefresh(pBoard);
+  return CDC_HEADER + Reader.nPos;
+}
+
+//*==============================================================================*/
+/*  CDC_PackShort                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Encode a board in the short form
+ *
+ * \details   Only the heights and the blocks of the used columns are written,
+ * \n         the size is known from the heights before anything is written.
+ *
+ * \param     pBoard --> board context, pData --> buffer, nSize --> its size
+ *
+ * \return    number of bytes written, -1 if the buffer is too small
+ */
+/*===============================================================================*/
+int CDC_PackShort(const SAGA_Board *pBoard, uint8_t *pData, int nSize)
+{
+  CDC_Writer Writer = { pData + CDC_HEADER, 0, 0 };
+  const unsigned char *pColumn;
+  int nBits = CDC_BLOCKBITS(pBoard->nColors);
+  int nHeightBits = CDC_HEIGHTBITS(pBoard->nRows);
+  int nHeights = pBoard->nUsedColumns + (pBoard->nUsedColumns < pBoard->nColumns);
+  int nPacked = CDC_HEADER + (pBoard->nRemaining * nBits + nHeights * nHeightBits + 7) / 8;
+  int col, h;
+
+  if(nSize < nPacked)
+    return -1;
+  pData[0] = pBoard->nColumns;
+  pData[1] = pBoard->nRows;
+  pData[2] = pBoard->nColors;
+  for(col = 0; col < pBoard->nUsedColumns; col++)
+  {
+    pColumn = &pBoard->arrCells[col * pBoard->nRows];
+    CDC_Put(&Writer, pBoard->arrHeights[col], nHeightBits);
+    for(h = 0; h < pBoard->arrHeights[col]; h++)
+      CDC_Put(&Writer, pColumn[h] - 1, nBits);
+  }
+  if(col < pBoard->nColumns)
+    CDC_Put(&Writer, 0, nHeightBits);
+  CDC_Flush(&Writer);
+  return nPacked;
+}
+
+//*==============================================================================*/
+/*  CDC_UnpackShort                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Decode a board in the short form
+ *
+ * \details   The board gets the size and the colors of the encoded one.
+ * \n         Short forms could follow each other in one buffer, the return
+ * \n         value is where the next one starts.
+ *
+ * \param     pBoard --> board context, pData --> encoded board,
+ * \n         nSize --> bytes available
+ *
+ * \return    number of bytes read, -1 if the data is invalid
+ */
+/*===============================================================================*/
+int CDC_UnpackShort(SAGA_Board *pBoard, const uint8_t *pData, int nSize)
+{
+  CDC_Reader Reader;
+  unsigned char *pColumn;
+  int col, h, nHeight, nBits, nHeightBits;
+
+  if(!CDC_ReadHeader(pBoard, &Reader, pData, nSize))
+    return -1;
+  nBits = CDC_BLOCKBITS(pBoard->nColors);
+  nHeightBits = CDC_HEIGHTBITS(pBoard->nRows);
+  for(col = 0; col < pBoard->nColumns; col++)
+  {
+    nHeight = CDC_Get(&Reader, nHeightBits);
+    if(nHeight == 0)
+      break;
+    if(nHeight > pBoard->nRows)
+      return -1;
+    pColumn = &pBoard->arrCells[col * pBoard->nRows];
+    for(h = 0; h < nHeight; h++)
+    {
+      pColumn[h] = CDC_Get(&Reader, nBits) + 1;
+      if(pColumn[h] > pBoard->nColors)
+        return -1;
+    }
+    pBoard->arrHeights[col] = nHeight;
+    pBoard->nRemaining += nHeight;
+  }
+  if(Reader.bError)
+    return -1;
+  pBoard->nUsedColumns = col;
+  SAGA_BoardRefresh(pBoard);
+  return CDC_HEADER + Reader.nPos;
+}
+
+//*==============================================================================*/
+/*  CDC_SaveGame                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Write a saved game
+ *
+ * \details   The board is stored in the short form together with its score
+ * \n         and game number, the moves which led to it are not stored.
+ *
+ * \param     pBoard --> board context, pPath --> file name
+ *
+ * \return    false if the file couldn't be written
+ */
+/*===============================================================================*/
+bool CDC_SaveGame(const SAGA_Board *pBoard, const char *pPath)
+{
+  uint8_t arrData[CDC_MAXBYTES];
+  CDC_File Header;
+  FILE *pFile;
+  int nSize;
+  bool bOk;
+
+  memset(&Header, 0, sizeof(Header));
+  memcpy(Header.arrMagic, CDC_MAGIC, sizeof(Header.arrMagic));
+  Header.nVersion = CDC_VERSION;
+  Header.nScore = pBoard->nScore;
+  Header.nGame = pBoard->nGame;
+  nSize = CDC_PackShort(pBoard, arrData, sizeof(arrData));
+
+  pFile = fopen(pPath, "wb");
+  if(pFile == NULL)
+    return false;
+  bOk = fwrite(&Header, sizeof(Header), 1, pFile) == 1 &&
+        fwrite(arrData, 1, nSize, pFile) == (size_t)nSize;
+  return fclose(pFile) == 0 && bOk;
+}
+
+//*==============================================================================*/
+/*  CDC_LoadGame                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Read a saved game
+ *
+ * \details   The board gets the size, the colors, the blocks, the score and
+ * \n         the game number of the saved one.
+ *
+ * \param     pBoard --> board context, pPath --> file name
+ *
+ * \return    false if the file is missing or invalid
+ */
+/*===============================================================================*/
+bool CDC_LoadGame(SAGA_Board *pBoard, const char *pPath)
+{
+  uint8_t arrData[CDC_MAXBYTES];
+  CDC_File Header;
+  FILE *pFile;
+  int nSize;
+  bool bOk;
+
+  pFile = fopen(pPath, "rb");
+  if(pFile == NULL)
+    return false;
+  bOk = fread(&Header, sizeof(Header), 1, pFile) == 1 &&
+        memcmp(Header.arrMagic, CDC_MAGIC, sizeof(Header.arrMagic)) == 0 &&
+        Header.nVersion == CDC_VERSION;
+  nSize = bOk ? fread(arrData, 1, sizeof(arrData), pFile) : 0;
+  fclose(pFile);
+
+  //  The board must use the whole rest of the file
+  if(!bOk || CDC_UnpackShort(pBoard, arrData, nSize) != nSize)
+    return false;
+  pBoard->nScore = Header.nScore;
+  pBoard->nGame = Header.nGame;
+  return true;
+}
+
+//----------------------------------- END --------------------------------------
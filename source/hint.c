@@ -0,0 +1,321 @@
+/*********************************************************************************/
+/*!
+ * \file      hint.c
+ *
+ * \brief     The Same Game v0.1 --> HINT File
+ *
+ * \details   Anytime search for the best group of a position, done in time
+ * \n         slices. The moves of the position are taken in turns, each
+ * \n         turn plays one game which starts with the move: the first
+ * \n         round always removes the largest group, later rounds play
+ * \n         random moves. The best game of all is kept and its first move
+ * \n         is the hint. A game which reaches the tablebase gets the exact
+ * \n         value of the rest, the moves are only played along the table
+ * \n         when the game is the best so far.
+ * \n         The random stream only depends on the seed and the position,
+ * \n         so the games played don't depend on how the time is sliced and
+ * \n         more time never gives a worse hint.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+#include "hint.h"
+#include "analysis.h"
+#ifdef _3DS
+#include <3ds.h>
+#endif
+
+//*==============================================================================*/
+/*  HINT_Micros                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \details   The system tick of the ARM11 on the 3DS, the monotonic clock
+ * \n         on a host.
+ *
+ * \param     none
+ *
+ * \return    microseconds
+ */
+/*===============================================================================*/
+static uint64_t HINT_Micros(void)
+{
+#ifdef _3DS
+  return svcGetSystemTick() / (SYSCLOCK_ARM11 / 1000000);
+#else
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return (uint64_t)Time.tv_sec * 1000000 + Time.tv_nsec / 1000;
+#endif
+}
+
+//*==============================================================================*/
+/*  HINT_Random                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Random number below a limit
+ *
+ * \details   Splitmix64 stream of the search, the boards keep their own
+ * \n         state untouched.
+ *
+ * \param     pHint --> search state, nLimit --> number of choices
+ *
+ * \return    0 .. nLimit - 1
+ */
+/*===============================================================================*/
+static inline int HINT_Random(HINT_Search *pHint, int nLimit)
+{
+  uint64_t z = (pHint->nRandom += 0x9E3779B97F4A7C15ull);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  z ^= z >> 31;
+  return (int)(((z >> 32) * (uint64_t)nLimit) >> 32);
+}
+
+//*==============================================================================*/
+/*  HINT_Playout                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Play one game from the position
+ *
+ * \details   The game starts with the move of the turn and is kept if it
+ * \n         beats the best game so far.
+ *
+ * \param     pHint --> search state
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void HINT_Playout(HINT_Search *pHint)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Cell arrMoves[SAGA_MAXGROUPS];
+  SAGA_Board Board;
+  int i, j, nGroups, nValue = -1, nCount = 1;
+  bool bGreedy = pHint->nPlayouts < (uint32_t)pHint->nGroups;
+  const TBL_Table *pBase = pHint->pBase;
+
+  SAGA_BoardCopy(&Board, &pHint->Board);
+  arrMoves[0].row = pHint->arrGroups[pHint->nNext].row;
+  arrMoves[0].col = pHint->arrGroups[pHint->nNext].col;
+  SAGA_BoardDeleteBlocks(&Board, arrMoves[0].row, arrMoves[0].col);
+  pHint->nPlayouts++;
+  if(++pHint->nNext == pHint->nGroups)
+    pHint->nNext = 0;
+
+  while(pBase == NULL || (nValue = TBL_Probe(pBase, &Board)) < 0)
+  {
+    nGroups = SAGA_BoardEnumerateMoves(&Board, arrGroups, SAGA_MAXGROUPS, NULL);
+    if(nGroups == 0)
+      break;
+    if(bGreedy)
+    {
+      for(i = 0, j = 1; j < nGroups; j++)
+        if(arrGroups[j].size > arrGroups[i].size)
+          i = j;
+    }
+    else
+      i = HINT_Random(pHint, nGroups);
+    arrMoves[nCount].row = arrGroups[i].row;
+    arrMoves[nCount++].col = arrGroups[i].col;
+    SAGA_BoardDeleteBlocks(&Board, arrGroups[i].row, arrGroups[i].col);
+  }
+
+  //  The tablebase knows the rest, its moves are only needed for a new best
+  if(nValue >= 0)
+  {
+    if(Board.nScore + TBL_SCORE(nValue) <= pHint->nBestScore)
+      return;
+    while(TBL_GetBestMove(pBase, &Board, &arrMoves[nCount]) >= 0)
+    {
+      SAGA_BoardDeleteBlocks(&Board, arrMoves[nCount].row, arrMoves[nCount].col);
+      nCount++;
+    }
+  }
+
+  if(Board.nScore > pHint->nBestScore)
+  {
+    pHint->nBestScore = Board.nScore;
+    pHint->nBestMoves = nCount;
+    memcpy(pHint->arrBest, arrMoves, nCount * sizeof(SAGA_Cell));
+  }
+}
+
+//*==============================================================================*/
+/*  HINT_Init                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Initialize a search
+ *
+ * \param     pHint --> search state, nSeed --> seed of the random games
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void HINT_Init(HINT_Search *pHint, uint64_t nSeed)
+{
+  pHint->nSeed = nSeed;
+  pHint->pBase = NULL;
+  pHint->bValid = false;
+}
+
+//*==============================================================================*/
+/*  HINT_SetTablebase                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Use an endgame tablebase
+ *
+ * \details   The search starts over with the next step.
+ *
+ * \param     pHint --> search state, pBase --> tablebase or NULL
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void HINT_SetTablebase(HINT_Search *pHint, const TBL_Table *pBase)
+{
+  pHint->pBase = pBase;
+  pHint->bValid = false;
+}
+
+//*==============================================================================*/
+/*  HINT_Invalidate                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Forget the position
+ *
+ * \details   The next step starts over. A step notices a changed board by
+ * \n         itself, this is only needed if a board could come back with
+ * \n         the same hash and score but must be searched again.
+ *
+ * \param     pHint --> search state
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void HINT_Invalidate(HINT_Search *pHint)
+{
+  pHint->bValid = false;
+}
+
+//*==============================================================================*/
+/*  HINT_Step                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Search for a while
+ *
+ * \details   Continue the search of the board for about nMicros, at least
+ * \n         one game is played. If the board differs from the one of the
+ * \n         last step by its hash or its score, the search starts over,
+ * \n         the best game counts the points of the board it started from.
+ * \n         Once the best game reaches the upper bound of the analysis it
+ * \n         can't be beaten and nothing is played any more.
+ *
+ * \param     pHint --> search state, pBoard --> current position,
+ * \n         nMicros --> time of the slice in microseconds
+ *
+ * \return    score of the best game so far, -1 if there is no move
+ */
+/*===============================================================================*/
+int HINT_Step(HINT_Search *pHint, const SAGA_Board *pBoard, uint32_t nMicros)
+{
+  uint64_t nStart = HINT_Micros();
+
+  if(!pHint->bValid || pHint->Board.nHash != pBoard->nHash ||
+     pHint->Board.nScore != pBoard->nScore)
+  {
+    SAGA_BoardCopy(&pHint->Board, pBoard);
+    pHint->nGroups = SAGA_BoardEnumerateMoves(pBoard, pHint->arrGroups, SAGA_MAXGROUPS, NULL);
+    pHint->nNext = 0;
+    pHint->nRandom = pHint->nSeed ^ pBoard->nHash;
+    pHint->nPlayouts = 0;
+    pHint->nBestScore = -1;
+    pHint->nBestMoves = 0;
+    pHint->bValid = true;
+  }
+  if(pHint->nGroups == 0)
+    return -1;
+  if(pHint->nBestScore >= pBoard->nScore + ANA_GetUpperBound(pBoard))
+    return pHint->nBestScore;
+
+  do
+    HINT_Playout(pHint);
+  while(HINT_Micros() - nStart < nMicros);
+  return pHint->nBestScore;
+}
+
+//*==============================================================================*/
+/*  HINT_GetBest                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the hint
+ *
+ * \param     pHint --> search state, pMove --> best move so far
+ *
+ * \return    score of the best game so far, -1 if there is no hint
+ */
+/*===============================================================================*/
+int HINT_GetBest(const HINT_Search *pHint, SAGA_Cell *pMove)
+{
+  if(!pHint->bValid || pHint->nBestMoves == 0)
+    return -1;
+  *pMove = pHint->arrBest[0];
+  return pHint->nBestScore;
+}
+
+//*==============================================================================*/
+/*  HINT_GetGroup                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the blocks of the hint
+ *
+ * \details   All blocks of the group of the best move in board coordinates,
+ * \n         e.g. to highlight them.
+ *
+ * \param     pHint --> search state, pCells --> output, SAGA_MAXCELLS entries
+ *
+ * \return    number of blocks, 0 if there is no hint
+ */
+/*===============================================================================*/
+int HINT_GetGroup(const HINT_Search *pHint, SAGA_Cell *pCells)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  unsigned char arrLabels[SAGA_MAXCELLS];
+  const SAGA_Board *pBoard = &pHint->Board;
+  int col, h, nLabel, nCount = 0;
+
+  if(!pHint->bValid || pHint->nBestMoves == 0)
+    return 0;
+  SAGA_BoardEnumerateMoves(pBoard, arrGroups, SAGA_MAXGROUPS, arrLabels);
+  nLabel = arrLabels[pHint->arrBest[0].col * pBoard->nRows + pBoard->nRows - 1 - pHint->arrBest[0].row];
+  for(col = 0; col < pBoard->nUsedColumns; col++)
+  {
+    for(h = 0; h < pBoard->arrHeights[col]; h++)
+    {
+      if(arrLabels[col * pBoard->nRows + h] == nLabel)
+      {
+        pCells[nCount].row = pBoard->nRows - 1 - h;
+        pCells[nCount++].col = col;
+      }
+    }
+  }
+  return nCount;
+}
+
+//----------------------------------- END --------------------------------------
@@ -50,16 +50,33 @@ int main(int argc, char **argv)
 	int iRemaining;                      // counting remainig blocks   
 	int iEColumn, iERow;                 // game board coordinates
 	bool bGameOver = false;              // game over checking
+	bool bLost = false;                  // blocks left which can't be cleared any more
+	bool bChanged;                       // board changed by undo or redo
+	SAGA_Event arrEvents[SAGA_MAXEVENTS]; // changes of the last move
+	SAGA_Cell arrHint[SAGA_MAXCELLS];    // blocks of the hint
+	bool bHint = false;                  // hint is shown
+	static HINT_Search Hint;             // search for the hint, runs every frame
+	static TBL_Table Base;               // endgame tablebase, if there is one
+	static SAGA_Board Saved;             // game left with START last time
 
 	SAGA_GameInit();                     // create a game field
 	RDR_DisplayInit();                   // display and rendering settings
 	RDR_SceneInit();                     // initialize the scene
+	HINT_Init(&Hint, time(NULL));        // nothing is searched before the first frame
+	if(TBL_Open(&Base, ENDGAME_FILE))    // the hint plays the endgames exactly
+		HINT_SetTablebase(&Hint, &Base);
                  
 	bool bTouched = false;               // if bottom screen is touched
 	touchPosition touch = { 0 };         // save the touch inputs
 	touchPosition t_queue = { 0 };       // save old touch inputs for camparison
 
 	iMode = NEW_GAME_MODE;               // start with a new game
+	if(CDC_LoadGame(&Saved, SAVE_FILE) && SAGA_ResumeBoard(&Saved))
+	{                                    // or go on with the saved one
+		RDR_DrawSplashScreen(GFX_TOP, game_bgr, game_bgr_size, 0);
+		RDR_DrawGameBoard();
+		iMode = GAME_PLAY_MODE;
+	}
 
 	
 	while (aptMainLoop())                // Main loop
@@ -70,14 +87,52 @@ int main(int argc, char **argv)
 		{
 			RDR_DrawSplashScreen(GFX_TOP, game_bgr, game_bgr_size, 0);
 		
-			SAGA_SetupBoard();               // fill game board with random colors
+			SAGA_SetupClearableBoard();      // fill game board, always with a way to win
 			RDR_DrawGameBoard();             // draw the board on the screen
+			bLost = false;
 
 			iMode = GAME_PLAY_MODE;          // enter game mode
 		}
 
+		// take back the last move or play it again, also after the game is over
+		if(iMode == GAME_PLAY_MODE || iMode == GAME_END_MODE)
+		{
+			u32 kDown = hidKeysDown();
+			bChanged = false;
+			if(kDown & KEY_L && SAGA_UndoMove() > 0)  // take back the last move
+			{
+				RDR_DrawGameBoard();                 // draw the game board on the display
+				bChanged = true;
+			}
+			if(kDown & KEY_R && SAGA_RedoMove() > 0)  // or play it again
+			{
+				RDR_UpdateGameBoard(arrEvents, SAGA_GetMoveEvents(arrEvents)); // only changed blocks
+				bChanged = true;
+			}
+			if(bChanged)
+			{
+				bGameOver = SAGA_IsGameOver();
+				bHint = false;
+				if(iMode == GAME_END_MODE && !bGameOver) // back to the game
+				{
+					RDR_DrawSplashScreen(GFX_TOP, game_bgr, game_bgr_size, 0);
+					bLost = false;
+					iMode = GAME_PLAY_MODE;
+				}
+			}
+		}
+
 		if(iMode == GAME_PLAY_MODE)        // do as long as new game is choosen
     {
+			if(!bGameOver && bLost != SAGA_IsGameLost()) // show whether a clear is still possible
+			{
+				bLost = !bLost;
+				if(bLost)
+					RDR_DrawSplashScreen(GFX_TOP, over_bgr, over_bgr_size, 0);
+				else
+					RDR_DrawSplashScreen(GFX_TOP, game_bgr, game_bgr_size, 0);
+			}
+
 			if (!bGameOver)                  // do till game is over
 			{
 				hidTouchRead(&touch);          // read the touch screen coordinates	 
@@ -87,24 +142,35 @@ int main(int argc, char **argv)
 					iERow = touch.py / 32;       // calculate the selected game board row
 					iEColumn = touch.px / 32;    // calculate the selected game board column
 
-					SAGA_DeleteBlocks(iERow, iEColumn);  // delete blocks if possible
-					RDR_DrawGameBoard();                 // draw the game board on the display
-					bGameOver = SAGA_IsGameOver();       // check whether there are still blocks
+					if(SAGA_DeleteBlocks(iERow, iEColumn) > 0)  // delete blocks if possible
+					{
+						RDR_UpdateGameBoard(arrEvents, SAGA_GetMoveEvents(arrEvents)); // only changed blocks
+						bHint = false;             // the hint was for the old board
+					}
+					bGameOver = SAGA_IsGameOver(); // no move left
 
 					t_queue.px = touch.px;       // save the old touch coordinates in x
 					t_queue.py = touch.py;       // save the old touch coordinates in y
 					bTouched = true;             // start the delay counter for touch detection
 				}
 
+				if(hidKeysDown() & KEY_Y)             // show the best group
+					bHint = true;
+
 				SYS_TouchDelay(&bTouched);     // non-blocking delay for touch input
 
-				// animated movement of the sprites --> for future use
-				//RDR_MoveSprites();
+				RDR_MoveSprites();             // let the moved blocks fall and slide
 				
 				RDR_SceneRender();             // Render the game scene
+
+				// search the hint in the rest of the frame, it gets better
+				// every frame and starts over when the board changed
+				HINT_Step(&Hint, SAGA_GetBoard(), HINT_SLICE);
+				if (bHint)
+					RDR_SetHint(arrHint, HINT_GetGroup(&Hint, arrHint));
 			}
-			else                             // do this after game is finished
-			{
+			else if (!RDR_MoveSprites())     // do this after game is finished
+			{                                // and the last blocks came to rest
 					// check if there are undeletable blocks remaining
 					iRemaining = SAGA_GetRemainingCount(); 
 				
@@ -128,19 +194,30 @@ int main(int argc, char **argv)
 			if(kDown & KEY_A || kDown & KEY_TOUCH) // start new game if button A
 			{                                      // or touch screen is pressed
 				bGameOver = false;
+				bHint = false;
 				iMode = NEW_GAME_MODE;
 			}
 		}
 			
 
 		if(SYS_UserExit())                 // exit the program if START is pressed
+		{
+			if(iMode == GAME_PLAY_MODE && !bGameOver) // keep a running game for the next start
+			{
+				mkdir(SAVE_DIR, 0777);
+				CDC_SaveGame(SAGA_GetBoard(), SAVE_FILE);
+			}
+			else
+				remove(SAVE_FILE);
 			break;
+		}
 
 		gfxSwapBuffers();
 	}
 	
 
 	SAGA_DeleteBoard();
+	TBL_Free(&Base);
 
 	// Deinitialize the scene
 	RDR_SceneExit();
@@ -0,0 +1,464 @@
+/*********************************************************************************/
+/*!
+ * \file      persist.c
+ *
+ * \brief     The Same Game v0.1 --> PERSISTENT BOARD File
+ *
+ * \details   Immutable boards which share their columns. The columns live
+ * \n         in a reference counted pool, a move only allocates the columns
+ * \n         it changes and all other columns are shared with the parent,
+ * \n         so search trees branch from a position without copying it.
+ * \n         A board itself is just the list of its column indices. The
+ * \n         pool is addressed by index, so it could grow with realloc while
+ * \n         boards are alive. It is not locked, every thread needs its own.
+ * \n         The beam search of tools/samebeam -p keeps its layers in a pool,
+ * \n         tools/samepers checks every child against the engine.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include "persist.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// access to a shared column by its index
+#define PERS_COLUMN(pPool, pPers, col)  (&(pPool)->pColumns[(pPers)->arrColumns[col]])
+
+//*==============================================================================*/
+/*  PERS_PoolInit                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Create a column pool
+ *
+ * \param     pPool --> pool, nSize --> number of columns to start with
+ *
+ * \return    true if the storage could be allocated
+ */
+/*===============================================================================*/
+bool PERS_PoolInit(PERS_Pool *pPool, uint32_t nSize)
+{
+  uint32_t i;
+
+  if(nSize < 2)
+    nSize = 2;
+  pPool->pColumns = malloc(nSize * sizeof(PERS_Column));
+  if(pPool->pColumns == NULL)
+    return false;
+
+  //  Chain all columns except the reserved first one into the free list
+  for(i = 1; i < nSize; i++)
+  {
+    pPool->pColumns[i].nRefs = 0;
+    pPool->pColumns[i].nNext = i + 1 < nSize ? i + 1 : PERS_NOCOLUMN;
+  }
+  pPool->nSize = nSize;
+  pPool->nFree = 1;
+  pPool->nUsed = 0;
+  return true;
+}
+
+//*==============================================================================*/
+/*  PERS_PoolFree                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Free a column pool
+ *
+ * \details   All boards of the pool get invalid.
+ *
+ * \param     pPool --> pool
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void PERS_PoolFree(PERS_Pool *pPool)
+{
+  free(pPool->pColumns);
+  pPool->pColumns = NULL;
+  pPool->nSize = 0;
+  pPool->nFree = PERS_NOCOLUMN;
+  pPool->nUsed = 0;
+}
+
+//*==============================================================================*/
+/*  PERS_AllocColumn                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Take a column from the pool
+ *
+ * \details   The storage is doubled if there is no free column left. This
+ * \n         could move all columns, so pointers into the pool must be
+ * \n         fetched again after every allocation.
+ *
+ * \param     pPool --> pool
+ *
+ * \return    index of the column with one reference, PERS_NOCOLUMN if the
+ * \n         pool couldn't grow
+ */
+/*===============================================================================*/
+static uint32_t PERS_AllocColumn(PERS_Pool *pPool)
+{
+  PERS_Column *pColumns;
+  uint32_t i, nIndex;
+
+  if(pPool->nFree == PERS_NOCOLUMN)
+  {
+    pColumns = realloc(pPool->pColumns, 2 * pPool->nSize * sizeof(PERS_Column));
+    if(pColumns == NULL)
+      return PERS_NOCOLUMN;
+    for(i = pPool->nSize; i < 2 * pPool->nSize; i++)
+    {
+      pColumns[i].nRefs = 0;
+      pColumns[i].nNext = i + 1 < 2 * pPool->nSize ? i + 1 : PERS_NOCOLUMN;
+    }
+    pPool->nFree = pPool->nSize;
+    pPool->nSize *= 2;
+    pPool->pColumns = pColumns;
+  }
+
+  nIndex = pPool->nFree;
+  pPool->nFree = pPool->pColumns[nIndex].nNext;
+  pPool->pColumns[nIndex].nRefs = 1;
+  pPool->nUsed++;
+  return nIndex;
+}
+
+//*==============================================================================*/
+/*  PERS_ReleaseColumn                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Drop a reference to a column
+ *
+ * \details   The column goes back to the pool with its last reference.
+ *
+ * \param     pPool --> pool, nIndex --> column
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void PERS_ReleaseColumn(PERS_Pool *pPool, uint32_t nIndex)
+{
+  PERS_Column *pColumn = &pPool->pColumns[nIndex];
+
+  if(--pColumn->nRefs == 0)
+  {
+    pColumn->nNext = pPool->nFree;
+    pPool->nFree = nIndex;
+    pPool->nUsed--;
+  }
+}
+
+//*==============================================================================*/
+/*  PERS_FromBoard                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Convert a board into a persistent board
+ *
+ * \details   Every column of the board gets its own pool column.
+ *
+ * \param     pPool --> pool, pPers --> destination, pBoard --> source board
+ *
+ * \return    true if the pool had enough room
+ */
+/*===============================================================================*/
+bool PERS_FromBoard(PERS_Pool *pPool, PERS_Board *pPers, const SAGA_Board *pBoard)
+{
+  PERS_Column *pColumn;
+  uint32_t nIndex;
+  int col;
+
+  pPers->nColumns = pBoard->nColumns;
+  pPers->nRows = pBoard->nRows;
+  pPers->nRemaining = pBoard->nRemaining;
+  pPers->nColors = pBoard->nColors;
+  pPers->nUsedColumns = 0;
+  pPers->nScore = pBoard->nScore;
+  memset(pPers->arrColumns, 0, sizeof(pPers->arrColumns));
+
+  for(col = 0; col < pBoard->nUsedColumns; col++)
+  {
+    nIndex = PERS_AllocColumn(pPool);
+    if(nIndex == PERS_NOCOLUMN)
+    {
+      PERS_Release(pPool, pPers);
+      return false;
+    }
+    pColumn = &pPool->pColumns[nIndex];
+    pColumn->nHeight = pBoard->arrHeights[col];
+    memcpy(pColumn->arrCells, &pBoard->arrCells[col * pBoard->nRows], pColumn->nHeight);
+    pPers->arrColumns[pPers->nUsedColumns++] = nIndex;
+  }
+  return true;
+}
+
+//*==============================================================================*/
+/*  PERS_ToBoard                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Convert a persistent board back into a board
+ *
+ * \param     pPool --> pool, pPers --> persistent board, pBoard --> destination
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void PERS_ToBoard(const PERS_Pool *pPool, const PERS_Board *pPers, SAGA_Board *pBoard)
+{
+  const PERS_Column *pColumn;
+  int col;
+
+  SAGA_BoardInit(pBoard, pPers->nColumns, pPers->nRows, pPers->nColors);
+  for(col = 0; col < pPers->nUsedColumns; col++)
+  {
+    pColumn = PERS_COLUMN(pPool, pPers, col);
+    memcpy(&pBoard->arrCells[col * pBoard->nRows], pColumn->arrCells, pColumn->nHeight);
+    pBoard->arrHeights[col] = pColumn->nHeight;
+  }
+  pBoard->nUsedColumns = pPers->nUsedColumns;
+  pBoard->nRemaining = pPers->nRemaining;
+  pBoard->nScore = pPers->nScore;
+  SAGA_BoardRefresh(pBoard);
+}
+
+//*==============================================================================*/
+/*  PERS_Retain                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Keep the columns of a board alive
+ *
+ * \details   Needed for every copy of a PERS_Board which is released on its
+ * \n         own later.
+ *
+ * \param     pPool --> pool, pPers --> persistent board
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void PERS_Retain(PERS_Pool *pPool, const PERS_Board *pPers)
+{
+  int col;
+
+  for(col = 0; col < pPers->nUsedColumns; col++)
+    PERS_COLUMN(pPool, pPers, col)->nRefs++;
+}
+
+//*==============================================================================*/
+/*  PERS_Release                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Free a persistent board
+ *
+ * \details   Columns which are not shared with other boards go back to the
+ * \n         pool. The board is left empty.
+ *
+ * \param     pPool --> pool, pPers --> persistent board
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void PERS_Release(PERS_Pool *pPool, PERS_Board *pPers)
+{
+  int col;
+
+  for(col = 0; col < pPers->nUsedColumns; col++)
+  {
+    PERS_ReleaseColumn(pPool, pPers->arrColumns[col]);
+    pPers->arrColumns[col] = PERS_NOCOLUMN;
+  }
+  pPers->nUsedColumns = 0;
+  pPers->nRemaining = 0;
+}
+
+//*==============================================================================*/
+/*  PERS_GetBlock                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the color index of a block
+ *
+ * \param     pPool --> pool, pPers --> persistent board, row, column
+ *
+ * \return    color index, 0 for background or outside the board
+ */
+/*===============================================================================*/
+int PERS_GetBlock(const PERS_Pool *pPool, const PERS_Board *pPers, int row, int col)
+{
+  const PERS_Column *pColumn;
+  int h = pPers->nRows - 1 - row;
+
+  if(row < 0 || row >= pPers->nRows || col < 0 || col >= pPers->nUsedColumns)
+    return 0;
+  pColumn = PERS_COLUMN(pPool, pPers, col);
+  return h < pColumn->nHeight ? pColumn->arrCells[h] : 0;
+}
+
+//*==============================================================================*/
+/*  PERS_IsGameOver                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Check whether the game is over
+ *
+ * \details   Search for two touching blocks with the same color, column by
+ * \n         column. Nothing is stored in the board, so it has to scan.
+ *
+ * \param     pPool --> pool, pPers --> persistent board
+ *
+ * \return    true if no move is left
+ */
+/*===============================================================================*/
+bool PERS_IsGameOver(const PERS_Pool *pPool, const PERS_Board *pPers)
+{
+  const PERS_Column *pColumn, *pRight;
+  int col, h, nHeight;
+
+  for(col = 0; col < pPers->nUsedColumns; col++)
+  {
+    pColumn = PERS_COLUMN(pPool, pPers, col);
+    for(h = 1; h < pColumn->nHeight; h++)
+      if(pColumn->arrCells[h] == pColumn->arrCells[h - 1])
+        return false;
+    if(col + 1 < pPers->nUsedColumns)
+    {
+      pRight = PERS_COLUMN(pPool, pPers, col + 1);
+      nHeight = pColumn->nHeight < pRight->nHeight ? pColumn->nHeight : pRight->nHeight;
+      for(h = 0; h < nHeight; h++)
+        if(pColumn->arrCells[h] == pRight->arrCells[h])
+          return false;
+    }
+  }
+  return true;
+}
+
+//*==============================================================================*/
+/*  PERS_Visit                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Flood fill step
+ *
+ * \details   Append a block to the list if it has the color and isn't
+ * \n         marked yet.
+ *
+ * \param     pPool --> pool, pPers --> persistent board, col, h --> block,
+ * \n         color --> color index, pRemoved --> marks of each column,
+ * \n         pCol, pH --> list of found blocks, nCount --> length of the list
+ *
+ * \return    new length of the list
+ */
+/*===============================================================================*/
+static inline int PERS_Visit(const PERS_Pool *pPool, const PERS_Board *pPers, int col, int h,
+                             int color, unsigned short *pRemoved, unsigned char *pCol,
+                             unsigned char *pH, int nCount)
+{
+  const PERS_Column *pColumn;
+
+  if(col < 0 || col >= pPers->nUsedColumns || h < 0 || (pRemoved[col] >> h) & 1)
+    return nCount;
+  pColumn = PERS_COLUMN(pPool, pPers, col);
+  if(h < pColumn->nHeight && pColumn->arrCells[h] == color)
+  {
+    pRemoved[col] |= 1u << h;
+    pCol[nCount] = col;
+    pH[nCount++] = h;
+  }
+  return nCount;
+}
+
+//*==============================================================================*/
+/*  PERS_DeleteBlocks                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Delete blocks into a new board
+ *
+ * \details   The parent stays as it is. The group is found with a flood fill
+ * \n         which only marks the blocks in one bit mask per column. The
+ * \n         child shares every untouched column with the parent, only the
+ * \n         touched columns are compacted into new pool columns and empty
+ * \n         ones are left out. The child gets the score of the move and
+ * \n         the clear bonus like SAGA_BoardDeleteBlocks. The child must be
+ * \n         released on its own.
+ *
+ * \param     pPool --> pool, pParent --> board before the move, row, column,
+ * \n         pChild --> board after the move
+ *
+ * \return    number of deleted blocks, -1 if no move, -2 if the pool couldn't
+ * \n         grow, pChild is empty in both cases
+ */
+/*===============================================================================*/
+int PERS_DeleteBlocks(PERS_Pool *pPool, const PERS_Board *pParent, int row, int col,
+                      PERS_Board *pChild)
+{
+  unsigned short arrRemoved[SAGA_MAXCOLUMNS] = { 0 };
+  unsigned char arrCol[SAGA_MAXCELLS], arrH[SAGA_MAXCELLS];
+  const PERS_Column *pColumn;
+  PERS_Column *pNew;
+  int nColor = PERS_GetBlock(pPool, pParent, row, col);
+  int nHead = 0, nCount = 0, h, c;
+  uint32_t nIndex;
+
+  *pChild = *pParent;
+  pChild->nUsedColumns = 0;
+  if(nColor == 0)
+    return -1;
+
+  //  Flood fill, the list of found blocks is the work queue
+  arrCol[nCount] = col;
+  arrH[nCount++] = pParent->nRows - 1 - row;
+  arrRemoved[col] = 1u << (pParent->nRows - 1 - row);
+  while(nHead < nCount)
+  {
+    c = arrCol[nHead];
+    h = arrH[nHead++];
+    nCount = PERS_Visit(pPool, pParent, c, h + 1, nColor, arrRemoved, arrCol, arrH, nCount);
+    nCount = PERS_Visit(pPool, pParent, c, h - 1, nColor, arrRemoved, arrCol, arrH, nCount);
+    nCount = PERS_Visit(pPool, pParent, c - 1, h, nColor, arrRemoved, arrCol, arrH, nCount);
+    nCount = PERS_Visit(pPool, pParent, c + 1, h, nColor, arrRemoved, arrCol, arrH, nCount);
+  }
+  if(nCount < 2)
+    return -1;
+
+  //  Share the untouched columns and compact the touched ones
+  for(c = 0; c < pParent->nUsedColumns; c++)
+  {
+    if(arrRemoved[c] == 0)
+    {
+      PERS_COLUMN(pPool, pParent, c)->nRefs++;
+      pChild->arrColumns[pChild->nUsedColumns++] = pParent->arrColumns[c];
+      continue;
+    }
+    if(PERS_COLUMN(pPool, pParent, c)->nHeight == __builtin_popcount(arrRemoved[c]))
+      continue;
+
+    nIndex = PERS_AllocColumn(pPool);
+    if(nIndex == PERS_NOCOLUMN)
+    {
+      PERS_Release(pPool, pChild);
+      return -2;
+    }
+    pNew = &pPool->pColumns[nIndex];
+    pColumn = PERS_COLUMN(pPool, pParent, c);
+    for(h = 0, pNew->nHeight = 0; h < pColumn->nHeight; h++)
+      if(!((arrRemoved[c] >> h) & 1))
+        pNew->arrCells[pNew->nHeight++] = pColumn->arrCells[h];
+    pChild->arrColumns[pChild->nUsedColumns++] = nIndex;
+  }
+  for(c = pChild->nUsedColumns; c < SAGA_MAXCOLUMNS; c++)
+    pChild->arrColumns[c] = PERS_NOCOLUMN;
+
+  pChild->nRemaining = pParent->nRemaining - nCount;
+  pChild->nScore += SAGA_GetMoveScore(nCount) + (pChild->nRemaining == 0 ? SAGA_CLEARBONUS : 0);
+  return nCount;
+}
+
+//----------------------------------- END --------------------------------------
@@ -27,6 +27,8 @@
 /*-------------------------------------------------------------------------------*/
 C3D_RenderTarget* target;
 Sprite sprites[NUM_SPRITES];
+static bool hints[NUM_SPRITES];        // blocks of the hint, they blink
+static u32 frames;                     // rendered frames, clock of the blinking
 
 /*struct { float left, right, top, bottom; } images[4] = {
 	{0.0f, 0.5f, 0.0f, 0.5f},
@@ -118,6 +120,7 @@ void RDR_DrawGameBoard(void)
 	int Color;
 	int row, col, index;
 
+	memset(hints, 0, sizeof(hints));     // the hint is for the old board
 	for (row = 0; row < NUMOFROWS; row++)
 	{
 		for (col = 0; col < NUMOFCOLUMN; col++)
@@ -126,8 +129,10 @@ void RDR_DrawGameBoard(void)
 
 			index = row * NUMOFCOLUMN + col;
 
-			sprites[index].x = (col * 32) << 8;
-			sprites[index].y = (row * 32 + 7) << 8;
+			sprites[index].x = SPRITE_X(col);
+			sprites[index].y = SPRITE_Y(row);
+			sprites[index].dx = 0;
+			sprites[index].dy = 0;
 			//sprites[index].image = rand() % 7;
 
 			if (Color == RED) {
@@ -147,6 +152,108 @@ void RDR_DrawGameBoard(void)
 }
 
 
+//*==============================================================================*/
+/*  RDR_PassSprite                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Hand a block over to another sprite
+ *
+ * \details   The sprite of the new place gets the image and the current
+ * \n         screen position of the block and starts to move from there,
+ * \n         the old place gets empty.
+ *
+ * \param     from, to --> sprite index of the old and the new place
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void RDR_PassSprite(int from, int to)
+{
+	int x = SPRITE_X(to % NUMOFCOLUMN);
+	int y = SPRITE_Y(to / NUMOFCOLUMN);
+
+	sprites[to] = sprites[from];
+	if (sprites[to].image == BLACK_SPRITE) {
+		sprites[to].x = x;
+		sprites[to].y = y;
+	}
+	sprites[to].dx = sprites[to].x > x ? -SPRITE_SPEED : 0;
+	sprites[to].dy = sprites[to].y < y ? SPRITE_SPEED : 0;
+
+	sprites[from].image = BLACK_SPRITE;
+	sprites[from].x = SPRITE_X(from % NUMOFCOLUMN);
+	sprites[from].y = SPRITE_Y(from / NUMOFCOLUMN);
+	sprites[from].dx = 0;
+	sprites[from].dy = 0;
+}
+
+//*==============================================================================*/
+/*  RDR_UpdateGameBoard                                                          */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Update the sprites changed by a move
+ *
+ * \details   Apply the events of a move to the sprites of the game board,
+ * \n         only the removed and moved blocks are touched. Moved blocks
+ * \n         keep their screen position and are animated to their new place
+ * \n         by RDR_MoveSprites.
+ *
+ * \param     pEvents --> events of the move, nEvents --> number of events
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void RDR_UpdateGameBoard(const SAGA_Event *pEvents, int nEvents)
+{
+	int i, row, from, to;
+
+	memset(hints, 0, sizeof(hints));     // the hint is for the old board
+	for (i = 0; i < nEvents; i++)
+	{
+		from = pEvents[i].row * NUMOFCOLUMN + pEvents[i].col;
+		to = pEvents[i].newRow * NUMOFCOLUMN + pEvents[i].newCol;
+
+		if (pEvents[i].type == SAGA_EVENT_REMOVE) {
+			sprites[from].image = BLACK_SPRITE;
+			sprites[from].x = SPRITE_X(pEvents[i].col);
+			sprites[from].y = SPRITE_Y(pEvents[i].row);
+			sprites[from].dx = 0;
+			sprites[from].dy = 0;
+		}
+		else if (pEvents[i].type == SAGA_EVENT_FALL) {
+			RDR_PassSprite(from, to);
+		}
+		else {
+			// a whole column slides to the left
+			for (row = 0; row < NUMOFROWS; row++)
+				RDR_PassSprite(from + row * NUMOFCOLUMN, to + row * NUMOFCOLUMN);
+		}
+	}
+}
+
+//*==============================================================================*/
+/*  RDR_SetHint                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Highlight the blocks of a hint
+ *
+ * \details   The given blocks blink until the next hint or until the board
+ * \n         is drawn or updated again.
+ *
+ * \param     pCells --> blocks in board coordinates, nCells --> number of them
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void RDR_SetHint(const SAGA_Cell *pCells, int nCells)
+{
+	int i;
+
+	memset(hints, 0, sizeof(hints));
+	for (i = 0; i < nCells; i++)
+		hints[pCells[i].row * NUMOFCOLUMN + pCells[i].col] = true;
+}
+
 /*-------------------------------------------------------------------------------*/
 /*  Rendering functions                                                          */
 /*-------------------------------------------------------------------------------*/
@@ -281,22 +388,39 @@ void RDR_SceneInit(void) {
 
 
 //---------------------------------------------------------------------------------
-void RDR_MoveSprites(void) {
+bool RDR_MoveSprites(void) {
 //---------------------------------------------------------------------------------
 
 	int i;
+	bool bFalling = false;
+	bool bSliding = false;
 
+	// blocks fall down first
 	for(i = 0; i < NUM_SPRITES; i++) {
-		sprites[i].x += sprites[i].dx;
-		sprites[i].y += sprites[i].dy;
-			
-		//check for collision with the screen boundaries
-		if(sprites[i].x < (1<<8) || sprites[i].x > ((400-32) << 8))
-			sprites[i].dx = -sprites[i].dx;
+		if(sprites[i].dy) {
+			sprites[i].y += sprites[i].dy;
+			if(sprites[i].y >= SPRITE_Y(i / NUMOFCOLUMN)) {
+				sprites[i].y = SPRITE_Y(i / NUMOFCOLUMN);
+				sprites[i].dy = 0;
+			}
+			bFalling = true;
+		}
+	}
+	if(bFalling)
+		return true;
 
-		if(sprites[i].y < (1<<8) || sprites[i].y > ((240-32) << 8))
-			sprites[i].dy = -sprites[i].dy;
+	// then the columns slide to the left
+	for(i = 0; i < NUM_SPRITES; i++) {
+		if(sprites[i].dx) {
+			sprites[i].x += sprites[i].dx;
+			if(sprites[i].x <= SPRITE_X(i % NUMOFCOLUMN)) {
+				sprites[i].x = SPRITE_X(i % NUMOFCOLUMN);
+				sprites[i].dx = 0;
+			}
+			bSliding = true;
+		}
 	}
+	return bSliding;
 }
 
 //---------------------------------------------------------------------------------
@@ -309,9 +433,16 @@ void RDR_SceneRender(void) {
 	// Update the uniforms
 	C3D_FVUnifMtx4x4(GPU_VERTEX_SHADER, uLoc_projection, &projection);
 
+	// resting sprites first, so the moving ones are drawn on top of them,
+	// the blocks of a hint are left out every other 16 frames
+	frames++;
 	for(i = 0; i < NUM_SPRITES; i++) {
-
-		RDR_DrawSprite( sprites[i].x >> 8, sprites[i].y >> 8, 32, 32, sprites[i].image);
+		if(!sprites[i].dx && !sprites[i].dy && !(hints[i] && (frames & 16)))
+			RDR_DrawSprite( sprites[i].x >> 8, sprites[i].y >> 8, 32, 32, sprites[i].image);
+	}
+	for(i = 0; i < NUM_SPRITES; i++) {
+		if(sprites[i].dx || sprites[i].dy)
+			RDR_DrawSprite( sprites[i].x >> 8, sprites[i].y >> 8, 32, 32, sprites[i].image);
 	}
 
 	C3D_FrameEnd(0);
@@ -25,20 +25,66 @@
 /*-------------------------------------------------------------------------------*/
 /*  Include files                                                                */
 /*-------------------------------------------------------------------------------*/
-#include "system.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include <assert.h>
 #include "samegame.h"
-#include "stdlib.h"
-#include <malloc.h>
+#include "analysis.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// access to a block of the packed board, stored column by column from the bottom
+#define SAGA_CELL(pBoard, row, col) \
+  (pBoard)->arrCells[(col) * (pBoard)->nRows + (pBoard)->nRows - 1 - (row)]
+
+// temporary mark of a block found by the flood fill, never a valid color
+#define SAGA_MARK  0x80
+
+// attempts of the clearable generator before it takes back up to
+// SAGA_GENTAKEBACK groups, starts over or gives up
+#define SAGA_GENBACKTRACK   4
+#define SAGA_GENTAKEBACK   12
+#define SAGA_GENTRIES    1024
+#define SAGA_GENRESTARTS   16
+
+// kinds of groups the clearable generator inserts
+#define SAGA_STEP_COLUMN      0
+#define SAGA_STEP_VERTICAL    1
+#define SAGA_STEP_HORIZONTAL  2
+
+// debug builds recompute the incremental board state after every change
+#ifdef SAGA_DEBUG
+#define SAGA_CHECK(pBoard)  SAGA_BoardCheck(pBoard)
+#else
+#define SAGA_CHECK(pBoard)
+#endif
+
+// number of kernel sets, set 0 are the generic kernels
+#define SAGA_KERNELS  (int)(sizeof(m_arrKernels) / sizeof(m_arrKernels[0]))
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // inner loops of the engine for one board height
+  int nRows;                           // board height, 0 for the generic kernels
+  int (*pCountPairs)(const SAGA_Board *pBoard, int nFirst, int nLast);
+  int (*pDeleteNeighborBlocks)(SAGA_Board *pBoard, int row, int col, int color,
+                               SAGA_Cell *pRemoved);
+  void (*pCompact)(SAGA_Board *pBoard);
+}SAGA_Kernels;
 
 /*-------------------------------------------------------------------------------*/
 /*  Global variables                                                             */
 /*-------------------------------------------------------------------------------*/
-int** m_arrBoard;                      // pointer for the game data
-static char m_arrColors[8];            // list of colors
-int m_nColumns;                        // board size information
-int m_nRows;                           // board size information
-int m_nRemaining;                      // number of remaining blocks
-int m_nColors;                         // number of colors
+static SAGA_Board m_Board;             // board used by the global game functions
+static SAGA_Journal m_Journal;         // undo history of the global game
+
+// list of colors, shared by all boards
+static const char m_arrColors[8] = { BLACK, RED, YELLOW, BLUE, GREEN, GRAY, PURPLE, ORANGE };
 
 //*==============================================================================*/
 /*  SAGA_GameInit                                                                */
@@ -55,22 +101,10 @@ int m_nColors;                         // number of colors
 /*===============================================================================*/
 void SAGA_GameInit(void)
 {
-  m_arrBoard = NULL;
-  m_nColumns = NUMOFCOLUMN;
-  m_nRows = NUMOFROWS;
-  m_nRemaining = 0; 
-  m_nColors = NUMOFCOLORS;
+  SAGA_BoardInit(&m_Board, NUMOFCOLUMN, NUMOFROWS, NUMOFCOLORS);
   
-  m_arrColors[0] = BLACK;
-  m_arrColors[1] = RED;
-  m_arrColors[2] = YELLOW;
-  m_arrColors[3] = BLUE;
-  m_arrColors[4] = GREEN;
-  m_arrColors[5] = GRAY;
-  m_arrColors[6] = PURPLE;
-  m_arrColors[7] = ORANGE;
-  
-  srand(time(NULL));
+  //  Every start gives other games, each of them could be replayed by its number
+  SAGA_BoardSeed(&m_Board, time(NULL));
 }
 
 //*==============================================================================*/
@@ -79,7 +113,8 @@ void SAGA_GameInit(void)
 /*!
  * \brief     Randomly setup the board
  *
- * \details   Allocate memory for the board and fill it up with random colors. 
+ * \details   Clear the board and fill it up with random colors. The next
+ * \n         game number is drawn from the random stream of the board.
  *
  * \param     none
  *
@@ -88,20 +123,71 @@ void SAGA_GameInit(void)
 /*===============================================================================*/
 void SAGA_SetupBoard(void)
 {
-  int row, col;
-  //  Create the board if needed
-  if(m_arrBoard == NULL)
-    SAGA_CreateBoard();
+  uint64_t nGame = SAGA_BoardRandom(&m_Board);
   
-  //  Randomly set each square to a color
-  for(row = 0; row < m_nRows; row++)
-    for(col = 0; col < m_nColumns; col++)
-    {
-      m_arrBoard[row][col] = (rand() % m_nColors) + 1;
-    }
+  SAGA_SetupGame((nGame << 32 | SAGA_BoardRandom(&m_Board)) & ~SAGA_CLEARABLEGAME);
+}
+
+//*==============================================================================*/
+/*  SAGA_SetupGame                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Setup a numbered game
+ *
+ * \details   The same game number always gives the same board, on every
+ * \n         platform. Numbers with SAGA_CLEARABLEGAME give boards which
+ * \n         could be cleared.
+ *
+ * \param     nGame --> game number
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_SetupGame(uint64_t nGame)
+{
+  SAGA_BoardSetupGame(&m_Board, nGame);
+  SAGA_JournalClear(&m_Journal);
+}
+
+//*==============================================================================*/
+/*  SAGA_SetupClearableBoard                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Setup a board which could be cleared
+ *
+ * \details   Like SAGA_SetupBoard, but the board is built by playing the
+ * \n         game backwards, so there is always a way to win. Its game
+ * \n         number has SAGA_CLEARABLEGAME set, so SAGA_SetupGame and the
+ * \n         host tools give the same board again.
+ *
+ * \param     none
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_SetupClearableBoard(void)
+{
+  uint64_t nGame = SAGA_BoardRandom(&m_Board);
   
-  //  Set the number of spaces remaining
-  m_nRemaining = m_nRows * m_nColumns;
+  SAGA_SetupGame(nGame << 32 | SAGA_BoardRandom(&m_Board) | SAGA_CLEARABLEGAME);
+}
+
+//*==============================================================================*/
+/*  SAGA_GetGameNumber                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the number of the game
+ *
+ * \details   Returns the game number the board was set up from.
+ *
+ * \param     none
+ *
+ * \return    game number
+ */
+/*===============================================================================*/
+uint64_t SAGA_GetGameNumber(void)
+{
+  return m_Board.nGame;
 }
 
 //*==============================================================================*/
@@ -120,10 +206,7 @@ void SAGA_SetupBoard(void)
 /*===============================================================================*/
 char SAGA_GetBlockColor(int row, int col)
 {
-  //  Check the bounds of the array
-  if(row < 0 || row >= m_nRows || col < 0 || col >= m_nColumns)
-    return m_arrColors[0];
-  return m_arrColors[m_arrBoard[row][col]];
+  return SAGA_BoardGetBlockColor(&m_Board, row, col);
 }
 
 //*==============================================================================*/
@@ -132,7 +215,8 @@ char SAGA_GetBlockColor(int row, int col)
 /*!
  * \brief     Delete the gameboard
  *
- * \details   Delete the gameboard and free the memory. 
+ * \details   Delete the gameboard. The board lives in static storage, so
+ * \n         there is nothing to free, all blocks are just cleared. 
  *
  * \param     none
  *
@@ -141,16 +225,7 @@ char SAGA_GetBlockColor(int row, int col)
 /*===============================================================================*/
 void SAGA_DeleteBoard(void)
 {
-  int row;
-  
-  //  Delete each colomn
-  for(row = 0; row < m_nRows; row++)
-  {
-    free(m_arrBoard[row]);
-  }
-  
-  // Finally delete the array of rows
-  free(m_arrBoard);
+  SAGA_BoardClear(&m_Board);
 }
 
 //*==============================================================================*/
@@ -159,7 +234,9 @@ void SAGA_DeleteBoard(void)
 /*!
  * \brief     Create a new gameboard
  *
- * \details   Allocate memory and create the 2-dimensional gameboard array. 
+ * \details   Create the gameboard in the static block array. The blocks are
+ * \n         stored column by column in one contiguous byte array, a 10x7
+ * \n         board therefore fits into two cache lines and no heap is needed.
  *
  * \param     none
  *
@@ -168,24 +245,7 @@ void SAGA_DeleteBoard(void)
 /*===============================================================================*/
 void SAGA_CreateBoard(void)
 {
-  int row, col;
-  
-  //  Create the array of rows
-  m_arrBoard = (int**) malloc(m_nRows * sizeof(int*));
-  if(!m_arrBoard) 
-		printf("\x1b[10;13HThe Same Game");
-  
-	//  Create each row
-  for(row = 0; row < m_nRows; row++)
-  {
-    m_arrBoard[row] = (int*) malloc(m_nColumns * sizeof(int*));
-	
-	//  Set each square to be empty
-	for(col = 0; col < m_nColumns; col++)
-    {
-      m_arrBoard[row][col] = 0;
-    }
-  }
+  SAGA_BoardClear(&m_Board);
 }
 
 //*==============================================================================*/
@@ -199,12 +259,12 @@ void SAGA_CreateBoard(void)
  *
  * \param     none
  *
- * \return    m_nColumns --> number of columns
+ * \return    number of columns
  */
 /*===============================================================================*/
 int SAGA_GetColumns(void) 
 { 
-  return m_nColumns; 
+  return m_Board.nColumns; 
 }
 
 //*==============================================================================*/
@@ -218,12 +278,12 @@ int SAGA_GetColumns(void)
  *
  * \param     none
  *
- * \return    m_nRows --> number of rows
+ * \return    number of rows
  */
 /*===============================================================================*/
 int SAGA_GetRows(void) 
 { 
-  return m_nRows; 
+  return m_Board.nRows; 
 }
 
 //*==============================================================================*/
@@ -237,12 +297,53 @@ int SAGA_GetRows(void)
  *
  * \param     none
  *
- * \return    m_nRemaining --> number of remaining blocks
+ * \return    number of remaining blocks
  */
 /*===============================================================================*/
 int SAGA_GetRemainingCount(void)
 {
-  return m_nRemaining; 
+  return m_Board.nRemaining; 
+}
+
+//*==============================================================================*/
+/*  SAGA_GetScore                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the score of the game
+ *
+ * \details   Points of all moves so far, an undo takes them back.
+ *
+ * \param     none
+ *
+ * \return    score
+ */
+/*===============================================================================*/
+int SAGA_GetScore(void)
+{
+  return m_Board.nScore;
+}
+
+//*==============================================================================*/
+/*  SAGA_GetMoveScore                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Points of a move
+ *
+ * \details   The usual Same Game score, (n - 2)^2 for a group of n blocks.
+ * \n         Fewer than 2 blocks are no move and get nothing. The clear
+ * \n         bonus isn't part of it, SAGA_BoardDeleteBlocksEx and BAT_Step
+ * \n         add SAGA_CLEARBONUS when a move clears the board.
+ *
+ * \param     nCount --> number of deleted blocks
+ *
+ * \return    points
+ */
+/*===============================================================================*/
+int SAGA_GetMoveScore(int nCount)
+{
+  if(nCount < 2)
+    return 0;
+  return (nCount - 2) * (nCount - 2);
 }
 
 //*==============================================================================*/
@@ -255,12 +356,12 @@ int SAGA_GetRemainingCount(void)
  *
  * \param     none
  *
- * \return    m_nColors --> number of colors
+ * \return    number of colors
  */
 /*===============================================================================*/
 int SAGA_GetNumColors(void) 
 {
-  return m_nColors; 
+  return m_Board.nColors; 
 }
 
 //*==============================================================================*/
@@ -278,31 +379,27 @@ int SAGA_GetNumColors(void)
 /*===============================================================================*/
 bool SAGA_IsGameOver(void)
 {
-  int col, row, nColor;
-  
-	//  Go column by column, left to right
-  for(col = 0; col < m_nColumns; col++)
-  {
-    //  Row by row, bottom to top
-    for(row = m_nRows - 1; row >= 0; row--)
-    {
-      nColor = m_arrBoard[row][col];
-      //  Once we hit background, this column is done
-      if(nColor == 0)
-        break;
-      else
-      {
-        //  Check above and right
-        if(row - 1 >= 0 && m_arrBoard[row - 1][col] == nColor)
-          return false;
-        else if(col + 1 < m_nColumns && m_arrBoard[row][col + 1] == nColor)
-          return false;
-      }
-    }
-  }
-  
-	//  No two adjacent block found
-  return true;
+  return SAGA_BoardIsGameOver(&m_Board);
+}
+
+//*==============================================================================*/
+/*  SAGA_IsGameLost                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Is the game lost?
+ *
+ * \details   Check if the board could never be cleared any more, e.g. because
+ * \n         a color has a single block left. This is often known long
+ * \n         before the game is over.
+ *
+ * \param     none
+ *
+ * \return    true or false
+ */
+/*===============================================================================*/
+bool SAGA_IsGameLost(void)
+{
+  return ANA_IsDead(&m_Board);
 }
 
 //*==============================================================================*/
@@ -312,6 +409,7 @@ bool SAGA_IsGameOver(void)
  * \brief     Delete blocks if possible
  *
  * \details   Function to delete all adjacent blocks with the same color. 
+ * \n         Every move is recorded, so it could be taken back later.
  *
  * \param     row, column
  *
@@ -320,84 +418,25 @@ bool SAGA_IsGameOver(void)
 /*===============================================================================*/
 int SAGA_DeleteBlocks(int row, int col)
 {
-  //  Make sure that the row and column are valid
-  if(row < 0 || row >= m_nRows || col < 0 || col >= m_nColumns)
-    return -1;
-  
-  int nColor = m_arrBoard[row][col];
-
-	//  Can't delete background blocks
-  if(nColor == 0)
-    return -1;
-  
-	//	First check if there are any of the adjacent sides with the same color 
-  int nCount = -1;
-  if((row - 1 >= 0 && m_arrBoard[row - 1][col] == nColor) ||
-     (row + 1 < m_nRows && m_arrBoard[row + 1][col] == nColor) ||
-     (col - 1 >= 0 && m_arrBoard[row][col - 1] == nColor) ||
-     (col + 1 < m_nColumns && m_arrBoard[row][col + 1] == nColor))
-  {
-    //	Then call the recursive function to eliminate all
-    //  other touching blocks with same color
-    m_arrBoard[row][col] = 0;
-    nCount = 1;
-    //	Recursive call for up
-    nCount += SAGA_DeleteNeighborBlocks(row - 1, col, nColor, DIRECTION_DOWN);
-    //	Recursive call for down
-    nCount += SAGA_DeleteNeighborBlocks(row + 1,col, nColor, DIRECTION_UP);
-    //	Recursive call for left
-    nCount += SAGA_DeleteNeighborBlocks(row, col - 1, nColor, DIRECTION_RIGHT);
-    //	Recursive call for right
-    nCount += SAGA_DeleteNeighborBlocks(row, col + 1, nColor, DIRECTION_LEFT);
-    //	Finally compact the board
-    SAGA_CompactBoard();
-    //  Remove the count from the number remaining
-    m_nRemaining -= nCount;
-  }
-  //  Return the total number of pieces deleted
-  return nCount;
+  return SAGA_BoardMakeMove(&m_Board, row, col, &m_Journal);
 }
 
 //*==============================================================================*/
 /*  SAGA_DeleteNeighborBlocks                                                    */
 /*-------------------------------------------------------------------------------*/
 /*!
- * \brief     Rekursivly deleting blocks
+ * \brief     Deleting a group of blocks
  *
- * \details   Rekursive helpfunction for deleting adjacent blocks with same color. 
+ * \details   Helpfunction for deleting adjacent blocks with same color. 
  *
- * \param     row, column, direction to look for
+ * \param     row, column, color, pRemoved --> list of deleted blocks or NULL
  *
  * \return    nCount --> number of deleted pieces
  */
 /*===============================================================================*/
-int SAGA_DeleteNeighborBlocks(int row, int col, int color, enum Direction direction)
+int SAGA_DeleteNeighborBlocks(int row, int col, int color, SAGA_Cell *pRemoved)
 {
-  //  Check if it is on the board
-  if(row < 0 || row >= m_nRows || col < 0 || col >= m_nColumns)
-    return 0;
-  
-	//  Check if it has the same color
-  if(m_arrBoard[row][col] != color)
-    return 0;
-  
-	int nCount = 1;
-  m_arrBoard[row][col] = 0;
-  //  If we weren't told to not go back up, check up
-  if(direction != DIRECTION_UP)
-    nCount += SAGA_DeleteNeighborBlocks(row - 1, col, color, DIRECTION_DOWN);
-  //  If we weren't told to not go back down, check down
-  if(direction != DIRECTION_DOWN)
-    nCount += SAGA_DeleteNeighborBlocks(row + 1, col, color, DIRECTION_UP);
-  //  If we weren't told to not go back left, check left
-  if(direction != DIRECTION_LEFT)
-    nCount += SAGA_DeleteNeighborBlocks(row, col - 1, color, DIRECTION_RIGHT);
-  //  If we weren't told to not go back right, check right
-  if(direction != DIRECTION_RIGHT)
-    nCount += SAGA_DeleteNeighborBlocks(row, col + 1, color, DIRECTION_LEFT);
-  
-	//  Return the total number of pieces deleted
-  return nCount;
+  return SAGA_BoardDeleteNeighborBlocks(&m_Board, row, col, color, pRemoved);
 }
 
 //*==============================================================================*/
@@ -415,58 +454,1857 @@ int SAGA_DeleteNeighborBlocks(int row, int col, int color, enum Direction direct
 /*===============================================================================*/
 void SAGA_CompactBoard(void)
 {
-  //  First move everything down
-  for(int col = 0; col < m_nColumns; col++)
-  {
-    int nNextEmptyRow = m_nRows - 1;
-    int nNextOccupiedRow = nNextEmptyRow;
-    while(nNextOccupiedRow >= 0 && nNextEmptyRow >= 0)
-    {
-      //  First find the next empty row
-      while(nNextEmptyRow >= 0 && m_arrBoard[nNextEmptyRow][col] != 0)
-        nNextEmptyRow--;
-      if(nNextEmptyRow >= 0)
-      {
-        //  Then find the next occupied row from the next empty row
-        nNextOccupiedRow = nNextEmptyRow - 1;
-        while(nNextOccupiedRow >= 0 && m_arrBoard[nNextOccupiedRow][col] == 0)
-          nNextOccupiedRow--;
-        if(nNextOccupiedRow >= 0)
-        {
-          //  Now move the block from occupied to empty
-          m_arrBoard[nNextEmptyRow][col] = m_arrBoard[nNextOccupiedRow][col];
-          m_arrBoard[nNextOccupiedRow][col] = 0;
-        }
-      }
-    }
-  }
-  //  Then move everything from right to left
-  int nNextEmptyCol = 0;
-  int nNextOccupiedCol = nNextEmptyCol;
-  while(nNextEmptyCol < m_nColumns && nNextOccupiedCol < m_nColumns)
-  {
-    //  First find the next empty column
-    while(nNextEmptyCol < m_nColumns && m_arrBoard[m_nRows - 1][nNextEmptyCol] != 0)
-      nNextEmptyCol++;
-    if(nNextEmptyCol < m_nColumns)
-    {
-      //  Then find the next column with something in it
-      nNextOccupiedCol = nNextEmptyCol + 1;
-      while(nNextOccupiedCol < m_nColumns && m_arrBoard[m_nRows - 1][nNextOccupiedCol] == 0)
-        nNextOccupiedCol++;
-      if(nNextOccupiedCol < m_nColumns)
-      {
-        //  Move entire column to the left
-        for(int row = 0; row < m_nRows; row++)
-        {
-          m_arrBoard[row][nNextEmptyCol] = m_arrBoard[row][nNextOccupiedCol];
-          m_arrBoard[row][nNextOccupiedCol] = 0;
-        }
-      }
-    }
-  }
+  SAGA_BoardCompact(&m_Board);
 }
 
-//----------------------------------- END --------------------------------------
+//*==============================================================================*/
+/*  SAGA_EnumerateMoves                                                          */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Find all deletable groups
+ *
+ * \details   List all groups which could be deleted without changing the
+ * \n         board, e.g. for hints or to highlight a group before the tap.
+ *
+ * \param     pGroups --> output, nMaxGroups --> size of pGroups
+ *
+ * \return    number of groups
+ */
+/*===============================================================================*/
+int SAGA_EnumerateMoves(SAGA_Group *pGroups, int nMaxGroups)
+{
+  return SAGA_BoardEnumerateMoves(&m_Board, pGroups, nMaxGroups, NULL);
+}
+
+//*==============================================================================*/
+/*  SAGA_UndoMove                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Take back the last move
+ *
+ * \details   Restore the board as it was before the last deletion.
+ *
+ * \param     none
+ *
+ * \return    number of restored blocks, 0 if there is nothing to undo
+ */
+/*===============================================================================*/
+int SAGA_UndoMove(void)
+{
+  return SAGA_BoardUnmakeMove(&m_Board, &m_Journal);
+}
+
+//*==============================================================================*/
+/*  SAGA_GetHash                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the hash of the board
+ *
+ * \details   Returns the Zobrist hash of the current position.
+ *
+ * \param     none
+ *
+ * \return    64 bit hash
+ */
+/*===============================================================================*/
+uint64_t SAGA_GetHash(void)
+{
+  return SAGA_BoardGetHash(&m_Board);
+}
+
+//*==============================================================================*/
+/*  SAGA_GetBoard                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the board of the game
+ *
+ * \details   Read only access to the current position, e.g. for a search
+ * \n         which runs beside the game.
+ *
+ * \param     none
+ *
+ * \return    board context
+ */
+/*===============================================================================*/
+const SAGA_Board *SAGA_GetBoard(void)
+{
+  return &m_Board;
+}
+
+//*==============================================================================*/
+/*  SAGA_ResumeBoard                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Continue the game on a given position
+ *
+ * \details   The position, e.g. of a saved game, replaces the board of the
+ * \n         game. It must have the size and the colors of the game, its
+ * \n         moves can't be taken back. The random stream of the game goes
+ * \n         on, so the next games are still new ones.
+ *
+ * \param     pBoard --> position
+ *
+ * \return    false if the position doesn't fit the game
+ */
+/*===============================================================================*/
+bool SAGA_ResumeBoard(const SAGA_Board *pBoard)
+{
+  uint32_t arrRandom[4];
+
+  if(pBoard->nColumns != m_Board.nColumns || pBoard->nRows != m_Board.nRows ||
+     pBoard->nColors != m_Board.nColors)
+    return false;
+  memcpy(arrRandom, m_Board.arrRandom, sizeof(arrRandom));
+  SAGA_BoardCopy(&m_Board, pBoard);
+  memcpy(m_Board.arrRandom, arrRandom, sizeof(arrRandom));
+  SAGA_JournalClear(&m_Journal);
+  return true;
+}
+
+//*==============================================================================*/
+/*  SAGA_RedoMove                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Play the last undone move again
+ *
+ * \details   Repeat the move taken back by the last undo.
+ *
+ * \param     none
+ *
+ * \return    number of deleted blocks, 0 if there is nothing to redo
+ */
+/*===============================================================================*/
+int SAGA_RedoMove(void)
+{
+  return SAGA_BoardRedoMove(&m_Board, &m_Journal);
+}
+
+//*==============================================================================*/
+/*  SAGA_GetMoveEvents                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Changes of the last move
+ *
+ * \details   List what the last move or redo did to the board, so only the
+ * \n         changed blocks have to be drawn again.
+ *
+ * \param     pEvents --> list for at least SAGA_MAXEVENTS events
+ *
+ * \return    number of events, 0 if no move was made
+ */
+/*===============================================================================*/
+int SAGA_GetMoveEvents(SAGA_Event *pEvents)
+{
+  return SAGA_BoardGetMoveEvents(&m_Board, &m_Journal, pEvents);
+}
+
+/*-------------------------------------------------------------------------------*/
+/*  Board context functions                                                      */
+/*-------------------------------------------------------------------------------*/
+
+//*==============================================================================*/
+/*  SAGA_Mix                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Mix 64 bits
+ *
+ * \details   The splitmix64 finalizer, every input bit changes about half of
+ * \n         the output bits.
+ *
+ * \param     z --> value
+ *
+ * \return    mixed value
+ */
+/*===============================================================================*/
+static inline uint64_t SAGA_Mix(uint64_t z)
+{
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
 
+//*==============================================================================*/
+/*  SAGA_PlaceKey                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Zobrist key of a block position
+ *
+ * \details   The key of a position is mixed from its index, so there is no
+ * \n         table to set up and every board and thread gets the same keys.
+ * \n         It is the same for every color, each color has its own hash.
+ *
+ * \param     col, h --> height in the column
+ *
+ * \return    64 bit key
+ */
+/*===============================================================================*/
+static inline uint64_t SAGA_PlaceKey(int col, int h)
+{
+  return SAGA_Mix((uint64_t)(col * SAGA_MAXROWS + h + 1) * 0x9E3779B97F4A7C15ull);
+}
 
+//*==============================================================================*/
+/*  SAGA_CombineHashes                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Hash of a board from the hashes of its colors
+ *
+ * \details   Every color hash is mixed together with its color, so the hash
+ * \n         tells the colors apart. An empty board has the hash 0.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    64 bit hash
+ */
+/*===============================================================================*/
+static inline uint64_t SAGA_CombineHashes(const SAGA_Board *pBoard)
+{
+  uint64_t nHash = 0;
+  int i;
+  
+  for(i = 1; i <= pBoard->nColors; i++)
+    if(pBoard->arrColorHashes[i] != 0)
+      nHash ^= SAGA_Mix(pBoard->arrColorHashes[i] + i * 0xD1B54A32D192ED03ull);
+  return nHash;
+}
+
+//*==============================================================================*/
+/*  SAGA_ScanColors                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Count and hash the blocks of each color from scratch
+ *
+ * \details   The counts and color hashes of the board must always be equal
+ * \n         to this.
+ *
+ * \param     pBoard --> board context, pCounts --> SAGA_MAXCOLORS + 1 counts,
+ * \n         pHashes --> SAGA_MAXCOLORS + 1 hashes
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void SAGA_ScanColors(const SAGA_Board *pBoard, unsigned short *pCounts, uint64_t *pHashes)
+{
+  const unsigned char *pColumn;
+  int col, h;
+  
+  memset(pCounts, 0, (SAGA_MAXCOLORS + 1) * sizeof(unsigned short));
+  memset(pHashes, 0, (SAGA_MAXCOLORS + 1) * sizeof(uint64_t));
+  for(col = 0; col < pBoard->nUsedColumns; col++)
+  {
+    pColumn = &pBoard->arrCells[col * pBoard->nRows];
+    for(h = 0; h < pBoard->arrHeights[col]; h++)
+    {
+      pCounts[pColumn[h]]++;
+      pHashes[pColumn[h]] ^= SAGA_PlaceKey(col, h);
+    }
+  }
+}
+
+#ifdef SAGA_DEBUG
+static void SAGA_BoardCheck(const SAGA_Board *pBoard);
+#endif
+
+//  Kernels of the common board heights, 7 rows for 10x7 and 10 rows for
+//  15x10 and 20x10, and the generic ones for every other height
+#define KERN_ROWS        7
+#define KERN_NAME(name)  SAGA_##name##7
+#define KERN_WORDS       1
+#include "sagakernel.h"
+
+#define KERN_ROWS        10
+#define KERN_NAME(name)  SAGA_##name##10
+#define KERN_WORDS       2
+#include "sagakernel.h"
+
+#define KERN_ROWS        (pBoard)->nRows
+#define KERN_NAME(name)  SAGA_##name##Generic
+#include "sagakernel.h"
+
+static const SAGA_Kernels m_arrKernels[] =
+{
+  { 0, SAGA_CountPairsGeneric, SAGA_DeleteNeighborBlocksGeneric, SAGA_CompactGeneric },
+  { 7, SAGA_CountPairs7, SAGA_DeleteNeighborBlocks7, SAGA_Compact7 },
+  { 10, SAGA_CountPairs10, SAGA_DeleteNeighborBlocks10, SAGA_Compact10 },
+};
+
+//*==============================================================================*/
+/*  SAGA_CountPairs                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Count touching blocks with the same color
+ *
+ * \details   Count the same colored pairs inside the columns nFirst .. nLast
+ * \n         and between these columns and their left and right neighbors
+ * \n         with the kernel of the board.
+ *
+ * \param     pBoard --> board context, nFirst, nLast --> column range
+ *
+ * \return    number of pairs
+ */
+/*===============================================================================*/
+static int SAGA_CountPairs(const SAGA_Board *pBoard, int nFirst, int nLast)
+{
+  return m_arrKernels[pBoard->nKernel].pCountPairs(pBoard, nFirst, nLast);
+}
+
+#ifdef SAGA_DEBUG
+//*==============================================================================*/
+/*  SAGA_BoardCheck                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Verify the incremental board state
+ *
+ * \details   Recompute everything which is updated incrementally from scratch
+ * \n         and assert that it matches, only used in debug builds.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void SAGA_BoardCheck(const SAGA_Board *pBoard)
+{
+  unsigned short arrCounts[SAGA_MAXCOLORS + 1];
+  uint64_t arrHashes[SAGA_MAXCOLORS + 1];
+  
+  assert(pBoard->nPairs == SAGA_CountPairsGeneric(pBoard, 0, pBoard->nUsedColumns - 1));
+  SAGA_ScanColors(pBoard, arrCounts, arrHashes);
+  assert(memcmp(pBoard->arrColorCounts, arrCounts, sizeof(arrCounts)) == 0);
+  assert(memcmp(pBoard->arrColorHashes, arrHashes, sizeof(arrHashes)) == 0);
+  assert(pBoard->nHash == SAGA_CombineHashes(pBoard));
+}
+#endif
+
+//*==============================================================================*/
+/*  SAGA_BoardIsValidSize                                                        */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Does a board size fit into the board storage?
+ *
+ * \details   Columns and rows each have their limit, and all blocks of the
+ * \n         board must fit into arrCells. The colors must fit into the
+ * \n         color list.
+ *
+ * \param     nColumns, nRows, nColors
+ *
+ * \return    true or false
+ */
+/*===============================================================================*/
+bool SAGA_BoardIsValidSize(int nColumns, int nRows, int nColors)
+{
+  return nColumns >= 1 && nColumns <= SAGA_MAXCOLUMNS && nRows >= 1 && nRows <= SAGA_MAXROWS &&
+         nColumns * nRows <= SAGA_MAXCELLS && nColors >= 1 && nColors <= SAGA_MAXCOLORS;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardInit                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Initialize a board context
+ *
+ * \details   Set the size and the number of colors of a board and clear it.
+ * \n         The kernels for the board height are chosen once in here.
+ * \n         Every board is independent of all others, so any number of
+ * \n         boards could be used concurrently, e.g. one per thread.
+ * \n         A size which doesn't fit, see SAGA_BoardIsValidSize, is
+ * \n         clamped to the limits, so the block array is never overrun.
+ *
+ * \param     pBoard --> board context, nColumns, nRows, nColors
+ *
+ * \return    false if the size had to be clamped
+ */
+/*===============================================================================*/
+bool SAGA_BoardInit(SAGA_Board *pBoard, int nColumns, int nRows, int nColors)
+{
+  bool bValid = SAGA_BoardIsValidSize(nColumns, nRows, nColors);
+  
+  if(!bValid)
+  {
+    nColumns = nColumns < 1 ? 1 : nColumns > SAGA_MAXCOLUMNS ? SAGA_MAXCOLUMNS : nColumns;
+    nRows = nRows < 1 ? 1 : nRows > SAGA_MAXROWS ? SAGA_MAXROWS : nRows;
+    if(nColumns * nRows > SAGA_MAXCELLS)
+      nRows = SAGA_MAXCELLS / nColumns;
+    nColors = nColors < 1 ? 1 : nColors > SAGA_MAXCOLORS ? SAGA_MAXCOLORS : nColors;
+  }
+  pBoard->nColumns = nColumns;
+  pBoard->nRows = nRows;
+  pBoard->nColors = nColors;
+  for(pBoard->nKernel = SAGA_KERNELS - 1; pBoard->nKernel > 0; pBoard->nKernel--)
+    if(m_arrKernels[pBoard->nKernel].nRows == nRows)
+      break;
+  SAGA_BoardSeed(pBoard, 0);
+  SAGA_BoardClear(pBoard);
+  return bValid;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardClear                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Clear a board
+ *
+ * \details   Set each square of the board to be empty.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_BoardClear(SAGA_Board *pBoard)
+{
+  memset(pBoard->arrHeights, 0, sizeof(pBoard->arrHeights));
+  memset(pBoard->arrCells, 0, sizeof(pBoard->arrCells));
+  memset(pBoard->arrColorCounts, 0, sizeof(pBoard->arrColorCounts));
+  memset(pBoard->arrColorHashes, 0, sizeof(pBoard->arrColorHashes));
+  pBoard->nUsedColumns = 0;
+  pBoard->nDirtyColumns = 0;
+  pBoard->nRemaining = 0;
+  pBoard->nPairs = 0;
+  pBoard->nHash = 0;
+  pBoard->nScore = 0;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardSetup                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Randomly setup a board
+ *
+ * \details   Clear the board and fill it up with random colors, taken from
+ * \n         the own random generator of the board.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_BoardSetup(SAGA_Board *pBoard)
+{
+  unsigned char *pCells = pBoard->arrCells;
+  int h, col;
+  
+  //  Start from an empty board
+  SAGA_BoardClear(pBoard);
+  
+  //  Randomly set each square to a color, row by row from the top like
+  //  before. The color is taken from the high bits by a multiplication,
+  //  no division and the same result everywhere
+  for(h = pBoard->nRows - 1; h >= 0; h--)
+    for(col = 0; col < pBoard->nColumns; col++)
+      pCells[col * pBoard->nRows + h] =
+        (((uint64_t)SAGA_BoardRandom(pBoard) * pBoard->nColors) >> 32) + 1;
+  
+  //  Every column is full
+  memset(pBoard->arrHeights, pBoard->nRows, pBoard->nColumns);
+  pBoard->nUsedColumns = pBoard->nColumns;
+  SAGA_BoardRefresh(pBoard);
+  
+  //  Set the number of spaces remaining
+  pBoard->nRemaining = pBoard->nRows * pBoard->nColumns;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardSeed                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Seed the random generator of a board
+ *
+ * \details   The 128 bit state of xoshiro128** is filled by splitmix64 from
+ * \n         the 64 bit seed, which never gives an all zero state.
+ *
+ * \param     pBoard --> board context, nSeed --> seed
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_BoardSeed(SAGA_Board *pBoard, uint64_t nSeed)
+{
+  uint64_t z;
+  int i;
+  
+  for(i = 0; i < 4; i += 2)
+  {
+    z = (nSeed += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    pBoard->arrRandom[i] = (uint32_t)z;
+    pBoard->arrRandom[i + 1] = (uint32_t)(z >> 32);
+  }
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardRandom                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Next random number of a board
+ *
+ * \details   Advances the own generator of the board, see SAGA_Random.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    32 bit random number
+ */
+/*===============================================================================*/
+uint32_t SAGA_BoardRandom(SAGA_Board *pBoard)
+{
+  return SAGA_Random(pBoard->arrRandom);
+}
+
+//*==============================================================================*/
+/*  SAGA_Random                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Next random number of a generator state
+ *
+ * \details   xoshiro128**, only 32 bit operations, so it is fast on the ARM11
+ * \n         and gives the same numbers on every platform. Code which keeps
+ * \n         the state of a board somewhere else, e.g. in a batch, gets the
+ * \n         same stream as the board.
+ *
+ * \param     s --> state of 4 words, as arrRandom of a board
+ *
+ * \return    32 bit random number
+ */
+/*===============================================================================*/
+uint32_t SAGA_Random(uint32_t *s)
+{
+  uint32_t nResult = s[1] * 5;
+  uint32_t t = s[1] << 9;
+  
+  nResult = (nResult << 7 | nResult >> 25) * 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = s[3] << 11 | s[3] >> 21;
+  return nResult;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardSetupGame                                                          */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Setup a numbered game
+ *
+ * \details   Seed the board with the game number and fill it, so the same
+ * \n         number always gives the same board. Numbers with
+ * \n         SAGA_CLEARABLEGAME set are built by SAGA_BoardSetupClearableGame.
+ *
+ * \param     pBoard --> board context, nGame --> game number
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_BoardSetupGame(SAGA_Board *pBoard, uint64_t nGame)
+{
+  if(nGame & SAGA_CLEARABLEGAME)
+  {
+    SAGA_BoardSetupClearableGame(pBoard, nGame, NULL);
+    return;
+  }
+  SAGA_BoardSeed(pBoard, nGame);
+  SAGA_BoardSetup(pBoard);
+  pBoard->nGame = nGame;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardSetupClearableGame                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Setup a numbered game which could be cleared
+ *
+ * \details   Seed the board with the game number and build it backwards
+ * \n         with SAGA_BoardSetupClearable. The number is stored with
+ * \n         SAGA_CLEARABLEGAME set, so SAGA_BoardSetupGame gives the same
+ * \n         board from it.
+ *
+ * \param     pBoard --> board context, nGame --> game number,
+ * \n         pSolution --> taps which clear the board or NULL
+ *
+ * \return    number of moves of the solution, -1 if it's a random board
+ */
+/*===============================================================================*/
+int SAGA_BoardSetupClearableGame(SAGA_Board *pBoard, uint64_t nGame, SAGA_Cell *pSolution)
+{
+  int nMoves;
+  
+  nGame |= SAGA_CLEARABLEGAME;
+  SAGA_BoardSeed(pBoard, nGame);
+  nMoves = SAGA_BoardSetupClearable(pBoard, pSolution);
+  pBoard->nGame = nGame;
+  return nMoves;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardGenerate                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Setup many numbered games
+ *
+ * \details   Board i gets game number nFirstGame + i, e.g. for analysis
+ * \n         runs or puzzle packs. Each board owns its generator, so ranges
+ * \n         could be filled by several threads at the same time.
+ *
+ * \param     pBoards --> array of boards, nBoards --> number of boards,
+ * \n         nColumns, nRows, nColors --> size of each board,
+ * \n         nFirstGame --> game number of the first board
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_BoardGenerate(SAGA_Board *pBoards, int nBoards, int nColumns, int nRows, int nColors,
+                        uint64_t nFirstGame)
+{
+  int i;
+  
+  for(i = 0; i < nBoards; i++)
+  {
+    SAGA_BoardInit(&pBoards[i], nColumns, nRows, nColors);
+    SAGA_BoardSetupGame(&pBoards[i], nFirstGame + i);
+  }
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardRefresh                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Recompute the derived board state
+ *
+ * \details   Count the pairs and the colors and hash the board from scratch.
+ * \n         Needed after the blocks and heights were written directly, e.g.
+ * \n         by a setup or a conversion from another engine.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_BoardRefresh(SAGA_Board *pBoard)
+{
+  pBoard->nPairs = SAGA_CountPairs(pBoard, 0, pBoard->nUsedColumns - 1);
+  SAGA_ScanColors(pBoard, pBoard->arrColorCounts, pBoard->arrColorHashes);
+  pBoard->nHash = SAGA_CombineHashes(pBoard);
+  SAGA_CHECK(pBoard);
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardCopy                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Copy a board
+ *
+ * \details   Copy the complete state of one board into another one. Only the
+ * \n         used part of the block array is copied.
+ *
+ * \param     pDest --> destination board, pSrc --> source board
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_BoardCopy(SAGA_Board *pDest, const SAGA_Board *pSrc)
+{
+  int nCells = pSrc->nRows * pSrc->nColumns;
+  
+  if(pDest == pSrc)
+    return;
+  memcpy(pDest, pSrc, offsetof(SAGA_Board, arrCells) + nCells);
+  memset(pDest->arrCells + nCells, 0, SAGA_MAXCELLS - nCells);
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardClone                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Clone a board
+ *
+ * \details   Allocate a new board and copy the state of the source board into
+ * \n         it. The clone has to be released with SAGA_BoardFree.
+ *
+ * \param     pSrc --> source board
+ *
+ * \return    new board or NULL if there is no memory left
+ */
+/*===============================================================================*/
+SAGA_Board *SAGA_BoardClone(const SAGA_Board *pSrc)
+{
+  SAGA_Board *pBoard = (SAGA_Board*) malloc(sizeof(SAGA_Board));
+  
+  if(pBoard)
+    SAGA_BoardCopy(pBoard, pSrc);
+  return pBoard;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardFree                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Release a cloned board
+ *
+ * \details   Free the memory of a board created by SAGA_BoardClone.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_BoardFree(SAGA_Board *pBoard)
+{
+  free(pBoard);
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardGetBlock                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the color index of specific block
+ *
+ * \details   Returns the color index of a block, 0 is background and
+ * \n         1 .. nColors are the block colors.
+ *
+ * \param     pBoard --> board context, row, column
+ *
+ * \return    color index
+ */
+/*===============================================================================*/
+int SAGA_BoardGetBlock(const SAGA_Board *pBoard, int row, int col)
+{
+  //  Check the bounds of the array
+  if(row < 0 || row >= pBoard->nRows || col < 0 || col >= pBoard->nColumns)
+    return 0;
+  return SAGA_CELL(pBoard, row, col);
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardGetBlockColor                                                      */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the color of specific block
+ *
+ * \details   Returns the color character of a specified block of the board.
+ *
+ * \param     pBoard --> board context, row, column
+ *
+ * \return    color
+ */
+/*===============================================================================*/
+char SAGA_BoardGetBlockColor(const SAGA_Board *pBoard, int row, int col)
+{
+  return m_arrColors[SAGA_BoardGetBlock(pBoard, row, col)];
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardIsGameOver                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Is the game over?
+ *
+ * \details   Check if there are still touching blocks with the same color.
+ * \n         The pairs are counted incrementally, so this is O(1).
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    true or false
+ */
+/*===============================================================================*/
+bool SAGA_BoardIsGameOver(const SAGA_Board *pBoard)
+{
+  //  The number of touching pairs is kept up to date by every deletion
+  return pBoard->nPairs == 0;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardGetHash                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the hash of a board
+ *
+ * \details   The Zobrist hashes of the colors are kept up to date by every
+ * \n         change and combined after it, so the hash could key a position
+ * \n         in a table without looking at the blocks.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    64 bit hash
+ */
+/*===============================================================================*/
+uint64_t SAGA_BoardGetHash(const SAGA_Board *pBoard)
+{
+  return pBoard->nHash;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardGetCanonicalHash                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the hash of a board that ignores the color names
+ *
+ * \details   Boards which only differ by renaming the colors have the same
+ * \n         moves and scores. The color hashes are mixed without their
+ * \n         colors and added up, so all of these boards get the same hash,
+ * \n         in O(colors) from the incremental color hashes.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    64 bit hash, 0 for an empty board
+ */
+/*===============================================================================*/
+uint64_t SAGA_BoardGetCanonicalHash(const SAGA_Board *pBoard)
+{
+  return SAGA_GetCanonicalHash(pBoard->arrColorHashes, pBoard->nColors);
+}
+
+//*==============================================================================*/
+/*  SAGA_GetCanonicalHash                                                        */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the canonical hash from the hashes of the colors
+ *
+ * \details   For other board representations, e.g. the bitboard, which
+ * \n         build the color hashes from SAGA_GetPlaceKey themselves and
+ * \n         need hashes equal to the ones of a board context.
+ *
+ * \param     pColorHashes --> hashes of the colors 1 .. nColors, nColors
+ *
+ * \return    64 bit hash, 0 for an empty board
+ */
+/*===============================================================================*/
+uint64_t SAGA_GetCanonicalHash(const uint64_t *pColorHashes, int nColors)
+{
+  uint64_t nHash = 0;
+  int i;
+
+  for(i = 1; i <= nColors; i++)
+    if(pColorHashes[i] != 0)
+      nHash += SAGA_Mix(pColorHashes[i] ^ 0x8CB92BA72F3D8DD7ull);
+  return nHash;
+}
+
+//*==============================================================================*/
+/*  SAGA_GetPlaceKey                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get the Zobrist key of a block position
+ *
+ * \details   The hash of a color is the XOR of the keys of its blocks.
+ *
+ * \param     col, h --> height in the column
+ *
+ * \return    64 bit key
+ */
+/*===============================================================================*/
+uint64_t SAGA_GetPlaceKey(int col, int h)
+{
+  return SAGA_PlaceKey(col, h);
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardCanonicalize                                                       */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Rename the colors of a board in the order they are found
+ *
+ * \details   The columns are read from the left and each one from the
+ * \n         bottom, the first color found becomes color 1, the next new
+ * \n         one color 2 and so on. Every board of a renaming class turns
+ * \n         into the same board, the canonical hash does not change.
+ *
+ * \param     pBoard --> board context, pMap --> SAGA_MAXCOLORS + 1 new
+ * \n         colors of the old colors, 0 for unused ones, or NULL
+ *
+ * \return    number of colors on the board
+ */
+/*===============================================================================*/
+int SAGA_BoardCanonicalize(SAGA_Board *pBoard, unsigned char *pMap)
+{
+  unsigned char arrMap[SAGA_MAXCOLORS + 1] = { 0 };
+  unsigned short arrCounts[SAGA_MAXCOLORS + 1] = { 0 };
+  uint64_t arrHashes[SAGA_MAXCOLORS + 1] = { 0 };
+  unsigned char *pColumn;
+  int nColors = 0, col, h, i;
+
+  for(col = 0; col < pBoard->nUsedColumns; col++)
+  {
+    pColumn = &pBoard->arrCells[col * pBoard->nRows];
+    for(h = 0; h < pBoard->arrHeights[col]; h++)
+    {
+      if(arrMap[pColumn[h]] == 0)
+        arrMap[pColumn[h]] = ++nColors;
+      pColumn[h] = arrMap[pColumn[h]];
+    }
+  }
+
+  //  Counts and hashes move with their colors
+  for(i = 1; i <= SAGA_MAXCOLORS; i++)
+    if(arrMap[i] != 0)
+    {
+      arrCounts[arrMap[i]] = pBoard->arrColorCounts[i];
+      arrHashes[arrMap[i]] = pBoard->arrColorHashes[i];
+    }
+  memcpy(pBoard->arrColorCounts, arrCounts, sizeof(arrCounts));
+  memcpy(pBoard->arrColorHashes, arrHashes, sizeof(arrHashes));
+  pBoard->nHash = SAGA_CombineHashes(pBoard);
+  if(pMap != NULL)
+    memcpy(pMap, arrMap, sizeof(arrMap));
+  SAGA_CHECK(pBoard);
+  return nColors;
+}
+
+//*==============================================================================*/
+/*  SAGA_FindRoot                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Find the representative of a block
+ *
+ * \details   Union find lookup with path halving.
+ *
+ * \param     pParent --> parent of each block, cell --> block index
+ *
+ * \return    block index of the representative
+ */
+/*===============================================================================*/
+static inline int SAGA_FindRoot(unsigned char *pParent, int cell)
+{
+  while(pParent[cell] != cell)
+  {
+    pParent[cell] = pParent[pParent[cell]];
+    cell = pParent[cell];
+  }
+  return cell;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardEnumerateMoves                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Find all deletable groups
+ *
+ * \details   Label all connected groups of the same color in one scan over
+ * \n         the columns with a union find, nothing on the board changes.
+ * \n         Each group with at least two blocks is written to pGroups with
+ * \n         its lowest, leftmost block as representative. If pLabels is
+ * \n         given, it gets the group index of every block in the layout of
+ * \n         arrCells, SAGA_NOGROUP for single blocks and background.
+ *
+ * \param     pBoard --> board context, pGroups --> output, 
+ * \n         nMaxGroups --> size of pGroups, pLabels --> output or NULL
+ *
+ * \return    number of groups written
+ */
+/*===============================================================================*/
+int SAGA_BoardEnumerateMoves(const SAGA_Board *pBoard, SAGA_Group *pGroups, int nMaxGroups,
+                             unsigned char *pLabels)
+{
+  unsigned char arrParent[SAGA_MAXCELLS];
+  unsigned short arrSize[SAGA_MAXCELLS];  // a full board of one color has SAGA_MAXCELLS
+  unsigned char arrIndex[SAGA_MAXCELLS];
+  const unsigned char *pCells = pBoard->arrCells;
+  int nRows = pBoard->nRows;
+  int col, h, cell, nRoot, nLeft, nGroups = 0;
+  
+  //  First pass, join every block with the block below and left of it
+  for(col = 0; col < pBoard->nUsedColumns; col++)
+  {
+    for(h = 0, cell = col * nRows; h < pBoard->arrHeights[col]; h++, cell++)
+    {
+      arrParent[cell] = cell;
+      arrSize[cell] = 0;
+      if(h > 0 && pCells[cell - 1] == pCells[cell])
+        arrParent[cell] = arrParent[cell - 1];
+      if(col > 0 && h < pBoard->arrHeights[col - 1] && pCells[cell - nRows] == pCells[cell])
+      {
+        nLeft = SAGA_FindRoot(arrParent, cell - nRows);
+        nRoot = SAGA_FindRoot(arrParent, arrParent[cell]);
+        //  Keep the lower index as root, so it's the lowest, leftmost block
+        if(nLeft < nRoot)
+          arrParent[nRoot] = nLeft;
+        else
+          arrParent[nLeft] = nRoot;
+      }
+    }
+  }
+  
+  //  Second pass, parents always have a lower index, so the parent of a block
+  //  is already flattened to its root and every block points to it directly
+  for(col = 0; col < pBoard->nUsedColumns; col++)
+  {
+    for(h = 0, cell = col * nRows; h < pBoard->arrHeights[col]; h++, cell++)
+    {
+      nRoot = arrParent[cell] = arrParent[arrParent[cell]];
+      arrSize[nRoot]++;
+    }
+  }
+  
+  //  Third pass, the root is the first block of its group in scan order,
+  //  so every group is numbered when its root is reached
+  for(col = 0; col < pBoard->nUsedColumns; col++)
+  {
+    for(h = 0, cell = col * nRows; h < pBoard->arrHeights[col]; h++, cell++)
+    {
+      nRoot = arrParent[cell];
+      if(nRoot == cell)
+      {
+        arrIndex[cell] = SAGA_NOGROUP;
+        if(arrSize[cell] >= 2 && nGroups < nMaxGroups)
+        {
+          pGroups[nGroups].row = nRows - 1 - h;
+          pGroups[nGroups].col = col;
+          pGroups[nGroups].size = arrSize[cell];
+          pGroups[nGroups].color = pCells[cell];
+          arrIndex[cell] = nGroups++;
+        }
+      }
+      if(pLabels)
+        pLabels[cell] = arrIndex[nRoot];
+    }
+  }
+  return nGroups;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardDeleteBlocks                                                       */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Delete blocks if possible
+ *
+ * \details   Function to delete all adjacent blocks with the same color. 
+ *
+ * \param     pBoard --> board context, row, column
+ *
+ * \return    nCount --> number of deleted pieces
+ */
+/*===============================================================================*/
+int SAGA_BoardDeleteBlocks(SAGA_Board *pBoard, int row, int col)
+{
+  return SAGA_BoardDeleteBlocksEx(pBoard, row, col, NULL);
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardDeleteBlocksEx                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Delete blocks if possible and report them
+ *
+ * \details   Function to delete all adjacent blocks with the same color. The
+ * \n         deleted blocks are written to pRemoved in board coordinates
+ * \n         before the board was compacted, so callers don't have to diff
+ * \n         the board. pRemoved needs room for rows x columns cells.
+ * \n         The points of the move are added to the score of the board.
+ *
+ * \param     pBoard --> board context, row, column, pRemoved --> list or NULL
+ *
+ * \return    nCount --> number of deleted pieces
+ */
+/*===============================================================================*/
+int SAGA_BoardDeleteBlocksEx(SAGA_Board *pBoard, int row, int col, SAGA_Cell *pRemoved)
+{
+  //  Make sure that the row and column are valid
+  if(row < 0 || row >= pBoard->nRows || col < 0 || col >= pBoard->nColumns)
+    return -1;
+  
+  int nColor = SAGA_CELL(pBoard, row, col);
+
+	//  Can't delete background blocks
+  if(nColor == 0)
+    return -1;
+  
+	//	First check if there are any of the adjacent sides with the same color 
+  int nCount = -1;
+  if((row - 1 >= 0 && SAGA_CELL(pBoard, row - 1, col) == nColor) ||
+     (row + 1 < pBoard->nRows && SAGA_CELL(pBoard, row + 1, col) == nColor) ||
+     (col - 1 >= 0 && SAGA_CELL(pBoard, row, col - 1) == nColor) ||
+     (col + 1 < pBoard->nColumns && SAGA_CELL(pBoard, row, col + 1) == nColor))
+  {
+    //	Then eliminate all touching blocks with same color
+    nCount = SAGA_BoardDeleteNeighborBlocks(pBoard, row, col, nColor, pRemoved);
+    //	Finally compact the board
+    SAGA_BoardCompact(pBoard);
+    //  Remove the count from the number remaining and score the move
+    pBoard->nRemaining -= nCount;
+    pBoard->nScore += SAGA_GetMoveScore(nCount);
+    if(pBoard->nRemaining == 0)
+      pBoard->nScore += SAGA_CLEARBONUS;
+  }
+  //  Return the total number of pieces deleted
+  return nCount;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardDeleteNeighborBlocks                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Deleting a group of blocks
+ *
+ * \details   Iterative flood fill for deleting adjacent blocks with same
+ * \n         color. Every block is marked when it is appended to the list
+ * \n         of removed blocks, so it is added only once and the list itself
+ * \n         is the work queue. The list never grows beyond rows x columns,
+ * \n         no recursion and no stack depending on the group size is used.
+ * \n         Marked neighbors are the pairs inside the group, which vanish
+ * \n         from the pair count. The touched columns are marked for
+ * \n         SAGA_BoardCompact and the deleted blocks leave the hash and
+ * \n         the count of their color.
+ * \n         Runs the kernel chosen for the board height.
+ *
+ * \param     pBoard --> board context, row, column, color,
+ * \n         pRemoved --> list of deleted blocks or NULL
+ *
+ * \return    nCount --> number of deleted pieces
+ */
+/*===============================================================================*/
+int SAGA_BoardDeleteNeighborBlocks(SAGA_Board *pBoard, int row, int col, int color,
+                                   SAGA_Cell *pRemoved)
+{
+  return m_arrKernels[pBoard->nKernel].pDeleteNeighborBlocks(pBoard, row, col, color, pRemoved);
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardCompact                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compact a gameboard
+ *
+ * \details   Function to compact the board after blocks are eliminated. Only
+ * \n         the columns touched by the last deletion are processed. Each
+ * \n         of them is compacted from its lowest hole upwards, a column
+ * \n         that got empty is removed with one block move of the columns
+ * \n         right of it. The pairs around the touched columns are counted
+ * \n         before and after, so the pair count stays up to date. The hash
+ * \n         follows every block which falls down or moves to the left, so
+ * \n         removing a column costs O(blocks right of it).
+ * \n         Runs the kernel chosen for the board height.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_BoardCompact(SAGA_Board *pBoard)
+{
+  m_arrKernels[pBoard->nKernel].pCompact(pBoard);
+}
+
+/*-------------------------------------------------------------------------------*/
+/*  Journal functions                                                            */
+/*-------------------------------------------------------------------------------*/
+
+//*==============================================================================*/
+/*  SAGA_JournalClear                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Clear a journal
+ *
+ * \details   Forget all recorded moves, needed for every new game.
+ *
+ * \param     pJournal --> journal
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SAGA_JournalClear(SAGA_Journal *pJournal)
+{
+  pJournal->nMoves = 0;
+  pJournal->nTop = 0;
+}
+
+//*==============================================================================*/
+/*  SAGA_JournalRecord                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Delete blocks and record the delta
+ *
+ * \details   Delete the group at row, col and store the removed blocks, the
+ * \n         collapsed columns and the old pair count as move nMoves of the
+ * \n         journal. The removed blocks are written straight into the
+ * \n         journal by the flood fill, nothing is copied. The redo part of
+ * \n         the journal is left alone.
+ *
+ * \param     pBoard --> board context, row, column, pJournal --> journal
+ *
+ * \return    nCount --> number of deleted pieces, -1 if no move
+ */
+/*===============================================================================*/
+static int SAGA_JournalRecord(SAGA_Board *pBoard, int row, int col, SAGA_Journal *pJournal)
+{
+  SAGA_JournalMove *pMove = &pJournal->arrMoves[pJournal->nMoves];
+  unsigned char arrHeights[SAGA_MAXCOLUMNS];
+  unsigned char arrCount[SAGA_MAXCOLUMNS] = { 0 };
+  SAGA_Cell *pCells;
+  int i, nPairs = pBoard->nPairs;
+  uint64_t nHash = pBoard->nHash;
+  uint64_t arrHashes[SAGA_MAXCOLORS + 1];
+  int nCount, nColor = SAGA_BoardGetBlock(pBoard, row, col);
+  
+  pMove->nFirst = 0;
+  if(pJournal->nMoves > 0)
+    pMove->nFirst = pMove[-1].nFirst + pMove[-1].nCount;
+  pCells = &pJournal->arrCells[pMove->nFirst];
+  
+  //  The heights before the move tell which columns collapse
+  memcpy(arrHeights, pBoard->arrHeights, pBoard->nUsedColumns);
+  memcpy(arrHashes, pBoard->arrColorHashes, sizeof(arrHashes));
+  nCount = SAGA_BoardDeleteBlocksEx(pBoard, row, col, pCells);
+  if(nCount < 0)
+    return nCount;
+  
+  pMove->nCount = nCount;
+  pMove->nColor = nColor;
+  pMove->nPairs = nPairs;
+  pMove->nHash = nHash;
+  memcpy(pMove->arrColorHashes, arrHashes, sizeof(arrHashes));
+  pMove->nCollapsed = 0;
+  for(i = 0; i < nCount; i++)
+  {
+    col = pCells[i].col;
+    if(++arrCount[col] == arrHeights[col])
+      pMove->nCollapsed |= 1u << col;
+  }
+  pJournal->nMoves++;
+  return nCount;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardMakeMove                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Delete blocks with undo
+ *
+ * \details   Same as SAGA_BoardDeleteBlocks, but a successful move is
+ * \n         recorded in the journal and replaces any moves which could be
+ * \n         redone. Search code could use make/unmake instead of copying
+ * \n         the board at every node.
+ *
+ * \param     pBoard --> board context, row, column, pJournal --> journal
+ *
+ * \return    nCount --> number of deleted pieces, -1 if no move
+ */
+/*===============================================================================*/
+int SAGA_BoardMakeMove(SAGA_Board *pBoard, int row, int col, SAGA_Journal *pJournal)
+{
+  int nCount = SAGA_JournalRecord(pBoard, row, col, pJournal);
+  
+  if(nCount > 0)
+    pJournal->nTop = pJournal->nMoves;
+  return nCount;
+}
+
+//*==============================================================================*/
+/*  SAGA_InsertColumn                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Insert an empty column
+ *
+ * \details   The columns from col on move one to the right. Only the
+ * \n         layout changes, pairs and hash are left to the caller.
+ *
+ * \param     pBoard --> board context, col --> index of the new column
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void SAGA_InsertColumn(SAGA_Board *pBoard, int col)
+{
+  int nRows = pBoard->nRows;
+  int nMove = pBoard->nUsedColumns - col;
+  unsigned char *pColumn = &pBoard->arrCells[col * nRows];
+  
+  memmove(pColumn + nRows, pColumn, nMove * nRows);
+  memmove(&pBoard->arrHeights[col + 1], &pBoard->arrHeights[col], nMove);
+  memset(pColumn, 0, nRows);
+  pBoard->arrHeights[col] = 0;
+  pBoard->nUsedColumns++;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardUnmakeMove                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Take back the last move
+ *
+ * \details   Replay the delta of the last move backwards. First the
+ * \n         collapsed columns are inserted again, in ascending order so
+ * \n         each index is right for the layout at that time. Then the
+ * \n         kept blocks of every touched column are lifted from the top
+ * \n         down to make room, and the removed blocks are put back into
+ * \n         their holes. Only the touched columns are visited, the cost
+ * \n         depends on the removed blocks and not on the board size.
+ *
+ * \param     pBoard --> board context, pJournal --> journal
+ *
+ * \return    number of restored blocks, 0 if there is nothing to undo
+ */
+/*===============================================================================*/
+int SAGA_BoardUnmakeMove(SAGA_Board *pBoard, SAGA_Journal *pJournal)
+{
+  unsigned short arrHoles[SAGA_MAXCOLUMNS];
+  int nRows = pBoard->nRows;
+  unsigned int nTouched = 0, nCollapsed;
+  unsigned char *pColumn;
+  const SAGA_Cell *pCells;
+  const SAGA_JournalMove *pMove;
+  int i, col, h, nRead;
+  
+  if(pJournal->nMoves == 0)
+    return 0;
+  pMove = &pJournal->arrMoves[--pJournal->nMoves];
+  pCells = &pJournal->arrCells[pMove->nFirst];
+  
+  //  Insert the collapsed columns again as empty columns
+  for(nCollapsed = pMove->nCollapsed; nCollapsed != 0; nCollapsed &= nCollapsed - 1)
+    SAGA_InsertColumn(pBoard, __builtin_ctz(nCollapsed));
+  
+  //  Collect the holes of every touched column
+  for(i = 0; i < pMove->nCount; i++)
+  {
+    col = pCells[i].col;
+    if(!(nTouched & (1u << col)))
+      arrHoles[col] = 0;
+    nTouched |= 1u << col;
+    arrHoles[col] |= 1u << (nRows - 1 - pCells[i].row);
+  }
+  
+  //  Lift the kept blocks above the holes, top down so nothing is overwritten
+  for(; nTouched != 0; nTouched &= nTouched - 1)
+  {
+    col = __builtin_ctz(nTouched);
+    pColumn = &pBoard->arrCells[col * nRows];
+    nRead = pBoard->arrHeights[col] - 1;
+    h = nRead + __builtin_popcount(arrHoles[col]);
+    pBoard->arrHeights[col] = h + 1;
+    for(; nRead >= 0 && h > nRead; h--)
+    {
+      if(!(arrHoles[col] & (1u << h)))
+        pColumn[h] = pColumn[nRead--];
+    }
+  }
+  
+  //  Finally put the removed blocks back
+  for(i = 0; i < pMove->nCount; i++)
+    SAGA_CELL(pBoard, pCells[i].row, pCells[i].col) = pMove->nColor;
+  
+  if(pBoard->nRemaining == 0)
+    pBoard->nScore -= SAGA_CLEARBONUS;
+  pBoard->nScore -= SAGA_GetMoveScore(pMove->nCount);
+  pBoard->nRemaining += pMove->nCount;
+  pBoard->arrColorCounts[pMove->nColor] += pMove->nCount;
+  pBoard->nPairs = pMove->nPairs;
+  pBoard->nHash = pMove->nHash;
+  memcpy(pBoard->arrColorHashes, pMove->arrColorHashes, sizeof(pBoard->arrColorHashes));
+  SAGA_CHECK(pBoard);
+  return pMove->nCount;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardRedoMove                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Play the last undone move again
+ *
+ * \details   The first removed block of a move is the tapped one, so the
+ * \n         move is played again from there. The flood fill finds the same
+ * \n         blocks in the same order and overwrites the old record, the
+ * \n         moves above it could still be redone.
+ *
+ * \param     pBoard --> board context, pJournal --> journal
+ *
+ * \return    number of deleted blocks, 0 if there is nothing to redo
+ */
+/*===============================================================================*/
+int SAGA_BoardRedoMove(SAGA_Board *pBoard, SAGA_Journal *pJournal)
+{
+  const SAGA_Cell *pTap;
+  
+  if(pJournal->nMoves >= pJournal->nTop)
+    return 0;
+  pTap = &pJournal->arrCells[pJournal->arrMoves[pJournal->nMoves].nFirst];
+  return SAGA_JournalRecord(pBoard, pTap->row, pTap->col, pJournal);
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardGetMoveEvents                                                      */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Changes of the last move
+ *
+ * \details   The journal record of the last move holds the removed blocks and
+ * \n         the columns which got empty, together with the board after
+ * \n         the move this is all that is needed to tell where every block
+ * \n         went. The events come in the order they could be applied to
+ * \n         the layout before the move: all removed blocks, then the
+ * \n         falling blocks of each column bottom up, then the columns
+ * \n         which slide to the left from left to right. Every event only
+ * \n         moves a block to a place that is already free. Only the
+ * \n         touched columns are scanned.
+ *
+ * \param     pBoard --> board context after the move, pJournal --> journal,
+ * \n         pEvents --> list for at least SAGA_MAXEVENTS events
+ *
+ * \return    number of events, 0 if no move was made
+ */
+/*===============================================================================*/
+int SAGA_BoardGetMoveEvents(const SAGA_Board *pBoard, const SAGA_Journal *pJournal,
+                            SAGA_Event *pEvents)
+{
+  const SAGA_JournalMove *pMove;
+  const SAGA_Cell *pCells;
+  unsigned int arrRemoved[SAGA_MAXCOLUMNS] = { 0 };
+  unsigned int nTouched = 0;
+  int nRows = pBoard->nRows;
+  int i, col, h, nHeight, nWrite, nShift, nUsed, nEvents = 0;
+  
+  if(pJournal->nMoves == 0)
+    return 0;
+  pMove = &pJournal->arrMoves[pJournal->nMoves - 1];
+  pCells = &pJournal->arrCells[pMove->nFirst];
+  
+  //  Removed blocks, in the order of the flood fill
+  for(i = 0; i < pMove->nCount; i++)
+  {
+    col = pCells[i].col;
+    arrRemoved[col] |= 1u << (nRows - 1 - pCells[i].row);
+    nTouched |= 1u << col;
+    pEvents[nEvents].type = SAGA_EVENT_REMOVE;
+    pEvents[nEvents].row = pEvents[nEvents].newRow = pCells[i].row;
+    pEvents[nEvents].col = pEvents[nEvents].newCol = col;
+    nEvents++;
+  }
+  
+  //  Blocks above the holes fall down, a column that got empty has none
+  for(nTouched &= ~pMove->nCollapsed; nTouched != 0; nTouched &= nTouched - 1)
+  {
+    col = __builtin_ctz(nTouched);
+    nShift = __builtin_popcount(pMove->nCollapsed & ((1u << col) - 1));
+    nHeight = pBoard->arrHeights[col - nShift] + __builtin_popcount(arrRemoved[col]);
+    for(nWrite = __builtin_ctz(arrRemoved[col]), h = nWrite + 1; h < nHeight; h++)
+    {
+      if(arrRemoved[col] & (1u << h))
+        continue;
+      pEvents[nEvents].type = SAGA_EVENT_FALL;
+      pEvents[nEvents].row = nRows - 1 - h;
+      pEvents[nEvents].newRow = nRows - 1 - nWrite++;
+      pEvents[nEvents].col = pEvents[nEvents].newCol = col;
+      nEvents++;
+    }
+  }
+  
+  //  The columns right of an empty one slide to the left
+  if(pMove->nCollapsed != 0)
+  {
+    nUsed = pBoard->nUsedColumns + __builtin_popcount(pMove->nCollapsed);
+    for(col = __builtin_ctz(pMove->nCollapsed) + 1, nShift = 1; col < nUsed; col++)
+    {
+      if(pMove->nCollapsed & (1u << col))
+      {
+        nShift++;
+        continue;
+      }
+      pEvents[nEvents].type = SAGA_EVENT_SHIFT;
+      pEvents[nEvents].row = pEvents[nEvents].newRow = 0;
+      pEvents[nEvents].col = col;
+      pEvents[nEvents++].newCol = col - nShift;
+    }
+  }
+  return nEvents;
+}
+
+/*-------------------------------------------------------------------------------*/
+/*  Generator functions                                                          */
+/*-------------------------------------------------------------------------------*/
+
+//*==============================================================================*/
+/*  SAGA_PeekBlock                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Get a block by column and height
+ *
+ * \details   Positions outside the used part of the board are background.
+ *
+ * \param     pBoard --> board context, col, h --> height in the column
+ *
+ * \return    color index, 0 for background
+ */
+/*===============================================================================*/
+static int SAGA_PeekBlock(const SAGA_Board *pBoard, int col, int h)
+{
+  if(col < 0 || col >= pBoard->nUsedColumns || h < 0 || h >= pBoard->arrHeights[col])
+    return 0;
+  return pBoard->arrCells[col * pBoard->nRows + h];
+}
+
+//*==============================================================================*/
+/*  SAGA_InsertBlocks                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Insert blocks into a column
+ *
+ * \details   The blocks from height h on are lifted by nCount, the gap gets
+ * \n         the color. This is the opposite of deleting them and letting
+ * \n         the column fall down.
+ *
+ * \param     pBoard --> board context, col, h --> height in the column,
+ * \n         nCount --> number of blocks, color --> color index
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void SAGA_InsertBlocks(SAGA_Board *pBoard, int col, int h, int nCount, int color)
+{
+  unsigned char *pColumn = &pBoard->arrCells[col * pBoard->nRows];
+  
+  memmove(pColumn + h + nCount, pColumn + h, pBoard->arrHeights[col] - h);
+  memset(pColumn + h, color, nCount);
+  pBoard->arrHeights[col] += nCount;
+  pBoard->nRemaining += nCount;
+}
+
+//*==============================================================================*/
+/*  SAGA_RemoveBlocks                                                            */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Remove blocks from a column
+ *
+ * \details   Opposite of SAGA_InsertBlocks, the blocks above fall down.
+ *
+ * \param     pBoard --> board context, col, h --> height in the column,
+ * \n         nCount --> number of blocks
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void SAGA_RemoveBlocks(SAGA_Board *pBoard, int col, int h, int nCount)
+{
+  unsigned char *pColumn = &pBoard->arrCells[col * pBoard->nRows];
+  int nHeight = pBoard->arrHeights[col];
+  
+  memmove(pColumn + h, pColumn + h + nCount, nHeight - h - nCount);
+  memset(pColumn + nHeight - nCount, 0, nCount);
+  pBoard->arrHeights[col] -= nCount;
+  pBoard->nRemaining -= nCount;
+  
+  //  An empty column is removed like after a move
+  if(pBoard->arrHeights[col] == 0)
+  {
+    memmove(pColumn, pColumn + pBoard->nRows, (pBoard->nUsedColumns - col - 1) * pBoard->nRows);
+    memmove(&pBoard->arrHeights[col], &pBoard->arrHeights[col + 1],
+            pBoard->nUsedColumns - col - 1);
+    pBoard->nUsedColumns--;
+    memset(&pBoard->arrCells[pBoard->nUsedColumns * pBoard->nRows], 0, pBoard->nRows);
+    pBoard->arrHeights[pBoard->nUsedColumns] = 0;
+  }
+}
+
+//*==============================================================================*/
+/*  SAGA_FindRoom                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Find columns with room for a group
+ *
+ * \details   Search nWidth neighbor columns, starting at a random place,
+ * \n         which could take a vertical bar (nWidth 1) or one block each
+ * \n         of a horizontal bar, without being left exactly one block
+ * \n         short. Such a single hole could only be filled by another bar.
+ *
+ * \param     pBoard --> board context, nStart --> random start,
+ * \n         nWidth --> number of columns
+ *
+ * \return    leftmost column, -1 if there is none
+ */
+/*===============================================================================*/
+static int SAGA_FindRoom(const SAGA_Board *pBoard, unsigned int nStart, int nWidth)
+{
+  int nPlaces = pBoard->nUsedColumns - nWidth + 1;
+  int i, col, nRoom;
+  
+  for(i = 0; i < nPlaces; i++)
+  {
+    for(col = (nStart + i) % nPlaces; col < (int)((nStart + i) % nPlaces) + nWidth; col++)
+    {
+      nRoom = pBoard->nRows - pBoard->arrHeights[col];
+      if(nWidth == 1 ? nRoom < 2 : nRoom == 0 || nRoom == 2)
+        break;
+    }
+    if(col == (int)((nStart + i) % nPlaces) + nWidth)
+      return col - nWidth;
+  }
+  return -1;
+}
+
+//*==============================================================================*/
+/*  SAGA_BlockedColors                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Colors next to an inserted group
+ *
+ * \details   Collect the colors of all blocks which would touch the group,
+ * \n         the group must not get any of them or it would grow when it is
+ * \n         deleted again. The block at h of a lifted column ends up just
+ * \n         above the group.
+ *
+ * \param     pBoard --> board context, nStep --> kind of group,
+ * \n         col, h --> lowest, leftmost block, nSize --> blocks or columns
+ *
+ * \return    bit mask of the colors, bit 0 is the background
+ */
+/*===============================================================================*/
+static unsigned int SAGA_BlockedColors(const SAGA_Board *pBoard, int nStep, int col, int h,
+                                       int nSize)
+{
+  unsigned int nBlocked = 0;
+  int i;
+  
+  if(nStep == SAGA_STEP_HORIZONTAL)
+  {
+    nBlocked = 1u << SAGA_PeekBlock(pBoard, col - 1, h) |
+               1u << SAGA_PeekBlock(pBoard, col + nSize, h);
+    for(i = col; i < col + nSize; i++)
+      nBlocked |= 1u << SAGA_PeekBlock(pBoard, i, h - 1) | 1u << SAGA_PeekBlock(pBoard, i, h);
+  }
+  else
+  {
+    //  The old column col of a new column moves to the right
+    if(nStep == SAGA_STEP_VERTICAL)
+      nBlocked = 1u << SAGA_PeekBlock(pBoard, col, h - 1) | 1u << SAGA_PeekBlock(pBoard, col, h);
+    for(i = h; i < h + nSize; i++)
+      nBlocked |= 1u << SAGA_PeekBlock(pBoard, col - 1, i) |
+                  1u << SAGA_PeekBlock(pBoard, nStep == SAGA_STEP_VERTICAL ? col + 1 : col, i);
+  }
+  return nBlocked;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardSetupClearable                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Setup a board which could be cleared
+ *
+ * \details   The game is played backwards, starting with an empty board.
+ * \n         Each step inserts a group, either a vertical bar into a column,
+ * \n         a horizontal bar across neighbor columns or a new column, and
+ * \n         gives it a color none of its neighbors has. Deleting the group
+ * \n         again gives exactly the board before the step, so playing the
+ * \n         steps in reverse order clears the board. A step tries all
+ * \n         heights from a random one on, low columns are preferred and no
+ * \n         column is left one block short. If no group fits for a while,
+ * \n         the last groups are taken back again, after too many tries it
+ * \n         starts over. A single row is a line of runs instead. Boards
+ * \n         which could never be cleared, e.g. a single block, get a random
+ * \n         setup, and so do most boards with two colors larger than about
+ * \n         40 blocks, where a new group rarely finds a color none of its
+ * \n         neighbors has, see tools/sameclear.
+ *
+ * \param     pBoard --> board context, pSolution --> taps which clear the
+ * \n         board, up to SAGA_MAXGROUPS, or NULL
+ *
+ * \return    number of moves of the solution, -1 if it's a random board
+ */
+/*===============================================================================*/
+int SAGA_BoardSetupClearable(SAGA_Board *pBoard, SAGA_Cell *pSolution)
+{
+  SAGA_Cell arrTaps[SAGA_MAXGROUPS];
+  unsigned char arrSteps[SAGA_MAXGROUPS], arrSizes[SAGA_MAXGROUPS];
+  int nRows = pBoard->nRows;
+  int nCells = pBoard->nRows * pBoard->nColumns;
+  unsigned int nFree = 0;
+  int nRestart, nTry, nFail, nMoves = 0, nStep, nSize, nWidth, nPlaces, nFirst, col = 0, h = 0, i;
+  int nColor = 0;
+  
+  //  A single color is one group, no need to search
+  if(pBoard->nColors == 1 && nCells >= 2)
+  {
+    SAGA_BoardSetup(pBoard);
+    if(pSolution)
+    {
+      pSolution[0].row = nRows - 1;
+      pSolution[0].col = 0;
+    }
+    return 1;
+  }
+  
+  //  A single row has no room to lift blocks, it is a line of runs with
+  //  another color than the run before, the leftmost run is always a group
+  if(nRows == 1 && nCells >= 2)
+  {
+    SAGA_BoardClear(pBoard);
+    for(col = 0; col < nCells; col += nSize)
+    {
+      nSize = 2 + SAGA_BoardRandom(pBoard) % 3;
+      if(nCells - col - nSize <= 1)
+        nSize = nCells - col;
+      if(nColor == 0)
+        nColor = 1 + SAGA_BoardRandom(pBoard) % pBoard->nColors;
+      else
+        nColor = 1 + (nColor + SAGA_BoardRandom(pBoard) % (pBoard->nColors - 1)) % pBoard->nColors;
+      memset(&pBoard->arrCells[col], nColor, nSize);
+      memset(&pBoard->arrHeights[col], 1, nSize);
+      if(pSolution)
+      {
+        pSolution[nMoves].row = 0;
+        pSolution[nMoves].col = 0;
+      }
+      nMoves++;
+    }
+    pBoard->nUsedColumns = nCells;
+    pBoard->nRemaining = nCells;
+    SAGA_BoardRefresh(pBoard);
+    return nMoves;
+  }
+  
+  for(nRestart = 0; nRestart < SAGA_GENRESTARTS; nRestart++)
+  {
+    SAGA_BoardClear(pBoard);
+    nMoves = 0;
+    nFail = 0;
+    for(nTry = 0; nTry < SAGA_GENTRIES && pBoard->nRemaining < nCells; nTry++)
+    {
+      //  Take back some of the last groups if nothing fits any more
+      if(++nFail > SAGA_GENBACKTRACK)
+      {
+        for(i = 1 + SAGA_BoardRandom(pBoard) % SAGA_GENTAKEBACK; i > 0 && nMoves > 0; i--)
+        {
+          nMoves--;
+          col = arrTaps[nMoves].col;
+          h = nRows - 1 - arrTaps[nMoves].row;
+          if(arrSteps[nMoves] == SAGA_STEP_HORIZONTAL)
+            for(nSize = arrSizes[nMoves]; nSize > 0; nSize--)
+              SAGA_RemoveBlocks(pBoard, col + nSize - 1, h, 1);
+          else
+            SAGA_RemoveBlocks(pBoard, col, h, arrSizes[nMoves]);
+        }
+        nFail = 0;
+      }
+      
+      //  Missing columns are added with a chance of their share of the board
+      nSize = 2 + SAGA_BoardRandom(pBoard) % 3;
+      if((int)(SAGA_BoardRandom(pBoard) % pBoard->nColumns) <
+         pBoard->nColumns - pBoard->nUsedColumns)
+        nStep = SAGA_STEP_COLUMN;
+      else
+        nStep = SAGA_BoardRandom(pBoard) & 1 ? SAGA_STEP_VERTICAL : SAGA_STEP_HORIZONTAL;
+      
+      if(nStep == SAGA_STEP_COLUMN)
+      {
+        //  New column, all places col are tried
+        if(nRows < 2)
+          continue;
+        if(nSize > nRows)
+          nSize = nRows;
+        if(nRows - nSize == 1)
+          nSize = nSize > 2 ? nSize - 1 : nRows;
+        nPlaces = pBoard->nUsedColumns + 1;
+        h = 0;
+      }
+      if(nStep == SAGA_STEP_HORIZONTAL)
+      {
+        //  Horizontal bar at the same height of neighbor columns, if there
+        //  is no room it gets a vertical one
+        nWidth = nSize > 3 ? 2 : nSize;
+        col = SAGA_FindRoom(pBoard, SAGA_BoardRandom(pBoard), nWidth);
+        if(col < 0)
+          nStep = SAGA_STEP_VERTICAL;
+        else
+        {
+          nSize = nWidth;
+          for(i = col, nPlaces = nRows; i < col + nSize; i++)
+            if(pBoard->arrHeights[i] < nPlaces)
+              nPlaces = pBoard->arrHeights[i] + 1;
+        }
+      }
+      if(nStep == SAGA_STEP_VERTICAL)
+      {
+        //  Vertical bar lifting the blocks of the lower of two columns
+        col = SAGA_FindRoom(pBoard, SAGA_BoardRandom(pBoard), 1);
+        i = SAGA_FindRoom(pBoard, SAGA_BoardRandom(pBoard), 1);
+        if(col < 0)
+          continue;
+        if(pBoard->arrHeights[i] < pBoard->arrHeights[col])
+          col = i;
+        i = nRows - pBoard->arrHeights[col];
+        if(nSize > i)
+          nSize = i;
+        if(i - nSize == 1)
+          nSize = nSize > 2 ? nSize - 1 : i;
+        nPlaces = pBoard->arrHeights[col] + 1;
+      }
+      
+      //  Try all places from a random one on, until a color is left
+      nFirst = SAGA_BoardRandom(pBoard) % nPlaces;
+      for(i = 0; i < nPlaces; i++)
+      {
+        if(nStep == SAGA_STEP_COLUMN)
+          col = (nFirst + i) % nPlaces;
+        else
+          h = (nFirst + i) % nPlaces;
+        nFree = ~SAGA_BlockedColors(pBoard, nStep, col, h, nSize) &
+                ((2u << pBoard->nColors) - 2);
+        if(nFree != 0)
+          break;
+      }
+      if(nFree == 0)
+        continue;
+      
+      //  Pick one of the colors none of the neighbors has
+      for(i = SAGA_BoardRandom(pBoard) % __builtin_popcount(nFree); i > 0; i--)
+        nFree &= nFree - 1;
+      if(nStep == SAGA_STEP_COLUMN)
+        SAGA_InsertColumn(pBoard, col);
+      if(nStep == SAGA_STEP_HORIZONTAL)
+        for(i = col; i < col + nSize; i++)
+          SAGA_InsertBlocks(pBoard, i, h, 1, __builtin_ctz(nFree));
+      else
+        SAGA_InsertBlocks(pBoard, col, h, nSize, __builtin_ctz(nFree));
+      
+      //  The lowest, leftmost block of the group is the tap
+      arrSteps[nMoves] = nStep;
+      arrSizes[nMoves] = nSize;
+      arrTaps[nMoves].row = nRows - 1 - h;
+      arrTaps[nMoves++].col = col;
+      nFail = 0;
+    }
+    if(pBoard->nRemaining == nCells)
+      break;
+  }
+  
+  //  Give up on boards which couldn't be filled
+  if(pBoard->nRemaining < nCells)
+  {
+    SAGA_BoardSetup(pBoard);
+    return -1;
+  }
+  
+  SAGA_BoardRefresh(pBoard);
+  if(pSolution)
+    for(i = 0; i < nMoves; i++)
+      pSolution[i] = arrTaps[nMoves - 1 - i];
+  return nMoves;
+}
+
+//*==============================================================================*/
+/*  SAGA_BoardVerifySolution                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Check a solution
+ *
+ * \details   Play the taps on a copy of the board, every tap must delete a
+ * \n         group and at the end no block may be left.
+ *
+ * \param     pBoard --> board context, pSolution --> taps, nMoves --> number
+ * \n         of taps
+ *
+ * \return    true if the taps clear the board
+ */
+/*===============================================================================*/
+bool SAGA_BoardVerifySolution(const SAGA_Board *pBoard, const SAGA_Cell *pSolution, int nMoves)
+{
+  SAGA_Board board;
+  int i;
+  
+  SAGA_BoardCopy(&board, pBoard);
+  for(i = 0; i < nMoves; i++)
+    if(SAGA_BoardDeleteBlocks(&board, pSolution[i].row, pSolution[i].col) <= 0)
+      return false;
+  return board.nRemaining == 0;
+}
+
+//----------------------------------- END --------------------------------------
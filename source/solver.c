@@ -0,0 +1,331 @@
+/*********************************************************************************/
+/*!
+ * \file      solver.c
+ *
+ * \brief     The Same Game v0.1 --> SOLVER File
+ *
+ * \details   Depth first search whether a board could be cleared. Every
+ * \n         position which is proven to be dead goes into a table, so it is
+ * \n         never searched again when another line of play reaches it.
+ * \n         Positions which only differ in the names of their colors are
+ * \n         the same for the search, their key is taken after the colors
+ * \n         are renamed in the order they appear on the board.
+ * \n         The table has no locks, a slot is one 64 bit key which is
+ * \n         read and written atomically. Any number of threads could share
+ * \n         it, e.g. for Lazy SMP, where every thread searches the same
+ * \n         board in another move order and they profit from the dead
+ * \n         positions found by the others. A lost or overwritten key only
+ * \n         costs time, a dead position stays dead.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include "solver.h"
+#include "analysis.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// the stop flag is read once per this many nodes
+#define SOLV_POLL  256
+
+// results of the recursive search
+#define SOLV_FOUND  1
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // state of one search
+  SAGA_Board Board;                    // position of the search
+  SAGA_Journal Journal;                // moves to the position
+  SAGA_Group *pGroups;                 // one list of moves for each depth
+  SOLV_Table *pTable;                  // shared dead positions
+  int *pStop;                          // shared stop flag
+  int nOrder;                          // move order of the search
+  SOLV_Stats Stats;                    // counters
+}SOLV_Context;
+
+//*==============================================================================*/
+/*  SOLV_TableInit                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Create a table of dead positions
+ *
+ * \param     pTable --> table, nBits --> table has 2^nBits slots of 8 bytes
+ *
+ * \return    true if the table could be allocated
+ */
+/*===============================================================================*/
+bool SOLV_TableInit(SOLV_Table *pTable, int nBits)
+{
+  if(nBits < 2)
+    nBits = 2;
+  pTable->pKeys = calloc((size_t)1 << nBits, sizeof(uint64_t));
+  pTable->nMask = ((uint64_t)1 << nBits) - 1;
+  pTable->pBase = NULL;
+  pTable->bExact = false;
+  return pTable->pKeys != NULL;
+}
+
+//*==============================================================================*/
+/*  SOLV_TableFree                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Free a table of dead positions
+ *
+ * \param     pTable --> table
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SOLV_TableFree(SOLV_Table *pTable)
+{
+  free(pTable->pKeys);
+  pTable->pKeys = NULL;
+}
+
+//*==============================================================================*/
+/*  SOLV_TableClear                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Forget all dead positions
+ *
+ * \details   Not needed between boards, the keys only depend on the
+ * \n         position, so the table could be kept for the next board.
+ *
+ * \param     pTable --> table
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void SOLV_TableClear(SOLV_Table *pTable)
+{
+  memset(pTable->pKeys, 0, (pTable->nMask + 1) * sizeof(uint64_t));
+}
+
+//*==============================================================================*/
+/*  SOLV_TableProbe                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Look up a position
+ *
+ * \details   A key could only be in the bucket of SOLV_BUCKET slots where it
+ * \n         is stored.
+ *
+ * \param     pTable --> table, nKey --> position key
+ *
+ * \return    true if the position is known to be dead
+ */
+/*===============================================================================*/
+static bool SOLV_TableProbe(const SOLV_Table *pTable, uint64_t nKey)
+{
+  const uint64_t *pBucket = &pTable->pKeys[nKey & pTable->nMask & ~(uint64_t)(SOLV_BUCKET - 1)];
+  int i;
+
+  for(i = 0; i < SOLV_BUCKET; i++)
+    if(__atomic_load_n(&pBucket[i], __ATOMIC_RELAXED) == nKey)
+      return true;
+  return false;
+}
+
+//*==============================================================================*/
+/*  SOLV_TableStore                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Remember a dead position
+ *
+ * \details   The key goes to an empty slot of its bucket, if there is none
+ * \n         it replaces a slot chosen by the key itself. Two threads could
+ * \n         store into the same slot, then one of the keys is lost.
+ *
+ * \param     pTable --> table, nKey --> position key
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void SOLV_TableStore(SOLV_Table *pTable, uint64_t nKey)
+{
+  uint64_t *pBucket = &pTable->pKeys[nKey & pTable->nMask & ~(uint64_t)(SOLV_BUCKET - 1)];
+  uint64_t nSlot;
+  int i;
+
+  for(i = 0; i < SOLV_BUCKET; i++)
+  {
+    nSlot = __atomic_load_n(&pBucket[i], __ATOMIC_RELAXED);
+    if(nSlot == 0 || nSlot == nKey)
+      break;
+  }
+  if(i == SOLV_BUCKET)
+    i = (nKey >> 60) % SOLV_BUCKET;
+  __atomic_store_n(&pBucket[i], nKey, __ATOMIC_RELAXED);
+}
+
+//*==============================================================================*/
+/*  SOLV_GetKey                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Key of a position
+ *
+ * \details   The canonical hash of the board, so all boards which only
+ * \n         differ by a permutation of the colors get the same key. It is
+ * \n         kept up to date by the moves, the blocks are not read again.
+ * \n         The key is never 0.
+ *
+ * \param     pBoard --> board context
+ *
+ * \return    64 bit key
+ */
+/*===============================================================================*/
+uint64_t SOLV_GetKey(const SAGA_Board *pBoard)
+{
+  return SAGA_BoardGetCanonicalHash(pBoard) | 1;
+}
+
+//*==============================================================================*/
+/*  SOLV_Search                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Search a position
+ *
+ * \details   A position is dead without a search if the analysis proves it,
+ * \n         e.g. a color has a single block left or there is no move at
+ * \n         all. A position of the tablebase is decided by it, a clearing
+ * \n         line is played along its best moves. Otherwise every move is
+ * \n         tried, starting at one which depends on the move order of the
+ * \n         search, so threads with other orders split up near the root. A
+ * \n         solution stays on the board, its moves are in the journal.
+ *
+ * \param     pCtx --> search context, nDepth --> moves made so far
+ *
+ * \return    SOLV_FOUND, SOLV_DEAD or SOLV_STOPPED
+ */
+/*===============================================================================*/
+static int SOLV_Search(SOLV_Context *pCtx, int nDepth)
+{
+  SAGA_Board *pBoard = &pCtx->Board;
+  SAGA_Group *pGroups = &pCtx->pGroups[nDepth * SAGA_MAXGROUPS];
+  const SAGA_Group *pGroup;
+  const TBL_Table *pBase = pCtx->pTable->pBase;
+  SAGA_Cell Move;
+  uint64_t nKey;
+  int i, nGroups, nFirst, nResult, nValue;
+
+  if(pBoard->nRemaining == 0)
+    return SOLV_FOUND;
+  if(ANA_IsDead(pBoard))
+    return SOLV_DEAD;
+  if(pCtx->Stats.nNodes++ % SOLV_POLL == 0 && __atomic_load_n(pCtx->pStop, __ATOMIC_RELAXED))
+    return SOLV_STOPPED;
+
+  //  The tablebase knows the rest, its best line clears the board if possible
+  if(pBase != NULL && (nValue = TBL_Probe(pBase, pBoard)) >= 0)
+  {
+    pCtx->Stats.nEndgames++;
+    if(!(nValue & TBL_CLEAR))
+      return SOLV_DEAD;
+    while(TBL_GetBestMove(pBase, pBoard, &Move) >= 0)
+      SAGA_BoardMakeMove(pBoard, Move.row, Move.col, &pCtx->Journal);
+    return SOLV_FOUND;
+  }
+
+  nKey = pCtx->pTable->bExact ? pBoard->nHash | 1 : SOLV_GetKey(pBoard);
+  pCtx->Stats.nProbes++;
+  if(SOLV_TableProbe(pCtx->pTable, nKey))
+  {
+    pCtx->Stats.nHits++;
+    return SOLV_DEAD;
+  }
+
+  nGroups = SAGA_BoardEnumerateMoves(pBoard, pGroups, SAGA_MAXGROUPS, NULL);
+  nFirst = (pCtx->nOrder * (nDepth + 1)) % nGroups;
+  for(i = 0; i < nGroups; i++)
+  {
+    pGroup = &pGroups[(nFirst + i) % nGroups];
+    SAGA_BoardMakeMove(pBoard, pGroup->row, pGroup->col, &pCtx->Journal);
+    nResult = SOLV_Search(pCtx, nDepth + 1);
+    if(nResult == SOLV_FOUND)
+      return SOLV_FOUND;
+    SAGA_BoardUnmakeMove(pBoard, &pCtx->Journal);
+    if(nResult == SOLV_STOPPED)
+      return SOLV_STOPPED;
+  }
+  SOLV_TableStore(pCtx->pTable, nKey);
+  return SOLV_DEAD;
+}
+
+//*==============================================================================*/
+/*  SOLV_Solve                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Find out if a board could be cleared
+ *
+ * \details   Exact depth first search with the rules of the engine. Several
+ * \n         threads could search the same board with the same table and
+ * \n         stop flag, each with another move order. The first one with a
+ * \n         result sets the flag and the others return SOLV_STOPPED. The
+ * \n         flag could also be set from outside to give up.
+ *
+ * \param     pBoard --> board context, pTable --> dead positions,
+ * \n         nOrder --> move order, 0 for the natural one,
+ * \n         pStop --> stop flag, pSolution --> list for the moves of a
+ * \n         solution or NULL, pStats --> counters or NULL
+ *
+ * \return    number of moves of a solution, SOLV_DEAD or SOLV_STOPPED
+ */
+/*===============================================================================*/
+int SOLV_Solve(const SAGA_Board *pBoard, SOLV_Table *pTable, int nOrder, int *pStop,
+               SAGA_Cell *pSolution, SOLV_Stats *pStats)
+{
+  SOLV_Context *pCtx;
+  int i, nResult;
+
+  pCtx = malloc(sizeof(SOLV_Context));
+  if(pCtx == NULL)
+    return SOLV_STOPPED;
+  //  A move removes at least two blocks, that limits the depth
+  pCtx->pGroups = malloc((pBoard->nRemaining / 2 + 1) * SAGA_MAXGROUPS * sizeof(SAGA_Group));
+  if(pCtx->pGroups == NULL)
+  {
+    free(pCtx);
+    return SOLV_STOPPED;
+  }
+
+  SAGA_BoardCopy(&pCtx->Board, pBoard);
+  SAGA_JournalClear(&pCtx->Journal);
+  pCtx->pTable = pTable;
+  pCtx->pStop = pStop;
+  pCtx->nOrder = nOrder;
+  memset(&pCtx->Stats, 0, sizeof(SOLV_Stats));
+
+  nResult = SOLV_Search(pCtx, 0);
+  if(nResult == SOLV_FOUND)
+  {
+    //  The first removed block of every move is the tapped one
+    nResult = pCtx->Journal.nMoves;
+    for(i = 0; pSolution != NULL && i < nResult; i++)
+      pSolution[i] = pCtx->Journal.arrCells[pCtx->Journal.arrMoves[i].nFirst];
+  }
+  if(nResult != SOLV_STOPPED)
+    __atomic_store_n(pStop, 1, __ATOMIC_RELAXED);
+  if(pStats != NULL)
+    *pStats = pCtx->Stats;
+
+  free(pCtx->pGroups);
+  free(pCtx);
+  return nResult;
+}
+
+//----------------------------------- END --------------------------------------
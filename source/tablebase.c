@@ -0,0 +1,420 @@
+/*********************************************************************************/
+/*!
+ * \file      tablebase.c
+ *
+ * \brief     The Same Game v0.1 --> ENDGAME TABLEBASE File
+ *
+ * \details   Numbering of the compacted positions and access to the table.
+ * \n         The positions with n blocks follow the ones with fewer blocks,
+ * \n         inside them the column heights count in steps of
+ * \n         arrColorings[n][0], the number of canonical colorings of n
+ * \n         blocks. The colors are renamed in the order they appear,
+ * \n         column by column from the bottom, so every block has one of
+ * \n         the colors before it or the next one. These restricted growth
+ * \n         strings are numbered by counting the colorings before them,
+ * \n         this is version 2 of the file, version 1 numbered all nColors^n
+ * \n         colorings. The values are stored in the byte order of the
+ * \n         machine, both the 3DS and a PC are little endian.
+ *
+ * \note      Hardware:    Nintendo 3DS
+ * \n         IDE:         DevkitPro 1.6.0
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tablebase.h"
+#ifndef _3DS
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+//*==============================================================================*/
+/*  TBL_Setup                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Set up the numbering of the positions
+ *
+ * \details   arrShapes[m][n] is the number of ways to stack n blocks into
+ * \n         at most m columns of 1 .. nRows blocks, left aligned.
+ * \n         arrColorings[n][m] is the number of ways to color n blocks
+ * \n         after m colors were used, each block gets one of the m colors
+ * \n         or the next one, up to nColors.
+ *
+ * \param     pTable --> table, nColumns, nRows, nColors, nBlocks
+ *
+ * \return    false if the sizes are out of range or there are too many
+ * \n         positions to number them
+ */
+/*===============================================================================*/
+static bool TBL_Setup(TBL_Table *pTable, int nColumns, int nRows, int nColors, int nBlocks)
+{
+  uint64_t nCount, nNew;
+  int m, n, h;
+
+  if(!SAGA_BoardIsValidSize(nColumns, nRows, nColors) || nBlocks < 0 || nBlocks > TBL_MAXBLOCKS)
+    return false;
+  pTable->nColumns = nColumns;
+  pTable->nRows = nRows;
+  pTable->nColors = nColors;
+  pTable->nBlocks = nBlocks;
+  pTable->pValues = NULL;
+  pTable->pData = NULL;
+  pTable->nSize = 0;
+  pTable->bMapped = false;
+
+  memset(pTable->arrShapes, 0, sizeof(pTable->arrShapes));
+  for(m = 0; m <= nColumns; m++)
+  {
+    pTable->arrShapes[m][0] = 1;
+    for(n = 1; m > 0 && n <= nBlocks; n++)
+      for(h = 1; h <= nRows && h <= n; h++)
+        pTable->arrShapes[m][n] += pTable->arrShapes[m - 1][n - h];
+  }
+
+  memset(pTable->arrColorings, 0, sizeof(pTable->arrColorings));
+  pTable->arrFirst[0] = 0;
+  for(n = 0; n <= nBlocks; n++)
+  {
+    for(m = 0; m <= nColors; m++)
+    {
+      nNew = m < nColors && n > 0 ? pTable->arrColorings[n - 1][m + 1] : 0;
+      if(n == 0)
+        pTable->arrColorings[n][m] = 1;
+      else if(__builtin_mul_overflow(pTable->arrColorings[n - 1][m], m, &nCount) ||
+              __builtin_add_overflow(nCount, nNew, &pTable->arrColorings[n][m]))
+        return false;
+    }
+    if(__builtin_mul_overflow(pTable->arrShapes[nColumns][n], pTable->arrColorings[n][0],
+                              &nCount) ||
+       __builtin_add_overflow(pTable->arrFirst[n], nCount, &pTable->arrFirst[n + 1]))
+      return false;
+  }
+  pTable->nEntries = pTable->arrFirst[nBlocks + 1];
+  return pTable->nEntries <= SIZE_MAX / sizeof(uint16_t);
+}
+
+//*==============================================================================*/
+/*  TBL_Init                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Create an empty table
+ *
+ * \details   All values are 0, they are filled in by the generator.
+ *
+ * \param     pTable --> table, nColumns, nRows --> largest board,
+ * \n         nColors --> number of colors, nBlocks --> most blocks
+ *
+ * \return    false if the sizes are out of range or there is no memory
+ */
+/*===============================================================================*/
+bool TBL_Init(TBL_Table *pTable, int nColumns, int nRows, int nColors, int nBlocks)
+{
+  if(!TBL_Setup(pTable, nColumns, nRows, nColors, nBlocks))
+    return false;
+  pTable->nSize = pTable->nEntries * sizeof(uint16_t);
+  pTable->pData = calloc(pTable->nEntries, sizeof(uint16_t));
+  pTable->pValues = pTable->pData;
+  return pTable->pData != NULL;
+}
+
+//*==============================================================================*/
+/*  TBL_Open                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Load a table file
+ *
+ * \details   On a host the file is mapped read only, on the 3DS it is read
+ * \n         into memory. The table must be made with the same clear bonus.
+ *
+ * \param     pTable --> table, pPath --> file name
+ *
+ * \return    false if the file is missing or doesn't fit
+ */
+/*===============================================================================*/
+bool TBL_Open(TBL_Table *pTable, const char *pPath)
+{
+  TBL_Header Header;
+  FILE *pFile;
+  size_t nSize;
+  bool bOk;
+
+  pFile = fopen(pPath, "rb");
+  if(pFile == NULL)
+    return false;
+  bOk = fread(&Header, sizeof(Header), 1, pFile) == 1 &&
+        memcmp(Header.arrMagic, TBL_MAGIC, sizeof(Header.arrMagic)) == 0 &&
+        Header.nVersion == TBL_VERSION && Header.nBonus == SAGA_CLEARBONUS &&
+        TBL_Setup(pTable, Header.nColumns, Header.nRows, Header.nColors, Header.nBlocks) &&
+        Header.nEntries == pTable->nEntries;
+  if(!bOk)
+  {
+    fclose(pFile);
+    return false;
+  }
+  nSize = sizeof(Header) + pTable->nEntries * sizeof(uint16_t);
+
+#ifdef _3DS
+  pTable->pData = malloc(nSize);
+  bOk = pTable->pData != NULL &&
+        fread((char *)pTable->pData + sizeof(Header), sizeof(uint16_t), pTable->nEntries, pFile) ==
+        pTable->nEntries;
+#else
+  pTable->pData = mmap(NULL, nSize, PROT_READ, MAP_SHARED, fileno(pFile), 0);
+  if(pTable->pData == MAP_FAILED)
+    pTable->pData = NULL;
+  pTable->bMapped = pTable->pData != NULL;
+  bOk = pTable->bMapped && lseek(fileno(pFile), 0, SEEK_END) >= (off_t)nSize;
+#endif
+  fclose(pFile);
+  pTable->nSize = nSize;
+  pTable->pValues = (uint16_t *)((char *)pTable->pData + sizeof(Header));
+  if(!bOk)
+    TBL_Free(pTable);
+  return bOk;
+}
+
+//*==============================================================================*/
+/*  TBL_Save                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Write a table file
+ *
+ * \param     pTable --> table, pPath --> file name
+ *
+ * \return    false if the file couldn't be written
+ */
+/*===============================================================================*/
+bool TBL_Save(const TBL_Table *pTable, const char *pPath)
+{
+  TBL_Header Header;
+  FILE *pFile;
+  bool bOk;
+
+  memset(&Header, 0, sizeof(Header));
+  memcpy(Header.arrMagic, TBL_MAGIC, sizeof(Header.arrMagic));
+  Header.nVersion = TBL_VERSION;
+  Header.nColumns = pTable->nColumns;
+  Header.nRows = pTable->nRows;
+  Header.nColors = pTable->nColors;
+  Header.nBlocks = pTable->nBlocks;
+  Header.nBonus = SAGA_CLEARBONUS;
+  Header.nEntries = pTable->nEntries;
+
+  pFile = fopen(pPath, "wb");
+  if(pFile == NULL)
+    return false;
+  bOk = fwrite(&Header, sizeof(Header), 1, pFile) == 1 &&
+        fwrite(pTable->pValues, sizeof(uint16_t), pTable->nEntries, pFile) == pTable->nEntries;
+  return fclose(pFile) == 0 && bOk;
+}
+
+//*==============================================================================*/
+/*  TBL_Free                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Release the values of a table
+ *
+ * \param     pTable --> table
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void TBL_Free(TBL_Table *pTable)
+{
+#ifndef _3DS
+  if(pTable->bMapped)
+    munmap(pTable->pData, pTable->nSize);
+  else
+#endif
+    free(pTable->pData);
+  pTable->pData = NULL;
+  pTable->pValues = NULL;
+  pTable->bMapped = false;
+}
+
+//*==============================================================================*/
+/*  TBL_GetIndex                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Number of a position
+ *
+ * \details   Any compacted board fits whose used columns, heights, number
+ * \n         of colors and block count are inside the table, the board
+ * \n         itself could be of another size. The colors are renamed in
+ * \n         the order they appear, column by column from the bottom, the
+ * \n         number of a block is the count of the colorings before it.
+ *
+ * \param     pTable --> table, pBoard --> board context
+ *
+ * \return    index of the value, TBL_NONE if the position isn't in the table
+ */
+/*===============================================================================*/
+uint64_t TBL_GetIndex(const TBL_Table *pTable, const SAGA_Board *pBoard)
+{
+  unsigned char arrName[SAGA_MAXCOLORS + 1] = { 0 };
+  const unsigned char *pColumn;
+  uint64_t nShape = 0, nColors = 0;
+  int col, h, nLeft = pBoard->nRemaining, nRest = pBoard->nRemaining, nNames = 0;
+
+  if(nLeft > pTable->nBlocks || pBoard->nUsedColumns > pTable->nColumns)
+    return TBL_NONE;
+  for(col = 0; col < pBoard->nUsedColumns; col++)
+  {
+    if(pBoard->arrHeights[col] > pTable->nRows)
+      return TBL_NONE;
+    //  Skip the shapes with a lower column here
+    for(h = 1; h < pBoard->arrHeights[col]; h++)
+      nShape += pTable->arrShapes[pTable->nColumns - col - 1][nLeft - h];
+    nLeft -= pBoard->arrHeights[col];
+
+    pColumn = &pBoard->arrCells[col * pBoard->nRows];
+    for(h = 0; h < pBoard->arrHeights[col]; h++)
+    {
+      if(arrName[pColumn[h]] == 0)
+      {
+        if(nNames == pTable->nColors)
+          return TBL_NONE;
+        arrName[pColumn[h]] = nNames + 1;
+      }
+      //  The colors before this one have the same number of colorings
+      nColors += (arrName[pColumn[h]] - 1) * pTable->arrColorings[--nRest][nNames];
+      if(arrName[pColumn[h]] > nNames)
+        nNames++;
+    }
+  }
+  return pTable->arrFirst[pBoard->nRemaining] +
+         nShape * pTable->arrColorings[pBoard->nRemaining][0] + nColors;
+}
+
+//*==============================================================================*/
+/*  TBL_SetupBoard                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Position of a number
+ *
+ * \details   The inverse of TBL_GetIndex, the board gets the size of the
+ * \n         table and a score of 0, its colors are in canonical order.
+ *
+ * \param     pTable --> table, nIndex --> 0 .. nEntries - 1,
+ * \n         pBoard --> board context
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void TBL_SetupBoard(const TBL_Table *pTable, uint64_t nIndex, SAGA_Board *pBoard)
+{
+  uint64_t nShape, nColors, nCount, nName;
+  int col, h, n = 0, nLeft, nNames = 0;
+
+  while(nIndex >= pTable->arrFirst[n + 1])
+    n++;
+  nIndex -= pTable->arrFirst[n];
+  nShape = nIndex / pTable->arrColorings[n][0];
+  nColors = nIndex % pTable->arrColorings[n][0];
+
+  SAGA_BoardInit(pBoard, pTable->nColumns, pTable->nRows, pTable->nColors);
+  for(col = 0, nLeft = n; nLeft > 0; col++)
+  {
+    for(h = 1; ; h++)
+    {
+      nCount = pTable->arrShapes[pTable->nColumns - col - 1][nLeft - h];
+      if(nShape < nCount)
+        break;
+      nShape -= nCount;
+    }
+    pBoard->arrHeights[col] = h;
+    nLeft -= h;
+  }
+  pBoard->nUsedColumns = col;
+  pBoard->nRemaining = n;
+
+  //  A new color has at least as many colorings as each used one
+  for(col = 0, nLeft = n; col < pBoard->nUsedColumns; col++)
+  {
+    for(h = 0; h < pBoard->arrHeights[col]; h++)
+    {
+      nCount = pTable->arrColorings[--nLeft][nNames];
+      nName = nColors / nCount < (uint64_t)nNames ? nColors / nCount : (uint64_t)nNames;
+      nColors -= nName * nCount;
+      pBoard->arrCells[col * pBoard->nRows + h] = nName + 1;
+      if(nName == (uint64_t)nNames)
+        nNames++;
+    }
+  }
+  SAGA_BoardRefresh(pBoard);
+}
+
+//*==============================================================================*/
+/*  TBL_Probe                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Look up a position
+ *
+ * \param     pTable --> table, pBoard --> board context
+ *
+ * \return    value, TBL_CLEAR if it could be cleared and the best score
+ * \n         still to get, -1 if the position isn't in the table
+ */
+/*===============================================================================*/
+int TBL_Probe(const TBL_Table *pTable, const SAGA_Board *pBoard)
+{
+  uint64_t nIndex = TBL_GetIndex(pTable, pBoard);
+
+  if(nIndex == TBL_NONE)
+    return -1;
+  return pTable->pValues[nIndex];
+}
+
+//*==============================================================================*/
+/*  TBL_GetBestMove                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Best move of a position in the table
+ *
+ * \details   The move whose points and the value of the position after it
+ * \n         give the most. Following the best moves clears the board if
+ * \n         it could be cleared.
+ *
+ * \param     pTable --> table, pBoard --> board context, pMove --> output
+ *
+ * \return    value of the position like TBL_Probe, -1 if the position
+ * \n         isn't in the table or has no move
+ */
+/*===============================================================================*/
+int TBL_GetBestMove(const TBL_Table *pTable, const SAGA_Board *pBoard, SAGA_Cell *pMove)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Board Child;
+  int i, nGroups, nValue, nBest = -1;
+
+  if(TBL_GetIndex(pTable, pBoard) == TBL_NONE)
+    return -1;
+  nGroups = SAGA_BoardEnumerateMoves(pBoard, arrGroups, SAGA_MAXGROUPS, NULL);
+  for(i = 0; i < nGroups; i++)
+  {
+    SAGA_BoardCopy(&Child, pBoard);
+    SAGA_BoardDeleteBlocks(&Child, arrGroups[i].row, arrGroups[i].col);
+    nValue = TBL_Probe(pTable, &Child);
+    nValue = (nValue & TBL_CLEAR) | (Child.nScore - pBoard->nScore + TBL_SCORE(nValue));
+    if(nBest < 0 || TBL_SCORE(nValue) > TBL_SCORE(nBest))
+    {
+      nBest = nValue;
+      pMove->row = arrGroups[i].row;
+      pMove->col = arrGroups[i].col;
+    }
+  }
+  return nBest;
+}
+
+//----------------------------------- END --------------------------------------
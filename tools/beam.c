@@ -0,0 +1,278 @@
+/*********************************************************************************/
+/*!
+ * \file      beam.c
+ *
+ * \brief     The Same Game v0.1 --> BEAM LAYER File
+ *
+ * \details   Expansion, selection and setup of a beam layer, shared by
+ * \n         samebeam and sameseed. The order of the children is total, so
+ * \n         the kept positions and the result don't depend on how a layer
+ * \n         was split into slices.
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "beam.h"
+
+//*==============================================================================*/
+/*  BEAM_ByHash                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Order of children for merging equal positions
+ *
+ * \details   Equal hashes next to each other with the best score first, the
+ * \n         parent and the move make the order total.
+ *
+ * \param     pLeft, pRight --> children
+ *
+ * \return    <0, 0, >0 like for qsort
+ */
+/*===============================================================================*/
+int BEAM_ByHash(const void *pLeft, const void *pRight)
+{
+  const BEAM_Child *pA = pLeft, *pB = pRight;
+
+  if(pA->nHash != pB->nHash)
+    return pA->nHash < pB->nHash ? -1 : 1;
+  if(pA->nScore != pB->nScore)
+    return pB->nScore - pA->nScore;
+  if(pA->nParent != pB->nParent)
+    return pA->nParent - pB->nParent;
+  if(pA->Move.col != pB->Move.col)
+    return pA->Move.col - pB->Move.col;
+  return pA->Move.row - pB->Move.row;
+}
+
+//*==============================================================================*/
+/*  BEAM_ByScore                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Order of children for the selection
+ *
+ * \details   Best score first, the hash decides between equal scores.
+ *
+ * \param     pLeft, pRight --> children
+ *
+ * \return    <0, 0, >0 like for qsort
+ */
+/*===============================================================================*/
+int BEAM_ByScore(const void *pLeft, const void *pRight)
+{
+  const BEAM_Child *pA = pLeft, *pB = pRight;
+
+  if(pA->nScore != pB->nScore)
+    return pB->nScore - pA->nScore;
+  if(pA->nHash != pB->nHash)
+    return pA->nHash < pB->nHash ? -1 : 1;
+  return 0;
+}
+
+//*==============================================================================*/
+/*  BEAM_ExpandBoard                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Try all moves of one position
+ *
+ * \param     pBoard --> position, nNode --> its index in the layer,
+ * \n         pChildren --> room for SAGA_MAXGROUPS children
+ *
+ * \return    number of children, 0 if the game is over
+ */
+/*===============================================================================*/
+int BEAM_ExpandBoard(const SAGA_Board *pBoard, int nNode, BEAM_Child *pChildren)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Board Child;
+  int i, nGroups;
+
+  nGroups = SAGA_BoardEnumerateMoves(pBoard, arrGroups, SAGA_MAXGROUPS, NULL);
+  for(i = 0; i < nGroups; i++)
+  {
+    SAGA_BoardCopy(&Child, pBoard);
+    SAGA_BoardDeleteBlocks(&Child, arrGroups[i].row, arrGroups[i].col);
+    pChildren[i].nHash = SAGA_BoardGetCanonicalHash(&Child);
+    pChildren[i].nScore = Child.nScore;
+    pChildren[i].nParent = nNode;
+    pChildren[i].Move.row = arrGroups[i].row;
+    pChildren[i].Move.col = arrGroups[i].col;
+  }
+  return nGroups;
+}
+
+//*==============================================================================*/
+/*  BEAM_Select                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Merge equal positions, then keep the best ones
+ *
+ * \details   Of the children with the same canonical hash only the best
+ * \n         is left, the kept children are at the start of the array.
+ *
+ * \param     pChildren --> all children of a layer, nAll --> their number,
+ * \n         nWidth --> positions kept per layer
+ *
+ * \return    number of kept children
+ */
+/*===============================================================================*/
+int BEAM_Select(BEAM_Child *pChildren, int nAll, int nWidth)
+{
+  int i, nUnique;
+
+  if(nAll == 0)
+    return 0;
+  qsort(pChildren, nAll, sizeof(BEAM_Child), BEAM_ByHash);
+  for(i = 1, nUnique = 1; i < nAll; i++)
+    if(pChildren[i].nHash != pChildren[nUnique - 1].nHash)
+      pChildren[nUnique++] = pChildren[i];
+  if(nUnique > nWidth)
+  {
+    qsort(pChildren, nUnique, sizeof(BEAM_Child), BEAM_ByScore);
+    nUnique = nWidth;
+  }
+  return nUnique;
+}
+
+//*==============================================================================*/
+/*  BEAM_Advance                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Set up a range of the next layer
+ *
+ * \details   The kept children nFirst .. nLast - 1 are played again from
+ * \n         their parents into the same places of the next layer.
+ *
+ * \param     pLayer --> current layer, pChosen --> kept children,
+ * \n         nFirst, nLast --> range, pNext --> next layer
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void BEAM_Advance(const SAGA_Board *pLayer, const BEAM_Child *pChosen, int nFirst, int nLast,
+                  SAGA_Board *pNext)
+{
+  int i;
+
+  for(i = nFirst; i < nLast; i++)
+  {
+    SAGA_BoardCopy(&pNext[i], &pLayer[pChosen[i].nParent]);
+    SAGA_BoardDeleteBlocks(&pNext[i], pChosen[i].Move.row, pChosen[i].Move.col);
+  }
+}
+
+//*==============================================================================*/
+/*  BEAM_Init                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Allocate the layers of a search in one thread
+ *
+ * \param     pSearch --> search, nWidth --> positions kept per layer
+ *
+ * \return    true if the storage could be allocated
+ */
+/*===============================================================================*/
+bool BEAM_Init(BEAM_Search *pSearch, int nWidth)
+{
+  pSearch->nWidth = nWidth;
+  pSearch->nNodes = 0;
+  pSearch->pLayer = malloc((size_t)nWidth * sizeof(SAGA_Board));
+  pSearch->pNext = malloc((size_t)nWidth * sizeof(SAGA_Board));
+  pSearch->pChildren = malloc((size_t)nWidth * SAGA_MAXGROUPS * sizeof(BEAM_Child));
+  return pSearch->pLayer != NULL && pSearch->pNext != NULL && pSearch->pChildren != NULL;
+}
+
+//*==============================================================================*/
+/*  BEAM_Free                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Free the layers of a search
+ *
+ * \param     pSearch --> search
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void BEAM_Free(BEAM_Search *pSearch)
+{
+  free(pSearch->pLayer);
+  free(pSearch->pNext);
+  free(pSearch->pChildren);
+  pSearch->pLayer = pSearch->pNext = NULL;
+  pSearch->pChildren = NULL;
+}
+
+//*==============================================================================*/
+/*  BEAM_Start                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Start the search of a board
+ *
+ * \param     pSearch --> search, pBoard --> start position
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+void BEAM_Start(BEAM_Search *pSearch, const SAGA_Board *pBoard)
+{
+  SAGA_BoardCopy(&pSearch->pLayer[0], pBoard);
+  pSearch->nNodes = 1;
+}
+
+//*==============================================================================*/
+/*  BEAM_Step                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Search one layer in this thread
+ *
+ * \details   All positions of the layer are expanded, the best finished one
+ * \n         is remembered, and the kept children become the layer. The
+ * \n         search is over when no position is left.
+ *
+ * \param     pSearch --> search
+ *
+ * \return    number of children of the layer
+ */
+/*===============================================================================*/
+int BEAM_Step(BEAM_Search *pSearch)
+{
+  SAGA_Board *pSwap;
+  int n, nGroups, nAll = 0;
+
+  pSearch->nBest = -1;
+  pSearch->nBestScore = -1;
+  pSearch->bCleared = false;
+  for(n = 0; n < pSearch->nNodes; n++)
+  {
+    nGroups = BEAM_ExpandBoard(&pSearch->pLayer[n], n, &pSearch->pChildren[nAll]);
+    if(nGroups == 0)
+    {
+      if(pSearch->pLayer[n].nScore > pSearch->nBestScore)
+      {
+        pSearch->nBest = n;
+        pSearch->nBestScore = pSearch->pLayer[n].nScore;
+      }
+      pSearch->bCleared |= pSearch->pLayer[n].nRemaining == 0;
+    }
+    nAll += nGroups;
+  }
+
+  pSearch->nNodes = BEAM_Select(pSearch->pChildren, nAll, pSearch->nWidth);
+  BEAM_Advance(pSearch->pLayer, pSearch->pChildren, 0, pSearch->nNodes, pSearch->pNext);
+  pSwap = pSearch->pLayer;
+  pSearch->pLayer = pSearch->pNext;
+  pSearch->pNext = pSwap;
+  return nAll;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,68 @@
+/*********************************************************************************/
+/*!
+ * \file      beam.h
+ *
+ * \brief     The Same Game v0.1 --> BEAM LAYER File
+ *
+ * \details   One layer of the beam search of samebeam and sameseed. All
+ * \n         moves of the kept positions are tried, the children are merged
+ * \n         by their canonical hash keeping the better score and the best
+ * \n         width children make the next layer. The parts work on ranges
+ * \n         of a layer, so samebeam runs them on slices in its threads,
+ * \n         BEAM_Step runs a whole layer in one thread.
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#ifndef BEAM_H
+#define BEAM_H
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "samegame.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // child of a position before the selection
+	uint64_t nHash;                      // canonical hash, the same for renamed colors
+	int nScore;                          // score of the child
+	int nParent;                         // position in the current layer
+	SAGA_Cell Move;                      // tap which leads to the child
+}BEAM_Child;
+
+typedef struct {  // two layers of a beam search in one thread
+	SAGA_Board *pLayer;                  // positions of the current layer
+	SAGA_Board *pNext;                   // positions of the next layer
+	BEAM_Child *pChildren;               // all children of a layer
+	int nWidth;                          // positions kept per layer
+	int nNodes;                          // number of positions in pLayer
+	int nBest, nBestScore;               // best finished position of the last layer, -1 if none
+	bool bCleared;                       // a finished position of the last layer is empty
+}BEAM_Search;
+
+/*-------------------------------------------------------------------------------*/
+/*  Function prototypes                                                          */
+/*-------------------------------------------------------------------------------*/
+int  BEAM_ByHash(const void *pLeft, const void *pRight);
+int  BEAM_ByScore(const void *pLeft, const void *pRight);
+int  BEAM_ExpandBoard(const SAGA_Board *pBoard, int nNode, BEAM_Child *pChildren);
+int  BEAM_Select(BEAM_Child *pChildren, int nAll, int nWidth);
+void BEAM_Advance(const SAGA_Board *pLayer, const BEAM_Child *pChosen, int nFirst, int nLast,
+                  SAGA_Board *pNext);
+bool BEAM_Init(BEAM_Search *pSearch, int nWidth);
+void BEAM_Free(BEAM_Search *pSearch);
+void BEAM_Start(BEAM_Search *pSearch, const SAGA_Board *pBoard);
+int  BEAM_Step(BEAM_Search *pSearch);
+
+//---------------------------------------------------------------------------------
+#endif // BEAM_H
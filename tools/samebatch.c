@@ -0,0 +1,234 @@
+/*********************************************************************************/
+/*!
+ * \file      samebatch.c
+ *
+ * \brief     The Same Game v0.1 --> BATCH TOOL File
+ *
+ * \details   Host tool which plays random games of numbered boards with the
+ * \n         batch engine, BAT_LANES boards at a time, and the same games
+ * \n         one by one with the scalar engine. It reports the playouts per
+ * \n         second of both and checks that every lane made the same taps
+ * \n         and ended with the same board and score as the scalar game.
+ * \n         The scalar engine draws its taps like the batch engine and is
+ * \n         slow on purpose, so the playouts of samenmcs on the board
+ * \n         context are timed as well. They draw other moves, only their
+ * \n         speed and average score are reported.
+ * \n
+ * \n         samebatch [-g first game] [-n games] [-p playouts per game]
+ * \n                   [-c columns] [-r rows] [-k colors] [-v]
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "batch.h"
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Setup                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Board of a playout
+ *
+ * \details   Every playout of a game starts from the numbered board, its
+ * \n         generator is seeded with the playout number.
+ *
+ * \param     pBoard --> board, nColumns, nRows, nColors, nGame --> game
+ * \n         number, nPlayout --> playout of the game
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Setup(SAGA_Board *pBoard, int nColumns, int nRows, int nColors, uint64_t nGame,
+                       uint64_t nPlayout)
+{
+  SAGA_BoardInit(pBoard, nColumns, nRows, nColors);
+  SAGA_BoardSetupGame(pBoard, nGame);
+  SAGA_BoardSeed(pBoard, nGame << 32 ^ nPlayout);
+}
+
+//*==============================================================================*/
+/*  TOOL_EnginePlayout                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Random game with the board context
+ *
+ * \details   The playout of samenmcs, the moves of a position are listed
+ * \n         once and a random one of them is played.
+ *
+ * \param     pBoard --> board, played until no move is left
+ *
+ * \return    number of moves
+ */
+/*===============================================================================*/
+static int TOOL_EnginePlayout(SAGA_Board *pBoard)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  int nGroups, nMoves = 0;
+
+  while((nGroups = SAGA_BoardEnumerateMoves(pBoard, arrGroups, SAGA_MAXGROUPS, NULL)) > 0)
+  {
+    nGroups = SAGA_BoardRandom(pBoard) % nGroups;
+    SAGA_BoardDeleteBlocks(pBoard, arrGroups[nGroups].row, arrGroups[nGroups].col);
+    nMoves++;
+  }
+  return nMoves;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Play all playouts batched, scalar and with the board context,
+ * \n         time them and compare every batched game with the scalar one.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if every lane matched the scalar engine
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static BAT_Batch Batch;
+  static SAGA_Board arrBoards[BAT_LANES], arrEngine[BAT_LANES];
+  static SAGA_Cell arrTaps[BAT_LANES][SAGA_MAXGROUPS];
+  static int arrMoves[BAT_LANES];
+  SAGA_Board Board;
+  uint64_t nGame, nFirst = 1, nPlayout;
+  int nGames = 10, nPlayouts = 1024, nColumns = NUMOFCOLUMN, nRows = NUMOFROWS;
+  int nColors = NUMOFCOLORS, bVerbose = 0, nFailed = 0, nLanes, i, nOpt;
+  long long nTotal = 0, nBatchScore = 0, nScalarScore = 0, nEngineScore = 0, nGameScore;
+  double fStart, fBatch = 0, fScalar = 0, fEngine = 0;
+
+  while((nOpt = getopt(argc, argv, "g:n:p:c:r:k:v")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'p': nPlayouts = atoi(optarg); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      case 'v': bVerbose = 1; break;
+      default:
+        fprintf(stderr, "usage: %s [-g first game] [-n games] [-p playouts per game] [-c columns] "
+                "[-r rows] [-k colors] [-v]\n", argv[0]);
+        return 2;
+    }
+  }
+  if(nPlayouts < 1 || !SAGA_BoardIsValidSize(nColumns, nRows, nColors))
+  {
+    fprintf(stderr, "%s: board or playouts out of range\n", argv[0]);
+    return 2;
+  }
+
+  for(nGame = nFirst; nGame < nFirst + nGames; nGame++)
+  {
+    nGameScore = 0;
+    for(nPlayout = 0; nPlayout < (uint64_t)nPlayouts; nPlayout += nLanes)
+    {
+      nLanes = nPlayouts - nPlayout < BAT_LANES ? nPlayouts - nPlayout : BAT_LANES;
+
+      //  All lanes at once
+      BAT_Init(&Batch, nColumns, nRows);
+      for(i = 0; i < nLanes; i++)
+      {
+        TOOL_Setup(&Board, nColumns, nRows, nColors, nGame, nPlayout + i);
+        BAT_Load(&Batch, i, &Board);
+      }
+      fStart = TOOL_Now();
+      BAT_Playout(&Batch);
+      fBatch += TOOL_Now() - fStart;
+
+      //  The same games one by one
+      for(i = 0; i < nLanes; i++)
+        TOOL_Setup(&arrBoards[i], nColumns, nRows, nColors, nGame, nPlayout + i);
+      fStart = TOOL_Now();
+      for(i = 0; i < nLanes; i++)
+        arrMoves[i] = BAT_ScalarPlayout(&arrBoards[i], arrTaps[i]);
+      fScalar += TOOL_Now() - fStart;
+
+      //  And with the playouts of samenmcs
+      for(i = 0; i < nLanes; i++)
+        TOOL_Setup(&arrEngine[i], nColumns, nRows, nColors, nGame, nPlayout + i);
+      fStart = TOOL_Now();
+      for(i = 0; i < nLanes; i++)
+        TOOL_EnginePlayout(&arrEngine[i]);
+      fEngine += TOOL_Now() - fStart;
+      for(i = 0; i < nLanes; i++)
+        nEngineScore += arrEngine[i].nScore;
+
+      //  Every lane must have played the scalar game
+      for(i = 0; i < nLanes; i++)
+      {
+        SAGA_BoardInit(&Board, nColumns, nRows, nColors);
+        BAT_Store(&Batch, i, &Board);
+        nBatchScore += Batch.arrScores[i];
+        nScalarScore += arrBoards[i].nScore;
+        nGameScore += arrBoards[i].nScore;
+        if(Batch.arrMoves[i] != arrMoves[i] ||
+           memcmp(Batch.arrTaps[i], arrTaps[i], arrMoves[i] * sizeof(SAGA_Cell)) != 0 ||
+           Board.nScore != arrBoards[i].nScore || Board.nRemaining != arrBoards[i].nRemaining ||
+           Board.nUsedColumns != arrBoards[i].nUsedColumns || Board.nHash != arrBoards[i].nHash ||
+           memcmp(Board.arrRandom, arrBoards[i].arrRandom, sizeof(Board.arrRandom)) != 0)
+        {
+          printf("game %llu playout %llu: batch and scalar engine DIFFER\n", (unsigned long long)nGame,
+                 (unsigned long long)(nPlayout + i));
+          nFailed++;
+        }
+      }
+      nTotal += nLanes;
+    }
+    if(bVerbose)
+      printf("game %llu: %d playouts, average score %.1f\n", (unsigned long long)nGame, nPlayouts,
+             (double)nGameScore / nPlayouts);
+  }
+
+  printf("%lld playouts %dx%d with %d colors in %d lanes, average score %.1f batch, %.1f scalar, "
+         "%.1f board context\n", nTotal, nColumns, nRows, nColors, BAT_LANES,
+         (double)nBatchScore / nTotal, (double)nScalarScore / nTotal,
+         (double)nEngineScore / nTotal);
+  printf("batch %.0f playouts/s, scalar %.0f playouts/s, %.2fx\n", nTotal / fBatch, nTotal / fScalar,
+         fScalar / fBatch);
+  printf("board context %.0f playouts/s like samenmcs, batch %.2fx of it\n", nTotal / fEngine,
+         fEngine / fBatch);
+  return nFailed > 0;
+}
+
+//----------------------------------- END --------------------------------------
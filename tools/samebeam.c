@@ -0,0 +1,632 @@
+/*********************************************************************************/
+/*!
+ * \file      samebeam.c
+ *
+ * \brief     The Same Game v0.1 --> BEAM SEARCH TOOL File
+ *
+ * \details   Host tool which plays numbered games for the highest score with
+ * \n         a beam search. Every layer all moves of all kept positions are
+ * \n         tried, the children are merged by their canonical hash, so
+ * \n         boards with renamed colors too, keeping the better score, and
+ * \n         the best width children are kept for the next layer. The
+ * \n         expansion and the setup of the next layer are split across
+ * \n         the threads by slices of the layer with the parts of beam.c,
+ * \n         the result does not depend on the number of threads.
+ * \n         Only two layers of boards are alive, every layer keeps one
+ * \n         step per position for the line of play, so the memory is
+ * \n         bounded by width x depth. Several widths could be given to
+ * \n         compare score and time.
+ * \n         With -b the moves are generated and played on bitboards,
+ * \n         boards up to 16x7 only. The bitboard has the same canonical
+ * \n         hash, so the search and its result are the same.
+ * \n         With -p the layers are kept as persistent boards, a kept child
+ * \n         only needs new columns for the ones its move changed and
+ * \n         shares the others with its parent. The column pool isn't
+ * \n         locked, so the next layer is set up by one thread, the
+ * \n         expansion still runs on all of them. The result is the same.
+ * \n
+ * \n         samebeam [-w width[,width...]] [-t threads] [-g first game]
+ * \n                  [-n games] [-c columns] [-r rows] [-k colors] [-b]
+ * \n                  [-p] [-v]
+ *
+ * \note      Hardware:    Linux host with pthreads
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "samegame.h"
+#include "bitboard.h"
+#include "persist.h"
+#include "beam.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+#define TOOL_MAXTHREADS  256
+#define TOOL_MAXWIDTHS    32
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // how a kept position was reached
+  int nParent;                         // position in the layer before
+  SAGA_Cell Move;                      // tap
+}TOOL_Step;
+
+typedef struct {  // state of the search of one game
+  SAGA_Board *pLayer;                  // positions of the current layer
+  SAGA_Board *pNext;                   // positions of the next layer
+  int nNodes;                          // number of positions in pLayer
+  int nDepth;                          // moves made to reach pLayer
+  TOOL_Step *pSteps;                   // width steps for every layer
+  BEAM_Child *pChosen;                 // children kept for the next layer
+  int nWidth;                          // positions kept per layer
+  int bBits;                           // expand the positions on bitboards
+  int bPers;                           // keep the layers as persistent boards
+  PERS_Board *pPersLayer;              // positions of the current layer with -p
+  PERS_Board *pPersNext;               // positions of the next layer with -p
+  PERS_Pool Pool;                      // columns of both layers with -p
+  uint32_t nPeakColumns;               // most columns in use at once
+  int nPeakNodes;                      // positions alive at that time
+}TOOL_Beam;
+
+typedef struct {  // thread working on a slice of a layer
+  pthread_t Thread;
+  TOOL_Beam *pBeam;
+  int nFirst, nLast;                   // slice of the layer or of the kept children
+  BEAM_Child *pCandidates;             // children of the slice
+  int nCount, nSize;                   // used and allocated candidates
+  int nBest, nBestScore;               // best finished position of the slice
+}TOOL_Worker;
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Reserve                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Make room for the candidates of a position
+ *
+ * \param     pWorker --> worker, nCount --> number of new candidates
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Reserve(TOOL_Worker *pWorker, int nCount)
+{
+  if(pWorker->nCount + nCount <= pWorker->nSize)
+    return;
+  pWorker->nSize = 2 * pWorker->nSize + SAGA_MAXGROUPS;
+  pWorker->pCandidates = realloc(pWorker->pCandidates, pWorker->nSize * sizeof(BEAM_Child));
+  if(pWorker->pCandidates == NULL)
+  {
+    fprintf(stderr, "samebeam: out of memory\n");
+    exit(2);
+  }
+}
+
+//*==============================================================================*/
+/*  TOOL_ExpandBoard                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Try all moves of one position
+ *
+ * \details   A position without a move is finished, the best of them is
+ * \n         remembered. The others add one candidate for each group.
+ *
+ * \param     pWorker --> worker, pBoard --> position, nNode --> its index
+ * \n         in the layer
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_ExpandBoard(TOOL_Worker *pWorker, const SAGA_Board *pBoard, int nNode)
+{
+  int nGroups;
+
+  TOOL_Reserve(pWorker, SAGA_MAXGROUPS);
+  nGroups = BEAM_ExpandBoard(pBoard, nNode, &pWorker->pCandidates[pWorker->nCount]);
+  if(nGroups == 0 && (pWorker->nBest < 0 || pBoard->nScore > pWorker->nBestScore))
+  {
+    pWorker->nBest = nNode;
+    pWorker->nBestScore = pBoard->nScore;
+  }
+  pWorker->nCount += nGroups;
+}
+
+//*==============================================================================*/
+/*  TOOL_Expand                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Thread function, try all moves of a slice of the layer
+ *
+ * \param     pArg --> worker
+ *
+ * \return    NULL
+ */
+/*===============================================================================*/
+static void *TOOL_Expand(void *pArg)
+{
+  TOOL_Worker *pWorker = pArg;
+  int nNode;
+
+  pWorker->nCount = 0;
+  pWorker->nBest = -1;
+  for(nNode = pWorker->nFirst; nNode < pWorker->nLast; nNode++)
+    TOOL_ExpandBoard(pWorker, &pWorker->pBeam->pLayer[nNode], nNode);
+  return NULL;
+}
+
+//*==============================================================================*/
+/*  TOOL_ExpandPers                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Thread function, try all moves of a slice of persistent boards
+ *
+ * \details   Every position is turned into a board once, its children are
+ * \n         played there. The pool is only read, so all threads share it.
+ *
+ * \param     pArg --> worker
+ *
+ * \return    NULL
+ */
+/*===============================================================================*/
+static void *TOOL_ExpandPers(void *pArg)
+{
+  TOOL_Worker *pWorker = pArg;
+  TOOL_Beam *pBeam = pWorker->pBeam;
+  SAGA_Board Board;
+  int nNode;
+
+  pWorker->nCount = 0;
+  pWorker->nBest = -1;
+  for(nNode = pWorker->nFirst; nNode < pWorker->nLast; nNode++)
+  {
+    PERS_ToBoard(&pBeam->Pool, &pBeam->pPersLayer[nNode], &Board);
+    TOOL_ExpandBoard(pWorker, &Board, nNode);
+  }
+  return NULL;
+}
+
+//*==============================================================================*/
+/*  TOOL_ExpandBits                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Thread function, try all moves of a slice of the layer on bitboards
+ *
+ * \details   Same as TOOL_Expand, but every position is converted into a
+ * \n         bitboard once and its children are played and hashed there.
+ * \n         The score of a child is the score of its parent plus the move.
+ *
+ * \param     pArg --> worker
+ *
+ * \return    NULL
+ */
+/*===============================================================================*/
+static void *TOOL_ExpandBits(void *pArg)
+{
+  TOOL_Worker *pWorker = pArg;
+  TOOL_Beam *pBeam = pWorker->pBeam;
+  BITB_Move arrMoves[SAGA_MAXGROUPS];
+  BITB_Board Bits, Child;
+  BEAM_Child *pCandidate;
+  int i, nNode, nMoves, nScore;
+
+  pWorker->nCount = 0;
+  pWorker->nBest = -1;
+  for(nNode = pWorker->nFirst; nNode < pWorker->nLast; nNode++)
+  {
+    BITB_FromBoard(&Bits, &pBeam->pLayer[nNode]);
+    nMoves = BITB_GenerateMoves(&Bits, arrMoves, SAGA_MAXGROUPS);
+    nScore = pBeam->pLayer[nNode].nScore;
+    if(nMoves == 0)
+    {
+      if(pWorker->nBest < 0 || nScore > pWorker->nBestScore)
+      {
+        pWorker->nBest = nNode;
+        pWorker->nBestScore = nScore;
+      }
+      continue;
+    }
+    TOOL_Reserve(pWorker, nMoves);
+    for(i = 0; i < nMoves; i++)
+    {
+      Child = Bits;
+      BITB_ApplyMove(&Child, &arrMoves[i]);
+      pCandidate = &pWorker->pCandidates[pWorker->nCount++];
+      pCandidate->nHash = BITB_GetCanonicalHash(&Child);
+      pCandidate->nScore = nScore + SAGA_GetMoveScore(arrMoves[i].size) +
+                           (Child.nRemaining == 0 ? SAGA_CLEARBONUS : 0);
+      pCandidate->nParent = nNode;
+      pCandidate->Move.row = arrMoves[i].row;
+      pCandidate->Move.col = arrMoves[i].col;
+    }
+  }
+  return NULL;
+}
+
+//*==============================================================================*/
+/*  TOOL_Advance                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Thread function, set up a slice of the next layer
+ *
+ * \details   The kept children are played again from their parents, their
+ * \n         steps are stored for the line of play.
+ *
+ * \param     pArg --> worker
+ *
+ * \return    NULL
+ */
+/*===============================================================================*/
+static void *TOOL_Advance(void *pArg)
+{
+  TOOL_Worker *pWorker = pArg;
+  TOOL_Beam *pBeam = pWorker->pBeam;
+  TOOL_Step *pSteps = &pBeam->pSteps[(size_t)(pBeam->nDepth + 1) * pBeam->nWidth];
+  int i;
+
+  BEAM_Advance(pBeam->pLayer, pBeam->pChosen, pWorker->nFirst, pWorker->nLast, pBeam->pNext);
+  for(i = pWorker->nFirst; i < pWorker->nLast; i++)
+  {
+    pSteps[i].nParent = pBeam->pChosen[i].nParent;
+    pSteps[i].Move = pBeam->pChosen[i].Move;
+  }
+  return NULL;
+}
+
+//*==============================================================================*/
+/*  TOOL_AdvancePers                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Set up the next layer of persistent boards
+ *
+ * \details   The kept children are played from their parents into new
+ * \n         persistent boards, then the current layer is released and only
+ * \n         the columns the children share stay in the pool.
+ *
+ * \param     pBeam --> search state, nCount --> number of kept children
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_AdvancePers(TOOL_Beam *pBeam, int nCount)
+{
+  TOOL_Step *pSteps = &pBeam->pSteps[(size_t)(pBeam->nDepth + 1) * pBeam->nWidth];
+  const BEAM_Child *pChosen;
+  int i;
+
+  for(i = 0; i < nCount; i++)
+  {
+    pChosen = &pBeam->pChosen[i];
+    if(PERS_DeleteBlocks(&pBeam->Pool, &pBeam->pPersLayer[pChosen->nParent], pChosen->Move.row,
+                         pChosen->Move.col, &pBeam->pPersNext[i]) < 0)
+    {
+      fprintf(stderr, "samebeam: out of memory\n");
+      exit(2);
+    }
+    pSteps[i].nParent = pChosen->nParent;
+    pSteps[i].Move = pChosen->Move;
+  }
+  if(pBeam->Pool.nUsed > pBeam->nPeakColumns)
+  {
+    pBeam->nPeakColumns = pBeam->Pool.nUsed;
+    pBeam->nPeakNodes = pBeam->nNodes + nCount;
+  }
+  for(i = 0; i < pBeam->nNodes; i++)
+    PERS_Release(&pBeam->Pool, &pBeam->pPersLayer[i]);
+}
+
+//*==============================================================================*/
+/*  TOOL_Parallel                                                                */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Run a thread function on slices of a range
+ *
+ * \param     pWorkers --> workers, nThreads --> number of them,
+ * \n         nCount --> range 0 .. nCount - 1, pFunction --> thread function
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Parallel(TOOL_Worker *pWorkers, int nThreads, int nCount,
+                          void *(*pFunction)(void *))
+{
+  int i;
+
+  for(i = 0; i < nThreads; i++)
+  {
+    pWorkers[i].nFirst = (int)((int64_t)nCount * i / nThreads);
+    pWorkers[i].nLast = (int)((int64_t)nCount * (i + 1) / nThreads);
+  }
+  for(i = 1; i < nThreads; i++)
+    pthread_create(&pWorkers[i].Thread, NULL, pFunction, &pWorkers[i]);
+  pFunction(&pWorkers[0]);
+  for(i = 1; i < nThreads; i++)
+    pthread_join(pWorkers[i].Thread, NULL);
+}
+
+//*==============================================================================*/
+/*  TOOL_Search                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Beam search of one board
+ *
+ * \param     pBoard --> start position, pBeam --> search state with the width
+ * \n         and the storage, pWorkers --> workers, nThreads --> number of
+ * \n         them, pMoves --> line of play of the best game
+ *
+ * \return    number of moves of the best game
+ */
+/*===============================================================================*/
+static int TOOL_Search(const SAGA_Board *pBoard, TOOL_Beam *pBeam, TOOL_Worker *pWorkers,
+                       int nThreads, SAGA_Cell *pMoves)
+{
+  BEAM_Child *pAll;
+  SAGA_Board *pSwap;
+  PERS_Board *pPersSwap;
+  int i, nAll, nUnique, nBest = 0, nBestScore = -1, nBestDepth = 0, nSize = 0;
+
+  pAll = NULL;
+  if(!pBeam->bPers)
+    SAGA_BoardCopy(&pBeam->pLayer[0], pBoard);
+  else if(!PERS_FromBoard(&pBeam->Pool, &pBeam->pPersLayer[0], pBoard))
+  {
+    fprintf(stderr, "samebeam: out of memory\n");
+    exit(2);
+  }
+  pBeam->nNodes = 1;
+  for(pBeam->nDepth = 0; pBeam->nNodes > 0; pBeam->nDepth++)
+  {
+    TOOL_Parallel(pWorkers, nThreads, pBeam->nNodes,
+                  pBeam->bBits ? TOOL_ExpandBits : pBeam->bPers ? TOOL_ExpandPers : TOOL_Expand);
+
+    //  Collect the children in slice order and the best finished game
+    for(i = 0, nAll = 0; i < nThreads; i++)
+    {
+      nAll += pWorkers[i].nCount;
+      if(pWorkers[i].nBest >= 0 && pWorkers[i].nBestScore > nBestScore)
+      {
+        nBest = pWorkers[i].nBest;
+        nBestScore = pWorkers[i].nBestScore;
+        nBestDepth = pBeam->nDepth;
+      }
+    }
+    if(nAll == 0)
+      break;
+    if(nAll > nSize)
+    {
+      nSize = nAll;
+      pAll = realloc(pAll, nSize * sizeof(BEAM_Child));
+      if(pAll == NULL)
+      {
+        fprintf(stderr, "samebeam: out of memory\n");
+        exit(2);
+      }
+    }
+    for(i = 0, nAll = 0; i < nThreads; i++)
+    {
+      memcpy(&pAll[nAll], pWorkers[i].pCandidates, pWorkers[i].nCount * sizeof(BEAM_Child));
+      nAll += pWorkers[i].nCount;
+    }
+
+    //  Merge equal positions, then keep the best ones
+    nUnique = BEAM_Select(pAll, nAll, pBeam->nWidth);
+    pBeam->pChosen = pAll;
+    if(pBeam->bPers)
+      TOOL_AdvancePers(pBeam, nUnique);
+    else
+      TOOL_Parallel(pWorkers, nThreads, nUnique, TOOL_Advance);
+    pSwap = pBeam->pLayer;
+    pBeam->pLayer = pBeam->pNext;
+    pBeam->pNext = pSwap;
+    pPersSwap = pBeam->pPersLayer;
+    pBeam->pPersLayer = pBeam->pPersNext;
+    pBeam->pPersNext = pPersSwap;
+    pBeam->nNodes = nUnique;
+  }
+  free(pAll);
+  if(pBeam->bPers)
+    for(i = 0; i < pBeam->nNodes; i++)
+      PERS_Release(&pBeam->Pool, &pBeam->pPersLayer[i]);
+
+  //  Follow the steps back to the start
+  for(i = nBestDepth; i > 0; i--)
+  {
+    pMoves[i - 1] = pBeam->pSteps[(size_t)i * pBeam->nWidth + nBest].Move;
+    nBest = pBeam->pSteps[(size_t)i * pBeam->nWidth + nBest].nParent;
+  }
+  return nBestDepth;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Play all games with every width and report the scores, the
+ * \n         line of play is checked with the engine.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if all lines of play are valid
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static TOOL_Worker arrWorkers[TOOL_MAXTHREADS];
+  int arrWidths[TOOL_MAXWIDTHS] = { 100 };
+  SAGA_Cell arrMoves[SAGA_MAXGROUPS];
+  SAGA_Board Board, Replay;
+  TOOL_Beam Beam;
+  char *pWidth;
+  uint64_t nGame, nFirst = 1;
+  int nThreads = sysconf(_SC_NPROCESSORS_ONLN), nGames = 10, nColumns = NUMOFCOLUMN;
+  int nRows = NUMOFROWS, nColors = NUMOFCOLORS, nWidths = 1, bVerbose = 0, bBits = 0, bPers = 0;
+  int nInvalid = 0;
+  int w, i, nOpt, nMoves, nCleared;
+  double fStart, fTime, fTotal;
+  long long nTotal;
+
+  while((nOpt = getopt(argc, argv, "w:t:g:n:c:r:k:bpv")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'w':
+        for(nWidths = 0, pWidth = strtok(optarg, ","); pWidth != NULL && nWidths < TOOL_MAXWIDTHS;
+            pWidth = strtok(NULL, ","))
+          arrWidths[nWidths++] = atoi(pWidth);
+        break;
+      case 't': nThreads = atoi(optarg); break;
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      case 'b': bBits = 1; break;
+      case 'p': bPers = 1; break;
+      case 'v': bVerbose = 1; break;
+      default:
+        fprintf(stderr, "usage: %s [-w width[,width...]] [-t threads] [-g first game] [-n games] "
+                "[-c columns] [-r rows] [-k colors] [-b] [-p] [-v]\n", argv[0]);
+        return 2;
+    }
+  }
+  if(nThreads < 1 || nThreads > TOOL_MAXTHREADS ||
+     !SAGA_BoardIsValidSize(nColumns, nRows, nColors) || (bBits && bPers))
+  {
+    fprintf(stderr, "%s: board or thread count out of range or both -b and -p\n", argv[0]);
+    return 2;
+  }
+  if(bBits && (nColumns > BITB_MAXCOLUMNS || nRows > BITB_MAXROWS))
+  {
+    fprintf(stderr, "%s: bitboards hold at most %dx%d blocks\n", argv[0], BITB_MAXCOLUMNS,
+            BITB_MAXROWS);
+    return 2;
+  }
+  BITB_Init();
+
+  for(w = 0; w < nWidths; w++)
+  {
+    if(arrWidths[w] < 1)
+      continue;
+    //  A move removes at least two blocks, that limits the depth
+    Beam.nWidth = arrWidths[w];
+    Beam.bBits = bBits;
+    Beam.bPers = bPers;
+    Beam.pLayer = Beam.pNext = NULL;
+    Beam.pPersLayer = Beam.pPersNext = NULL;
+    Beam.nPeakColumns = 0;
+    Beam.nPeakNodes = 1;
+    if(bPers)
+    {
+      Beam.pPersLayer = malloc((size_t)Beam.nWidth * sizeof(PERS_Board));
+      Beam.pPersNext = malloc((size_t)Beam.nWidth * sizeof(PERS_Board));
+    }
+    else
+    {
+      Beam.pLayer = malloc((size_t)Beam.nWidth * sizeof(SAGA_Board));
+      Beam.pNext = malloc((size_t)Beam.nWidth * sizeof(SAGA_Board));
+    }
+    Beam.pSteps = malloc((size_t)Beam.nWidth * (nColumns * nRows / 2 + 1) * sizeof(TOOL_Step));
+    if((bPers ? Beam.pPersLayer == NULL || Beam.pPersNext == NULL ||
+                !PERS_PoolInit(&Beam.Pool, 1024) : Beam.pLayer == NULL || Beam.pNext == NULL) ||
+       Beam.pSteps == NULL)
+    {
+      fprintf(stderr, "%s: no memory for width %d\n", argv[0], Beam.nWidth);
+      return 2;
+    }
+    for(i = 0; i < nThreads; i++)
+      arrWorkers[i].pBeam = &Beam;
+
+    nTotal = 0;
+    nCleared = 0;
+    fTotal = 0;
+    for(nGame = nFirst; nGame < nFirst + nGames; nGame++)
+    {
+      SAGA_BoardInit(&Board, nColumns, nRows, nColors);
+      SAGA_BoardSetupGame(&Board, nGame);
+      fStart = TOOL_Now();
+      nMoves = TOOL_Search(&Board, &Beam, arrWorkers, nThreads, arrMoves);
+      fTime = TOOL_Now() - fStart;
+
+      //  Play the line again to check it and to get its score
+      SAGA_BoardCopy(&Replay, &Board);
+      for(i = 0; i < nMoves; i++)
+        if(SAGA_BoardDeleteBlocks(&Replay, arrMoves[i].row, arrMoves[i].col) < 0)
+          break;
+      if(i < nMoves || !SAGA_BoardIsGameOver(&Replay))
+        nInvalid++;
+      nTotal += Replay.nScore;
+      nCleared += Replay.nRemaining == 0;
+      fTotal += fTime;
+      if(bVerbose)
+      {
+        printf("game %llu width %d: score %d in %d moves%s, %.3f s%s\n", (unsigned long long)nGame,
+               Beam.nWidth, Replay.nScore, nMoves, Replay.nRemaining == 0 ? ", cleared" : "", fTime,
+               i < nMoves ? ", INVALID" : "");
+        for(i = 0; i < nMoves; i++)
+          printf(" %d,%d", arrMoves[i].row, arrMoves[i].col);
+        printf("\n");
+      }
+    }
+    printf("width %d: %d games %dx%d with %d colors on %d threads, average score %.1f, "
+           "%d cleared, %.3f s per game\n", Beam.nWidth, nGames, nColumns, nRows, nColors,
+           nThreads, (double)nTotal / nGames, nCleared, fTotal / nGames);
+    if(bPers)
+    {
+      //  Every kept position has its own record and its share of the columns
+      printf("width %d: persistent layers, at most %u columns for %d positions, %.0f bytes per "
+             "position against %d for a board\n", Beam.nWidth, Beam.nPeakColumns,
+             Beam.nPeakNodes, sizeof(PERS_Board) +
+             (double)Beam.nPeakColumns * sizeof(PERS_Column) / Beam.nPeakNodes,
+             (int)sizeof(SAGA_Board));
+      PERS_PoolFree(&Beam.Pool);
+    }
+    fflush(stdout);
+
+    free(Beam.pLayer);
+    free(Beam.pNext);
+    free(Beam.pPersLayer);
+    free(Beam.pPersNext);
+    free(Beam.pSteps);
+  }
+  for(i = 0; i < nThreads; i++)
+    free(arrWorkers[i].pCandidates);
+  return nInvalid > 0;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,650 @@
+/*********************************************************************************/
+/*!
+ * \file      samebench.c
+ *
+ * \brief     The Same Game v0.1 --> BENCHMARK TOOL File
+ *
+ * \details   Host tool which times the moves and the game over check of the
+ * \n         engine against the engine of v0.1, a board of int rows which
+ * \n         are allocated one by one, a recursive delete and a compaction
+ * \n         of the whole board. Random lines of play of numbered games are
+ * \n         recorded first, then every engine replays the same lines,
+ * \n         once with the moves only and once with TOOL_REPEAT game over
+ * \n         checks after every move. The setup of a game is not timed,
+ * \n         the difference of both passes is the cost of the checks. The
+ * \n         engine runs twice, with the kernels of its board height and
+ * \n         with the generic kernels, so the gain of the specialization
+ * \n         is measured on the same lines. The engines take turns pass by
+ * \n         pass, the fastest pass counts. Every engine must delete the
+ * \n         same blocks and end with the same board as the recording.
+ * \n
+ * \n         samebench [-g first game] [-n games] [-p passes] [-c columns]
+ * \n                   [-r rows] [-k colors]
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "samegame.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// what a pass over all games does
+#define TOOL_MOVES  0
+#define TOOL_OVER   1
+
+// game over checks after every move, one alone is too fast to time
+#define TOOL_REPEAT  8
+
+// directions of the recursive delete of v0.1
+#define TOOL_UP     0
+#define TOOL_DOWN   1
+#define TOOL_LEFT   2
+#define TOOL_RIGHT  3
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // board of v0.1, one allocated row of ints per board row
+  int **arrBoard;                      // blocks, row 0 is the top row
+  int nColumns, nRows;                 // board size information
+  int nRemaining;                      // number of remaining blocks
+}TOOL_OldBoard;
+
+typedef struct {  // engine under test, pState is its board
+  const char *pName;
+  void (*pLoad)(void *pState, const SAGA_Board *pStart);
+  int (*pDelete)(void *pState, int row, int col);
+  bool (*pIsGameOver)(void *pState);
+  int (*pGetBlock)(void *pState, int row, int col);
+  void *pState;
+}TOOL_Engine;
+
+typedef struct {  // recorded lines of play of all games
+  SAGA_Board *pStarts;                 // start position of every game
+  SAGA_Board *pEnds;                   // position after the line
+  SAGA_Cell *pTaps;                    // taps of all games one after the other
+  unsigned short *pCounts;             // blocks deleted by every tap
+  int *pFirst;                         // first tap of every game, one more for the end
+  int nGames;
+}TOOL_Lines;
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+/*-------------------------------------------------------------------------------*/
+/*  Engine of v0.1                                                               */
+/*-------------------------------------------------------------------------------*/
+
+//*==============================================================================*/
+/*  TOOL_OldCreate                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Allocate a board of v0.1
+ *
+ * \param     pOld --> board, nColumns, nRows
+ *
+ * \return    false if there is no memory
+ */
+/*===============================================================================*/
+static bool TOOL_OldCreate(TOOL_OldBoard *pOld, int nColumns, int nRows)
+{
+  int row;
+
+  pOld->nColumns = nColumns;
+  pOld->nRows = nRows;
+  pOld->arrBoard = malloc(nRows * sizeof(int*));
+  if(pOld->arrBoard == NULL)
+    return false;
+  for(row = 0; row < nRows; row++)
+    if((pOld->arrBoard[row] = calloc(nColumns, sizeof(int))) == NULL)
+      return false;
+  return true;
+}
+
+//*==============================================================================*/
+/*  TOOL_OldLoad                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Copy a start position into a board of v0.1
+ *
+ * \param     pState --> board of v0.1, pStart --> position
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_OldLoad(void *pState, const SAGA_Board *pStart)
+{
+  TOOL_OldBoard *pOld = pState;
+  int row, col;
+
+  for(row = 0; row < pOld->nRows; row++)
+    for(col = 0; col < pOld->nColumns; col++)
+      pOld->arrBoard[row][col] = SAGA_BoardGetBlock(pStart, row, col);
+  pOld->nRemaining = pStart->nRemaining;
+}
+
+//*==============================================================================*/
+/*  TOOL_OldDeleteNeighbors                                                      */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Recursive delete of v0.1
+ *
+ * \param     pOld --> board, row, column, color, nFrom --> direction not to
+ * \n         go back to
+ *
+ * \return    number of deleted blocks
+ */
+/*===============================================================================*/
+static int TOOL_OldDeleteNeighbors(TOOL_OldBoard *pOld, int row, int col, int color, int nFrom)
+{
+  int nCount = 1;
+
+  if(row < 0 || row >= pOld->nRows || col < 0 || col >= pOld->nColumns)
+    return 0;
+  if(pOld->arrBoard[row][col] != color)
+    return 0;
+
+  pOld->arrBoard[row][col] = 0;
+  if(nFrom != TOOL_UP)
+    nCount += TOOL_OldDeleteNeighbors(pOld, row - 1, col, color, TOOL_DOWN);
+  if(nFrom != TOOL_DOWN)
+    nCount += TOOL_OldDeleteNeighbors(pOld, row + 1, col, color, TOOL_UP);
+  if(nFrom != TOOL_LEFT)
+    nCount += TOOL_OldDeleteNeighbors(pOld, row, col - 1, color, TOOL_RIGHT);
+  if(nFrom != TOOL_RIGHT)
+    nCount += TOOL_OldDeleteNeighbors(pOld, row, col + 1, color, TOOL_LEFT);
+  return nCount;
+}
+
+//*==============================================================================*/
+/*  TOOL_OldCompact                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compaction of v0.1
+ *
+ * \details   Every column falls down, then every empty column is closed,
+ * \n         always over the whole board.
+ *
+ * \param     pOld --> board
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_OldCompact(TOOL_OldBoard *pOld)
+{
+  int **arrBoard = pOld->arrBoard;
+  int nEmpty, nOccupied, row, col;
+
+  for(col = 0; col < pOld->nColumns; col++)
+  {
+    nEmpty = nOccupied = pOld->nRows - 1;
+    while(nOccupied >= 0 && nEmpty >= 0)
+    {
+      while(nEmpty >= 0 && arrBoard[nEmpty][col] != 0)
+        nEmpty--;
+      if(nEmpty >= 0)
+      {
+        nOccupied = nEmpty - 1;
+        while(nOccupied >= 0 && arrBoard[nOccupied][col] == 0)
+          nOccupied--;
+        if(nOccupied >= 0)
+        {
+          arrBoard[nEmpty][col] = arrBoard[nOccupied][col];
+          arrBoard[nOccupied][col] = 0;
+        }
+      }
+    }
+  }
+
+  nEmpty = nOccupied = 0;
+  while(nEmpty < pOld->nColumns && nOccupied < pOld->nColumns)
+  {
+    while(nEmpty < pOld->nColumns && arrBoard[pOld->nRows - 1][nEmpty] != 0)
+      nEmpty++;
+    if(nEmpty < pOld->nColumns)
+    {
+      nOccupied = nEmpty + 1;
+      while(nOccupied < pOld->nColumns && arrBoard[pOld->nRows - 1][nOccupied] == 0)
+        nOccupied++;
+      if(nOccupied < pOld->nColumns)
+        for(row = 0; row < pOld->nRows; row++)
+        {
+          arrBoard[row][nEmpty] = arrBoard[row][nOccupied];
+          arrBoard[row][nOccupied] = 0;
+        }
+    }
+  }
+}
+
+//*==============================================================================*/
+/*  TOOL_OldDelete                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Move of v0.1
+ *
+ * \param     pState --> board of v0.1, row, column
+ *
+ * \return    number of deleted blocks, -1 if no move
+ */
+/*===============================================================================*/
+static int TOOL_OldDelete(void *pState, int row, int col)
+{
+  TOOL_OldBoard *pOld = pState;
+  int **arrBoard = pOld->arrBoard;
+  int nColor, nCount = -1;
+
+  if(row < 0 || row >= pOld->nRows || col < 0 || col >= pOld->nColumns)
+    return -1;
+  nColor = arrBoard[row][col];
+  if(nColor == 0)
+    return -1;
+
+  if((row - 1 >= 0 && arrBoard[row - 1][col] == nColor) ||
+     (row + 1 < pOld->nRows && arrBoard[row + 1][col] == nColor) ||
+     (col - 1 >= 0 && arrBoard[row][col - 1] == nColor) ||
+     (col + 1 < pOld->nColumns && arrBoard[row][col + 1] == nColor))
+  {
+    arrBoard[row][col] = 0;
+    nCount = 1;
+    nCount += TOOL_OldDeleteNeighbors(pOld, row - 1, col, nColor, TOOL_DOWN);
+    nCount += TOOL_OldDeleteNeighbors(pOld, row + 1, col, nColor, TOOL_UP);
+    nCount += TOOL_OldDeleteNeighbors(pOld, row, col - 1, nColor, TOOL_RIGHT);
+    nCount += TOOL_OldDeleteNeighbors(pOld, row, col + 1, nColor, TOOL_LEFT);
+    TOOL_OldCompact(pOld);
+    pOld->nRemaining -= nCount;
+  }
+  return nCount;
+}
+
+//*==============================================================================*/
+/*  TOOL_OldIsGameOver                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Game over check of v0.1
+ *
+ * \details   Every column from the bottom up to the first background block,
+ * \n         each block is compared with the one above and the one right.
+ *
+ * \param     pState --> board of v0.1
+ *
+ * \return    true if there is no move
+ */
+/*===============================================================================*/
+static bool TOOL_OldIsGameOver(void *pState)
+{
+  TOOL_OldBoard *pOld = pState;
+  int row, col, nColor;
+
+  for(col = 0; col < pOld->nColumns; col++)
+    for(row = pOld->nRows - 1; row >= 0; row--)
+    {
+      nColor = pOld->arrBoard[row][col];
+      if(nColor == 0)
+        break;
+      if(row - 1 >= 0 && pOld->arrBoard[row - 1][col] == nColor)
+        return false;
+      if(col + 1 < pOld->nColumns && pOld->arrBoard[row][col + 1] == nColor)
+        return false;
+    }
+  return true;
+}
+
+//*==============================================================================*/
+/*  TOOL_OldGetBlock                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Block of a board of v0.1
+ *
+ * \param     pState --> board of v0.1, row, column
+ *
+ * \return    color index
+ */
+/*===============================================================================*/
+static int TOOL_OldGetBlock(void *pState, int row, int col)
+{
+  return ((TOOL_OldBoard*)pState)->arrBoard[row][col];
+}
+
+/*-------------------------------------------------------------------------------*/
+/*  Engine of the game                                                           */
+/*-------------------------------------------------------------------------------*/
+
+//*==============================================================================*/
+/*  TOOL_BoardLoad                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Copy a start position into a board context
+ *
+ * \param     pState --> board context, pStart --> position
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_BoardLoad(void *pState, const SAGA_Board *pStart)
+{
+  SAGA_BoardCopy(pState, pStart);
+}
+
+//*==============================================================================*/
+/*  TOOL_GenericLoad                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Copy a start position into a board context with generic kernels
+ *
+ * \details   The kernels of the specialized board heights are switched off,
+ * \n         so both kernels play the same lines.
+ *
+ * \param     pState --> board context, pStart --> position
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_GenericLoad(void *pState, const SAGA_Board *pStart)
+{
+  SAGA_BoardCopy(pState, pStart);
+  ((SAGA_Board *)pState)->nKernel = 0;
+}
+
+//*==============================================================================*/
+/*  TOOL_BoardDelete                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Move of the engine
+ *
+ * \param     pState --> board context, row, column
+ *
+ * \return    number of deleted blocks, -1 if no move
+ */
+/*===============================================================================*/
+static int TOOL_BoardDelete(void *pState, int row, int col)
+{
+  return SAGA_BoardDeleteBlocks(pState, row, col);
+}
+
+//*==============================================================================*/
+/*  TOOL_BoardIsGameOver                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Game over check of the engine
+ *
+ * \param     pState --> board context
+ *
+ * \return    true if there is no move
+ */
+/*===============================================================================*/
+static bool TOOL_BoardIsGameOver(void *pState)
+{
+  return SAGA_BoardIsGameOver(pState);
+}
+
+//*==============================================================================*/
+/*  TOOL_BoardGetBlock                                                           */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Block of a board context
+ *
+ * \param     pState --> board context, row, column
+ *
+ * \return    color index
+ */
+/*===============================================================================*/
+static int TOOL_BoardGetBlock(void *pState, int row, int col)
+{
+  return SAGA_BoardGetBlock(pState, row, col);
+}
+
+/*-------------------------------------------------------------------------------*/
+/*  Benchmark                                                                    */
+/*-------------------------------------------------------------------------------*/
+
+//*==============================================================================*/
+/*  TOOL_Record                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Record random lines of play
+ *
+ * \details   Every game taps random groups, drawn with the generator of its
+ * \n         board, until there is no move left.
+ *
+ * \param     pLines --> lines, nFirst --> first game, nGames --> games,
+ * \n         nColumns, nRows, nColors
+ *
+ * \return    false if there is no memory
+ */
+/*===============================================================================*/
+static bool TOOL_Record(TOOL_Lines *pLines, uint64_t nFirst, int nGames, int nColumns, int nRows,
+                        int nColors)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Board *pBoard;
+  int nMax = nGames * (nColumns * nRows / 2), nTaps = 0, nGroups, g;
+
+  pLines->nGames = nGames;
+  pLines->pStarts = malloc(nGames * sizeof(SAGA_Board));
+  pLines->pEnds = malloc(nGames * sizeof(SAGA_Board));
+  pLines->pTaps = malloc(nMax * sizeof(SAGA_Cell));
+  pLines->pCounts = malloc(nMax * sizeof(unsigned short));
+  pLines->pFirst = malloc((nGames + 1) * sizeof(int));
+  if(!pLines->pStarts || !pLines->pEnds || !pLines->pTaps || !pLines->pCounts || !pLines->pFirst)
+    return false;
+
+  for(g = 0; g < nGames; g++)
+  {
+    SAGA_BoardInit(&pLines->pStarts[g], nColumns, nRows, nColors);
+    SAGA_BoardSetupGame(&pLines->pStarts[g], nFirst + g);
+    pBoard = &pLines->pEnds[g];
+    SAGA_BoardCopy(pBoard, &pLines->pStarts[g]);
+    pLines->pFirst[g] = nTaps;
+    while((nGroups = SAGA_BoardEnumerateMoves(pBoard, arrGroups, SAGA_MAXGROUPS, NULL)) > 0)
+    {
+      nGroups = SAGA_BoardRandom(pBoard) % nGroups;
+      pLines->pTaps[nTaps].row = arrGroups[nGroups].row;
+      pLines->pTaps[nTaps].col = arrGroups[nGroups].col;
+      pLines->pCounts[nTaps++] = SAGA_BoardDeleteBlocks(pBoard, arrGroups[nGroups].row,
+                                                        arrGroups[nGroups].col);
+    }
+  }
+  pLines->pFirst[nGames] = nTaps;
+  return true;
+}
+
+//*==============================================================================*/
+/*  TOOL_Pass                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Replay all lines with an engine
+ *
+ * \details   Only the moves of every game are timed, not its setup.
+ *
+ * \param     pEngine --> engine, pLines --> lines, nWork --> TOOL_MOVES or
+ * \n         TOOL_OVER
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Pass(const TOOL_Engine *pEngine, const TOOL_Lines *pLines, int nWork)
+{
+  const SAGA_Cell *pTap;
+  double fStart, fTime = 0;
+  int g, i, n, nSum = 0;
+
+  for(g = 0; g < pLines->nGames; g++)
+  {
+    pEngine->pLoad(pEngine->pState, &pLines->pStarts[g]);
+    fStart = TOOL_Now();
+    for(i = pLines->pFirst[g]; i < pLines->pFirst[g + 1]; i++)
+    {
+      pTap = &pLines->pTaps[i];
+      nSum += pEngine->pDelete(pEngine->pState, pTap->row, pTap->col);
+      for(n = nWork == TOOL_OVER ? TOOL_REPEAT : 0; n > 0; n--)
+        nSum += pEngine->pIsGameOver(pEngine->pState);
+    }
+    fTime += TOOL_Now() - fStart;
+  }
+
+  //  Keeps the compiler from dropping the work
+  if(nSum == -1)
+    printf("\n");
+  return fTime;
+}
+
+//*==============================================================================*/
+/*  TOOL_Check                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compare an engine with the recording
+ *
+ * \details   Every tap must delete the recorded blocks, the game is only
+ * \n         over after the last one and the board must end like recorded.
+ *
+ * \param     pEngine --> engine, pLines --> lines
+ *
+ * \return    number of games which differ
+ */
+/*===============================================================================*/
+static int TOOL_Check(const TOOL_Engine *pEngine, const TOOL_Lines *pLines)
+{
+  const SAGA_Board *pEnd;
+  const SAGA_Cell *pTap;
+  int g, i, row, col, nLast, nWrong = 0;
+
+  for(g = 0; g < pLines->nGames; g++)
+  {
+    pEngine->pLoad(pEngine->pState, &pLines->pStarts[g]);
+    nLast = pLines->pFirst[g + 1] - 1;
+    for(i = pLines->pFirst[g]; i <= nLast; i++)
+    {
+      pTap = &pLines->pTaps[i];
+      if(pEngine->pDelete(pEngine->pState, pTap->row, pTap->col) != pLines->pCounts[i] ||
+         pEngine->pIsGameOver(pEngine->pState) != (i == nLast))
+        break;
+    }
+    pEnd = &pLines->pEnds[g];
+    for(row = 0; row < pEnd->nRows && i > nLast; row++)
+      for(col = 0; col < pEnd->nColumns; col++)
+        if(pEngine->pGetBlock(pEngine->pState, row, col) != SAGA_BoardGetBlock(pEnd, row, col))
+          i = -1;
+    nWrong += i <= nLast;
+  }
+  return nWrong;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Record the lines, check every engine on them and time the
+ * \n         passes.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if every engine played the recorded games
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static TOOL_OldBoard Old;
+  static SAGA_Board Board, Generic;
+  TOOL_Engine arrEngines[] =
+  {
+    { "v0.1 int rows", TOOL_OldLoad, TOOL_OldDelete, TOOL_OldIsGameOver, TOOL_OldGetBlock, &Old },
+    { "board context", TOOL_BoardLoad, TOOL_BoardDelete, TOOL_BoardIsGameOver, TOOL_BoardGetBlock,
+      &Board },
+    { "generic kernels", TOOL_GenericLoad, TOOL_BoardDelete, TOOL_BoardIsGameOver,
+      TOOL_BoardGetBlock, &Generic },
+  };
+  const int nEngines = sizeof(arrEngines) / sizeof(arrEngines[0]);
+  double arrTimes[sizeof(arrEngines) / sizeof(arrEngines[0])][2], fTime;
+  int arrWrong[sizeof(arrEngines) / sizeof(arrEngines[0])];
+  TOOL_Lines Lines;
+  uint64_t nFirst = 1;
+  int nGames = 20000, nPasses = 5, nColumns = NUMOFCOLUMN, nRows = NUMOFROWS;
+  int nColors = NUMOFCOLORS, nMoves, nFailed = 0, e, p, w, nOpt;
+
+  while((nOpt = getopt(argc, argv, "g:n:p:c:r:k:")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'p': nPasses = atoi(optarg); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-g first game] [-n games] [-p passes] [-c columns] [-r rows] "
+                "[-k colors]\n", argv[0]);
+        return 2;
+    }
+  }
+  if(nGames < 1 || nPasses < 1 || !SAGA_BoardIsValidSize(nColumns, nRows, nColors))
+  {
+    fprintf(stderr, "%s: board, games or passes out of range\n", argv[0]);
+    return 2;
+  }
+  if(!TOOL_Record(&Lines, nFirst, nGames, nColumns, nRows, nColors) ||
+     !TOOL_OldCreate(&Old, nColumns, nRows))
+  {
+    fprintf(stderr, "%s: no memory for %d games\n", argv[0], nGames);
+    return 2;
+  }
+  SAGA_BoardInit(&Board, nColumns, nRows, nColors);
+  nMoves = Lines.pFirst[nGames];
+  printf("%d games %dx%d with %d colors, %d moves, best of %d passes\n", nGames, nColumns, nRows,
+         nColors, nMoves, nPasses);
+
+  for(e = 0; e < nEngines; e++)
+  {
+    arrWrong[e] = TOOL_Check(&arrEngines[e], &Lines);
+    nFailed += arrWrong[e];
+    arrTimes[e][TOOL_MOVES] = arrTimes[e][TOOL_OVER] = 1e30;
+  }
+  for(p = 0; p < nPasses; p++)
+    for(e = 0; e < nEngines; e++)
+      for(w = TOOL_MOVES; w <= TOOL_OVER; w++)
+        if((fTime = TOOL_Pass(&arrEngines[e], &Lines, w)) < arrTimes[e][w])
+          arrTimes[e][w] = fTime;
+  for(e = 0; e < nEngines; e++)
+    printf("%-24s move %6.1f ns, game over %6.1f ns%s\n", arrEngines[e].pName,
+           arrTimes[e][TOOL_MOVES] * 1e9 / nMoves,
+           (arrTimes[e][TOOL_OVER] - arrTimes[e][TOOL_MOVES]) * 1e9 / nMoves / TOOL_REPEAT,
+           arrWrong[e] > 0 ? ", DIFFERENT games" : "");
+  return nFailed > 0;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,308 @@
+/*********************************************************************************/
+/*!
+ * \file      samebits.c
+ *
+ * \brief     The Same Game v0.1 --> BITBOARD TEST TOOL File
+ *
+ * \details   Host tool which checks the bitboard against the engine and
+ * \n         times both. Random lines of play of numbered games are played
+ * \n         with the engine, at every position the bitboard must hold the
+ * \n         same blocks, find the same moves and give the same children,
+ * \n         remaining blocks and canonical hashes. Then all positions are
+ * \n         expanded by both, like a beam search does it: the moves are
+ * \n         generated and every child is played and hashed. The engines
+ * \n         take turns pass by pass, the fastest pass counts.
+ * \n
+ * \n         samebits [-g first game] [-n games] [-p passes] [-c columns]
+ * \n                  [-r rows] [-k colors]
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "samegame.h"
+#include "bitboard.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// what a pass over all positions does
+#define TOOL_MOVES     0
+#define TOOL_CHILDREN  1
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Check                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compare the bitboard with the engine at one position
+ *
+ * \details   Both must find the same number of moves, every move of the
+ * \n         bitboard must delete as many blocks with the engine and both
+ * \n         children must be equal and have the same canonical hash.
+ * \n         The moves of the bitboard don't overlap, so equal counts mean
+ * \n         equal moves.
+ *
+ * \param     pBoard --> position, nGame --> game number for the report
+ *
+ * \return    number of differences
+ */
+/*===============================================================================*/
+static int TOOL_Check(const SAGA_Board *pBoard, uint64_t nGame)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  BITB_Move arrMoves[SAGA_MAXGROUPS];
+  BITB_Board Bits, Child;
+  SAGA_Board Copy;
+  int i, nGroups, nMoves, nWrong = 0;
+
+  BITB_FromBoard(&Bits, pBoard);
+  nGroups = SAGA_BoardEnumerateMoves(pBoard, arrGroups, SAGA_MAXGROUPS, NULL);
+  nMoves = BITB_GenerateMoves(&Bits, arrMoves, SAGA_MAXGROUPS);
+  if(!BITB_Equals(&Bits, pBoard) || nGroups != nMoves ||
+     BITB_IsGameOver(&Bits) != SAGA_BoardIsGameOver(pBoard) ||
+     BITB_GetCanonicalHash(&Bits) != SAGA_BoardGetCanonicalHash(pBoard))
+  {
+    printf("game %llu: bitboard differs with %d blocks left\n", (unsigned long long)nGame,
+           pBoard->nRemaining);
+    return 1;
+  }
+  for(i = 0; i < nMoves; i++)
+  {
+    Child = Bits;
+    BITB_ApplyMove(&Child, &arrMoves[i]);
+    SAGA_BoardCopy(&Copy, pBoard);
+    if(SAGA_BoardDeleteBlocks(&Copy, arrMoves[i].row, arrMoves[i].col) != arrMoves[i].size ||
+       !BITB_Equals(&Child, &Copy) ||
+       BITB_GetCanonicalHash(&Child) != SAGA_BoardGetCanonicalHash(&Copy))
+    {
+      printf("game %llu: move %d,%d differs with %d blocks left\n", (unsigned long long)nGame,
+             arrMoves[i].row, arrMoves[i].col, pBoard->nRemaining);
+      nWrong++;
+    }
+  }
+  return nWrong;
+}
+
+//*==============================================================================*/
+/*  TOOL_ExpandBoard                                                             */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Expand a position with the engine
+ *
+ * \param     pBoard --> position, nWork --> TOOL_MOVES or TOOL_CHILDREN
+ *
+ * \return    number of moves plus the sum of the hashes of the children
+ */
+/*===============================================================================*/
+static uint64_t TOOL_ExpandBoard(const SAGA_Board *pBoard, int nWork)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Board Child;
+  uint64_t nSum;
+  int i, nGroups;
+
+  nSum = nGroups = SAGA_BoardEnumerateMoves(pBoard, arrGroups, SAGA_MAXGROUPS, NULL);
+  if(nWork == TOOL_CHILDREN)
+    for(i = 0; i < nGroups; i++)
+    {
+      SAGA_BoardCopy(&Child, pBoard);
+      SAGA_BoardDeleteBlocks(&Child, arrGroups[i].row, arrGroups[i].col);
+      nSum += SAGA_BoardGetCanonicalHash(&Child);
+    }
+  return nSum;
+}
+
+//*==============================================================================*/
+/*  TOOL_ExpandBits                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Expand a position on a bitboard
+ *
+ * \details   The conversion of the position is part of the work, a search
+ * \n         keeps its positions as board contexts.
+ *
+ * \param     pBoard --> position, nWork --> TOOL_MOVES or TOOL_CHILDREN
+ *
+ * \return    number of moves plus the sum of the hashes of the children
+ */
+/*===============================================================================*/
+static uint64_t TOOL_ExpandBits(const SAGA_Board *pBoard, int nWork)
+{
+  BITB_Move arrMoves[SAGA_MAXGROUPS];
+  BITB_Board Bits, Child;
+  uint64_t nSum;
+  int i, nMoves;
+
+  BITB_FromBoard(&Bits, pBoard);
+  nSum = nMoves = BITB_GenerateMoves(&Bits, arrMoves, SAGA_MAXGROUPS);
+  if(nWork == TOOL_CHILDREN)
+    for(i = 0; i < nMoves; i++)
+    {
+      Child = Bits;
+      BITB_ApplyMove(&Child, &arrMoves[i]);
+      nSum += BITB_GetCanonicalHash(&Child);
+    }
+  return nSum;
+}
+
+//*==============================================================================*/
+/*  TOOL_Pass                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Expand all positions once
+ *
+ * \param     pExpand --> expansion, pPositions --> positions, nPositions,
+ * \n         nWork --> TOOL_MOVES or TOOL_CHILDREN, pSum --> checksum
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Pass(uint64_t (*pExpand)(const SAGA_Board *, int), const SAGA_Board *pPositions,
+                        int nPositions, int nWork, uint64_t *pSum)
+{
+  double fStart = TOOL_Now();
+  uint64_t nSum = 0;
+  int i;
+
+  for(i = 0; i < nPositions; i++)
+    nSum += pExpand(&pPositions[i], nWork);
+  *pSum = nSum;
+  return TOOL_Now() - fStart;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Check the bitboard at every position of the lines of play, then
+ * \n         time the expansion of all positions with both engines.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if the bitboard matches the engine everywhere
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static const char *arrNames[2] = { "board context", "bitboard" };
+  uint64_t (*arrExpand[2])(const SAGA_Board *, int) = { TOOL_ExpandBoard, TOOL_ExpandBits };
+  double arrTimes[2][2], fTime;
+  uint64_t arrSums[2][2];
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Board Board, *pPositions;
+  uint64_t nGame, nFirst = 1;
+  int nGames = 2000, nPasses = 5, nColumns = NUMOFCOLUMN, nRows = NUMOFROWS;
+  int nColors = NUMOFCOLORS, nPositions = 0, nChildren = 0, nWrong = 0, nGroups, e, p, w, nOpt;
+
+  while((nOpt = getopt(argc, argv, "g:n:p:c:r:k:")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'p': nPasses = atoi(optarg); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-g first game] [-n games] [-p passes] [-c columns] [-r rows] "
+                "[-k colors]\n", argv[0]);
+        return 2;
+    }
+  }
+  if(nGames < 1 || nPasses < 1 || !SAGA_BoardIsValidSize(nColumns, nRows, nColors) ||
+     nColumns > BITB_MAXCOLUMNS || nRows > BITB_MAXROWS)
+  {
+    fprintf(stderr, "%s: board, games or passes out of range, bitboards hold at most %dx%d "
+            "blocks\n", argv[0], BITB_MAXCOLUMNS, BITB_MAXROWS);
+    return 2;
+  }
+  //  A line of play has at most one position per two blocks and the end
+  pPositions = malloc((size_t)nGames * (nColumns * nRows / 2 + 1) * sizeof(SAGA_Board));
+  if(pPositions == NULL)
+  {
+    fprintf(stderr, "%s: no memory for %d games\n", argv[0], nGames);
+    return 2;
+  }
+  BITB_Init();
+
+  for(nGame = nFirst; nGame < nFirst + nGames; nGame++)
+  {
+    SAGA_BoardInit(&Board, nColumns, nRows, nColors);
+    SAGA_BoardSetupGame(&Board, nGame);
+    for(;;)
+    {
+      SAGA_BoardCopy(&pPositions[nPositions++], &Board);
+      nWrong += TOOL_Check(&Board, nGame);
+      nGroups = SAGA_BoardEnumerateMoves(&Board, arrGroups, SAGA_MAXGROUPS, NULL);
+      if(nGroups == 0)
+        break;
+      nChildren += nGroups;
+      nGroups = SAGA_BoardRandom(&Board) % nGroups;
+      SAGA_BoardDeleteBlocks(&Board, arrGroups[nGroups].row, arrGroups[nGroups].col);
+    }
+  }
+  printf("%d games %dx%d with %d colors, %d positions, %d children, %d differences, best of %d "
+         "passes\n", nGames, nColumns, nRows, nColors, nPositions, nChildren, nWrong, nPasses);
+
+  for(e = 0; e < 2; e++)
+    arrTimes[e][TOOL_MOVES] = arrTimes[e][TOOL_CHILDREN] = 1e30;
+  for(p = 0; p < nPasses; p++)
+    for(e = 0; e < 2; e++)
+      for(w = TOOL_MOVES; w <= TOOL_CHILDREN; w++)
+        if((fTime = TOOL_Pass(arrExpand[e], pPositions, nPositions, w, &arrSums[e][w])) <
+           arrTimes[e][w])
+          arrTimes[e][w] = fTime;
+  for(w = TOOL_MOVES; w <= TOOL_CHILDREN; w++)
+    if(arrSums[0][w] != arrSums[1][w])
+      nWrong++;
+  nChildren = nChildren > 0 ? nChildren : 1;
+  for(e = 0; e < 2; e++)
+    printf("%-16s moves %7.1f ns per position, children %6.1f ns per child\n", arrNames[e],
+           arrTimes[e][TOOL_MOVES] * 1e9 / nPositions,
+           (arrTimes[e][TOOL_CHILDREN] - arrTimes[e][TOOL_MOVES]) * 1e9 / nChildren);
+  printf("bitboard %.1fx faster for the moves, %.1fx for the whole expansion%s\n",
+         arrTimes[0][TOOL_MOVES] / arrTimes[1][TOOL_MOVES],
+         arrTimes[0][TOOL_CHILDREN] / arrTimes[1][TOOL_CHILDREN],
+         nWrong > 0 ? ", DIFFERENT results" : "");
+  free(pPositions);
+  return nWrong > 0;
+}
+
+//----------------------------------- END --------------------------------------
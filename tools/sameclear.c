@@ -0,0 +1,253 @@
+/*********************************************************************************/
+/*!
+ * \file      sameclear.c
+ *
+ * \brief     The Same Game v0.1 --> CLEARABLE BOARD TEST TOOL File
+ *
+ * \details   Host tool which stress tests the setup of boards which could
+ * \n         be cleared. Numbered clearable games of every board size up
+ * \n         to the given one and every number of colors are built, the
+ * \n         reverse moves of each one must clear it and its game number
+ * \n         must give the same board again. The moves found on the board
+ * \n         must agree with its pair count. A board the setup gave up on
+ * \n         gets a random setup, small ones of them are solved exactly to
+ * \n         tell whether they are dead or a clearable board was missed.
+ * \n
+ * \n         sameclear [-g first game] [-n games] [-c columns] [-r rows]
+ * \n                   [-k colors] [-b blocks] [-v]
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "solver.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // counters of one board size and color count or of all
+  long long nBoards;                   // boards built
+  long long nMoves;                    // moves of all solutions
+  long long nRandom;                   // boards the setup gave up on
+  long long nDead;                     // of them proven dead by the solver
+  long long nMissed;                   // of them cleared by the solver
+  long long nInvalid;                  // solutions which don't clear the board
+  long long nReplay;                   // game numbers which give another board
+  long long nMoveList;                 // boards whose moves don't agree with the pairs
+}TOOL_Count;
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Check                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Build one clearable game and check it
+ *
+ * \param     nColumns, nRows, nColors --> board, nGame --> game number,
+ * \n         nBlocks --> largest board for the solver, pDead --> table of
+ * \n         the solver, pCount --> counters
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Check(int nColumns, int nRows, int nColors, uint64_t nGame, int nBlocks,
+                       SOLV_Table *pDead, TOOL_Count *pCount)
+{
+  SAGA_Cell arrSolution[SAGA_MAXGROUPS];
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Board Board, Replay;
+  int nMoves, nResult, nStop = 0;
+
+  SAGA_BoardInit(&Board, nColumns, nRows, nColors);
+  nMoves = SAGA_BoardSetupClearableGame(&Board, nGame, arrSolution);
+  pCount->nBoards++;
+
+  //  The stored number must give the same board
+  SAGA_BoardInit(&Replay, nColumns, nRows, nColors);
+  SAGA_BoardSetupGame(&Replay, Board.nGame);
+  if(!(Board.nGame & SAGA_CLEARABLEGAME) || Replay.nHash != Board.nHash ||
+     memcmp(Replay.arrCells, Board.arrCells, sizeof(Board.arrCells)) != 0)
+  {
+    printf("%dx%d with %d colors, game %llu: the game number gives another board\n", nColumns,
+           nRows, nColors, (unsigned long long)nGame);
+    pCount->nReplay++;
+  }
+
+  //  A group of every block of the board must be found as well
+  if((SAGA_BoardEnumerateMoves(&Board, arrGroups, SAGA_MAXGROUPS, NULL) == 0) !=
+     SAGA_BoardIsGameOver(&Board))
+  {
+    printf("%dx%d with %d colors, game %llu: the moves don't agree with the pairs\n", nColumns,
+           nRows, nColors, (unsigned long long)nGame);
+    pCount->nMoveList++;
+  }
+
+  if(nMoves >= 0)
+  {
+    pCount->nMoves += nMoves;
+    if(!SAGA_BoardVerifySolution(&Board, arrSolution, nMoves))
+    {
+      printf("%dx%d with %d colors, game %llu: the reverse moves don't clear the board\n",
+             nColumns, nRows, nColors, (unsigned long long)nGame);
+      pCount->nInvalid++;
+    }
+    return;
+  }
+
+  //  A random board instead, small ones are solved
+  pCount->nRandom++;
+  if(nColumns * nRows > nBlocks)
+    return;
+  SOLV_TableClear(pDead);
+  nResult = SOLV_Solve(&Board, pDead, 0, &nStop, NULL, NULL);
+  if(nResult == SOLV_DEAD)
+    pCount->nDead++;
+  else if(nResult >= 0)
+    pCount->nMissed++;
+}
+
+//*==============================================================================*/
+/*  TOOL_Add                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Add up counters
+ *
+ * \param     pSum --> total, pCount --> counters to add
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Add(TOOL_Count *pSum, const TOOL_Count *pCount)
+{
+  pSum->nBoards += pCount->nBoards;
+  pSum->nMoves += pCount->nMoves;
+  pSum->nRandom += pCount->nRandom;
+  pSum->nDead += pCount->nDead;
+  pSum->nMissed += pCount->nMissed;
+  pSum->nInvalid += pCount->nInvalid;
+  pSum->nReplay += pCount->nReplay;
+  pSum->nMoveList += pCount->nMoveList;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Check the games of all board sizes and color counts, report
+ * \n         every size and color count with random boards and the total.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if all solutions clear their board, all game numbers give
+ * \n         their board again, all move lists agree with the pairs and no
+ * \n         small random board could be cleared
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  TOOL_Count Count, Total;
+  SOLV_Table Dead;
+  uint64_t nGame, nFirst = 1;
+  long long nSolved;
+  int nGames = 20, nColumns = SAGA_MAXCOLUMNS, nRows = SAGA_MAXROWS, nColors = SAGA_MAXCOLORS;
+  int nBlocks = 16, bVerbose = 0, c, r, k, nOpt;
+  double fStart;
+
+  while((nOpt = getopt(argc, argv, "g:n:c:r:k:b:v")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      case 'b': nBlocks = atoi(optarg); break;
+      case 'v': bVerbose = 1; break;
+      default:
+        fprintf(stderr, "usage: %s [-g first game] [-n games] [-c columns] [-r rows] "
+                "[-k colors] [-b blocks] [-v]\n", argv[0]);
+        return 2;
+    }
+  }
+  //  Each side must fit, the sizes with too many blocks are skipped
+  if(nGames < 1 || nColumns < 1 || nColumns > SAGA_MAXCOLUMNS || nRows < 1 ||
+     nRows > SAGA_MAXROWS || !SAGA_BoardIsValidSize(1, 1, nColors))
+  {
+    fprintf(stderr, "%s: board or games out of range\n", argv[0]);
+    return 2;
+  }
+  if(!SOLV_TableInit(&Dead, 16))
+  {
+    fprintf(stderr, "%s: no memory for the solver\n", argv[0]);
+    return 2;
+  }
+
+  memset(&Total, 0, sizeof(Total));
+  fStart = TOOL_Now();
+  for(c = 1; c <= nColumns; c++)
+    for(r = 1; r <= nRows; r++)
+    {
+      if(!SAGA_BoardIsValidSize(c, r, nColors))
+        continue;
+      for(k = 1; k <= nColors; k++)
+      {
+        memset(&Count, 0, sizeof(Count));
+        for(nGame = nFirst; nGame < nFirst + nGames; nGame++)
+          TOOL_Check(c, r, k, nGame, nBlocks, &Dead, &Count);
+        if(bVerbose || Count.nRandom > 0)
+          printf("%2dx%-2d with %d colors: %lld boards, %lld random, %lld of them dead, "
+                 "%lld missed\n", c, r, k, Count.nBoards, Count.nRandom, Count.nDead,
+                 Count.nMissed);
+        TOOL_Add(&Total, &Count);
+      }
+      fflush(stdout);
+    }
+
+  nSolved = Total.nBoards > Total.nRandom ? Total.nBoards - Total.nRandom : 1;
+  printf("%lld boards up to %dx%d with up to %d colors, %.1f moves per solution, %.1f ms per "
+         "board\n", Total.nBoards, nColumns, nRows, nColors, (double)Total.nMoves / nSolved,
+         (TOOL_Now() - fStart) * 1e3 / Total.nBoards);
+  printf("%lld random boards, %lld of them dead and %lld missed, %lld invalid solutions, "
+         "%lld wrong game numbers, %lld wrong move lists\n", Total.nRandom, Total.nDead,
+         Total.nMissed, Total.nInvalid, Total.nReplay, Total.nMoveList);
+  SOLV_TableFree(&Dead);
+  return Total.nInvalid > 0 || Total.nReplay > 0 || Total.nMissed > 0 || Total.nMoveList > 0;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,335 @@
+/*********************************************************************************/
+/*!
+ * \file      samecodec.c
+ *
+ * \brief     The Same Game v0.1 --> BOARD CODEC TEST TOOL File
+ *
+ * \details   Host tool which checks the board codec. Random lines of play of
+ * \n         numbered games of every board size up to the given one and
+ * \n         every number of colors are played, every position must give
+ * \n         the same board again from both forms, the short form must be
+ * \n         the same from the decoded board and a form cut by one byte must
+ * \n         be rejected. The last position of each line with a move left is
+ * \n         saved to a file and loaded again. Then the encoding and the
+ * \n         decoding of the positions of the given board are timed against
+ * \n         a plain copy of the board, the fastest pass counts.
+ * \n
+ * \n         samecodec [-g first game] [-n games] [-p passes] [-c columns]
+ * \n                   [-r rows] [-k colors]
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "codec.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// what a pass over all positions does
+#define TOOL_COPY      0
+#define TOOL_FULL      1
+#define TOOL_SHORT     2
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Same                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compare a decoded board with the original one
+ *
+ * \details   The blocks and everything derived from them must be equal.
+ *
+ * \param     pBoard --> original board, pCopy --> decoded board
+ *
+ * \return    true if they are equal
+ */
+/*===============================================================================*/
+static bool TOOL_Same(const SAGA_Board *pBoard, const SAGA_Board *pCopy)
+{
+  return pBoard->nColumns == pCopy->nColumns && pBoard->nRows == pCopy->nRows &&
+         pBoard->nColors == pCopy->nColors && pBoard->nRemaining == pCopy->nRemaining &&
+         pBoard->nUsedColumns == pCopy->nUsedColumns && pBoard->nPairs == pCopy->nPairs &&
+         pBoard->nHash == pCopy->nHash &&
+         memcmp(pBoard->arrHeights, pCopy->arrHeights, sizeof(pBoard->arrHeights)) == 0 &&
+         memcmp(pBoard->arrCells, pCopy->arrCells, sizeof(pBoard->arrCells)) == 0 &&
+         memcmp(pBoard->arrColorCounts, pCopy->arrColorCounts,
+                sizeof(pBoard->arrColorCounts)) == 0 &&
+         memcmp(pBoard->arrColorHashes, pCopy->arrColorHashes,
+                sizeof(pBoard->arrColorHashes)) == 0;
+}
+
+//*==============================================================================*/
+/*  TOOL_Check                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Encode and decode one position in both forms
+ *
+ * \param     pBoard --> position, nGame --> game number for the report
+ *
+ * \return    number of errors
+ */
+/*===============================================================================*/
+static int TOOL_Check(const SAGA_Board *pBoard, uint64_t nGame)
+{
+  uint8_t arrData[CDC_MAXBYTES], arrAgain[CDC_MAXBYTES];
+  SAGA_Board Copy;
+  int nFull, nShort, nWrong = 0;
+
+  nFull = CDC_Pack(pBoard, arrData, sizeof(arrData));
+  if(nFull != CDC_PackedSize(pBoard->nColumns, pBoard->nRows, pBoard->nColors) ||
+     CDC_Unpack(&Copy, arrData, nFull) != nFull || !TOOL_Same(pBoard, &Copy) ||
+     CDC_Unpack(&Copy, arrData, nFull - 1) != -1)
+  {
+    printf("game %llu: full form differs with %d blocks left\n", (unsigned long long)nGame,
+           pBoard->nRemaining);
+    nWrong++;
+  }
+
+  //  Equal positions give equal bytes, also from the decoded board
+  nShort = CDC_PackShort(pBoard, arrData, sizeof(arrData));
+  if(nShort < CDC_HEADER ||
+     CDC_UnpackShort(&Copy, arrData, nShort) != nShort || !TOOL_Same(pBoard, &Copy) ||
+     CDC_PackShort(&Copy, arrAgain, sizeof(arrAgain)) != nShort ||
+     memcmp(arrData, arrAgain, nShort) != 0 || CDC_UnpackShort(&Copy, arrData, nShort - 1) != -1)
+  {
+    printf("game %llu: short form differs with %d blocks left\n", (unsigned long long)nGame,
+           pBoard->nRemaining);
+    nWrong++;
+  }
+  return nWrong;
+}
+
+//*==============================================================================*/
+/*  TOOL_CheckFile                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Save a position as a game and load it again
+ *
+ * \param     pBoard --> position, nGame --> game number for the report,
+ * \n         pPath --> file name
+ *
+ * \return    number of errors
+ */
+/*===============================================================================*/
+static int TOOL_CheckFile(const SAGA_Board *pBoard, uint64_t nGame, const char *pPath)
+{
+  SAGA_Board Copy;
+
+  if(!CDC_SaveGame(pBoard, pPath) || !CDC_LoadGame(&Copy, pPath) || !TOOL_Same(pBoard, &Copy) ||
+     Copy.nScore != pBoard->nScore || Copy.nGame != pBoard->nGame)
+  {
+    printf("game %llu: saved game differs with %d blocks left\n", (unsigned long long)nGame,
+           pBoard->nRemaining);
+    return 1;
+  }
+  return 0;
+}
+
+//*==============================================================================*/
+/*  TOOL_Play                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Check all positions of a random line of play
+ *
+ * \param     nColumns, nRows, nColors --> board, nGame --> game number,
+ * \n         pPath --> file for the saved game, pPositions --> the positions
+ * \n         are stored here if not NULL, pWrong --> errors are added
+ *
+ * \return    number of positions
+ */
+/*===============================================================================*/
+static int TOOL_Play(int nColumns, int nRows, int nColors, uint64_t nGame, const char *pPath,
+                     SAGA_Board *pPositions, int *pWrong)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Board Board, Last;
+  int nGroups, nCount = 0;
+
+  SAGA_BoardInit(&Board, nColumns, nRows, nColors);
+  SAGA_BoardSetupGame(&Board, nGame);
+  SAGA_BoardCopy(&Last, &Board);
+  for(;;)
+  {
+    *pWrong += TOOL_Check(&Board, nGame);
+    if(pPositions != NULL)
+      SAGA_BoardCopy(&pPositions[nCount], &Board);
+    nCount++;
+    nGroups = SAGA_BoardEnumerateMoves(&Board, arrGroups, SAGA_MAXGROUPS, NULL);
+    if(nGroups == 0)
+      break;
+    SAGA_BoardCopy(&Last, &Board);
+    nGroups = SAGA_BoardRandom(&Board) % nGroups;
+    SAGA_BoardDeleteBlocks(&Board, arrGroups[nGroups].row, arrGroups[nGroups].col);
+  }
+  *pWrong += TOOL_CheckFile(&Last, nGame, pPath);
+  return nCount;
+}
+
+//*==============================================================================*/
+/*  TOOL_Pass                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Encode and decode all positions once
+ *
+ * \param     pPositions --> positions, nPositions --> number of them,
+ * \n         nWork --> TOOL_COPY, TOOL_FULL or TOOL_SHORT,
+ * \n         pSum --> sum of the hashes of the decoded boards
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Pass(const SAGA_Board *pPositions, int nPositions, int nWork, uint64_t *pSum)
+{
+  uint8_t arrData[CDC_MAXBYTES];
+  SAGA_Board Copy;
+  uint64_t nSum = 0;
+  double fStart = TOOL_Now();
+  int i, nSize;
+
+  for(i = 0; i < nPositions; i++)
+  {
+    if(nWork == TOOL_COPY)
+      SAGA_BoardCopy(&Copy, &pPositions[i]);
+    else if(nWork == TOOL_FULL)
+    {
+      nSize = CDC_Pack(&pPositions[i], arrData, sizeof(arrData));
+      CDC_Unpack(&Copy, arrData, nSize);
+    }
+    else
+    {
+      nSize = CDC_PackShort(&pPositions[i], arrData, sizeof(arrData));
+      CDC_UnpackShort(&Copy, arrData, nSize);
+    }
+    nSum += Copy.nHash;
+  }
+  *pSum = nSum;
+  return TOOL_Now() - fStart;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Check the positions of all board sizes and color counts, then
+ * \n         time both forms on the positions of the given board.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if every position and saved game gives the same board again
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static const char *arrNames[3] = { "board copy", "full form", "short form" };
+  char arrPath[] = "/tmp/samecodecXXXXXX";
+  uint8_t arrData[CDC_MAXBYTES];
+  double arrTimes[3], fTime;
+  uint64_t arrSums[3];
+  SAGA_Board *pPositions;
+  uint64_t nGame, nFirst = 1;
+  long long nShort = 0, nAll = 0;
+  int nGames = 100, nPasses = 5, nColumns = NUMOFCOLUMN, nRows = NUMOFROWS;
+  int nColors = NUMOFCOLORS, nPositions = 0, nWrong = 0, nFile, c, r, k, i, w, p, nOpt;
+
+  while((nOpt = getopt(argc, argv, "g:n:p:c:r:k:")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'p': nPasses = atoi(optarg); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-g first game] [-n games] [-p passes] [-c columns] [-r rows] "
+                "[-k colors]\n", argv[0]);
+        return 2;
+    }
+  }
+  if(nGames < 1 || nPasses < 1 || !SAGA_BoardIsValidSize(nColumns, nRows, nColors))
+  {
+    fprintf(stderr, "%s: board, games or passes out of range\n", argv[0]);
+    return 2;
+  }
+  //  A line of play has at most one position per two blocks and the end
+  pPositions = malloc((size_t)nGames * (nColumns * nRows / 2 + 1) * sizeof(SAGA_Board));
+  nFile = mkstemp(arrPath);
+  if(pPositions == NULL || nFile < 0)
+  {
+    fprintf(stderr, "%s: no memory for %d games or no file for the saved games\n", argv[0],
+            nGames);
+    return 2;
+  }
+  close(nFile);
+
+  for(c = 1; c <= nColumns; c++)
+    for(r = 1; r <= nRows; r++)
+      for(k = 1; k <= nColors; k++)
+        for(nGame = nFirst; nGame < nFirst + nGames; nGame++)
+          if(c == nColumns && r == nRows && k == nColors)  // the positions to time
+            nPositions += TOOL_Play(c, r, k, nGame, arrPath, pPositions + nPositions, &nWrong);
+          else
+            nAll += TOOL_Play(c, r, k, nGame, arrPath, NULL, &nWrong);
+  unlink(arrPath);
+  nAll += nPositions;
+  printf("%d games of every board up to %dx%d with up to %d colors, %lld positions, "
+         "%d differences\n", nGames, nColumns, nRows, nColors, nAll, nWrong);
+
+  for(w = TOOL_COPY; w <= TOOL_SHORT; w++)
+    arrTimes[w] = 1e30;
+  for(p = 0; p < nPasses; p++)
+    for(w = TOOL_COPY; w <= TOOL_SHORT; w++)
+      if((fTime = TOOL_Pass(pPositions, nPositions, w, &arrSums[w])) < arrTimes[w])
+        arrTimes[w] = fTime;
+  if(arrSums[TOOL_FULL] != arrSums[TOOL_COPY] || arrSums[TOOL_SHORT] != arrSums[TOOL_COPY])
+    nWrong++;
+  for(i = 0; i < nPositions; i++)
+    nShort += CDC_PackShort(&pPositions[i], arrData, sizeof(arrData));
+  printf("%dx%d with %d colors: %d positions, %d bytes in the full form, %.1f in the short form "
+         "on average, best of %d passes\n", nColumns, nRows, nColors, nPositions,
+         CDC_PackedSize(nColumns, nRows, nColors), (double)nShort / nPositions, nPasses);
+  for(w = TOOL_COPY; w <= TOOL_SHORT; w++)
+    printf("%-12s %6.1f ns per position%s\n", arrNames[w], arrTimes[w] * 1e9 / nPositions,
+           w == TOOL_COPY ? "" : " to encode and decode");
+  free(pPositions);
+  return nWrong > 0;
+}
+
+//----------------------------------- END --------------------------------------
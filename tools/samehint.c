@@ -0,0 +1,193 @@
+/*********************************************************************************/
+/*!
+ * \file      samehint.c
+ *
+ * \brief     The Same Game v0.1 --> HINT TOOL File
+ *
+ * \details   Host tool which drives the hint search of the game like the
+ * \n         main loop does, one slice after the other. For numbered games
+ * \n         the best score is taken whenever the total search time passes
+ * \n         one of the budgets, it must never get worse with a larger
+ * \n         budget. At the end the best game is played again with the
+ * \n         engine to check it.
+ * \n
+ * \n         samehint [-s slice in us] [-b budget[,budget...] in ms]
+ * \n                  [-g first game] [-n games] [-c columns] [-r rows]
+ * \n                  [-k colors] [-e tablebase] [-v]
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "hint.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+#define TOOL_MAXBUDGETS  32
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Search the hint of every game slice by slice, report the
+ * \n         average best score at every budget and check that it never
+ * \n         drops and that the best game is valid.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if all checks passed
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static HINT_Search Hint;
+  static TBL_Table Base;
+  const char *pBase = NULL;
+  double arrBudgets[TOOL_MAXBUDGETS] = { 2, 4, 8, 16, 32, 64, 128, 256 };
+  long long arrTotal[TOOL_MAXBUDGETS] = { 0 };
+  int arrScores[TOOL_MAXBUDGETS];
+  SAGA_Cell Move;
+  SAGA_Board Board, Replay;
+  char *pBudget;
+  uint64_t nGame, nFirst = 1, nSlices;
+  int nBudgets = 8, nGames = 10, nColumns = NUMOFCOLUMN, nRows = NUMOFROWS;
+  int nColors = NUMOFCOLORS, bVerbose = 0, nFailed = 0, nSlice = HINT_SLICE, b, i, nOpt;
+  double fUsed, fStart, fSlowest = 0;
+
+  while((nOpt = getopt(argc, argv, "s:b:g:n:c:r:k:e:v")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 's': nSlice = atoi(optarg); break;
+      case 'b':
+        for(nBudgets = 0, pBudget = strtok(optarg, ","); pBudget != NULL && nBudgets < TOOL_MAXBUDGETS;
+            pBudget = strtok(NULL, ","))
+          arrBudgets[nBudgets++] = atof(pBudget);
+        break;
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      case 'e': pBase = optarg; break;
+      case 'v': bVerbose = 1; break;
+      default:
+        fprintf(stderr, "usage: %s [-s slice in us] [-b budget[,budget...] in ms] [-g first game] "
+                "[-n games] [-c columns] [-r rows] [-k colors] [-e tablebase] [-v]\n", argv[0]);
+        return 2;
+    }
+  }
+  for(b = 1; b < nBudgets; b++)
+    if(arrBudgets[b] <= arrBudgets[b - 1])
+      nBudgets = 0;
+  if(nBudgets == 0 || nSlice < 0 || !SAGA_BoardIsValidSize(nColumns, nRows, nColors))
+  {
+    fprintf(stderr, "%s: board, slice or budgets out of range, the budgets must grow\n", argv[0]);
+    return 2;
+  }
+  if(pBase != NULL && !TBL_Open(&Base, pBase))
+  {
+    fprintf(stderr, "%s: %s is no tablebase of this game\n", argv[0], pBase);
+    return 2;
+  }
+
+  for(nGame = nFirst; nGame < nFirst + nGames; nGame++)
+  {
+    SAGA_BoardInit(&Board, nColumns, nRows, nColors);
+    SAGA_BoardSetupGame(&Board, nGame);
+    HINT_Init(&Hint, nGame);
+    if(pBase != NULL)
+      HINT_SetTablebase(&Hint, &Base);
+
+    //  Drive the search like the frames of the game do
+    fUsed = 0;
+    nSlices = 0;
+    for(b = 0; b < nBudgets; b++)
+    {
+      while(fUsed < arrBudgets[b] * 1e-3)
+      {
+        fStart = TOOL_Now();
+        arrScores[b] = HINT_Step(&Hint, &Board, nSlice);
+        fStart = TOOL_Now() - fStart;
+        if(fStart > fSlowest)
+          fSlowest = fStart;
+        fUsed += fStart;
+        nSlices++;
+      }
+      arrTotal[b] += arrScores[b];
+      if(b > 0 && arrScores[b] < arrScores[b - 1])
+      {
+        printf("game %llu: score %d at %g ms is worse than %d at %g ms\n", (unsigned long long)nGame,
+               arrScores[b], arrBudgets[b], arrScores[b - 1], arrBudgets[b - 1]);
+        nFailed++;
+      }
+    }
+
+    //  The best game must be a complete game with the reported score
+    SAGA_BoardCopy(&Replay, &Board);
+    for(i = 0; i < Hint.nBestMoves; i++)
+      if(SAGA_BoardDeleteBlocks(&Replay, Hint.arrBest[i].row, Hint.arrBest[i].col) < 0)
+        break;
+    if(i < Hint.nBestMoves || !SAGA_BoardIsGameOver(&Replay) || Replay.nScore != Hint.nBestScore)
+    {
+      printf("game %llu: INVALID best game\n", (unsigned long long)nGame);
+      nFailed++;
+    }
+    if(bVerbose)
+    {
+      printf("game %llu:", (unsigned long long)nGame);
+      for(b = 0; b < nBudgets; b++)
+        printf(" %d", arrScores[b]);
+      if(HINT_GetBest(&Hint, &Move) >= 0)
+        printf(", hint %d,%d", Move.row, Move.col);
+      printf(", %u games in %llu slices\n", Hint.nPlayouts, (unsigned long long)nSlices);
+    }
+  }
+
+  printf("%d games %dx%d with %d colors, slices of %d us, the slowest took %.0f us\n",
+         nGames, nColumns, nRows, nColors, nSlice, fSlowest * 1e6);
+  for(b = 0; b < nBudgets; b++)
+    printf("%8g ms: average best score %.1f\n", arrBudgets[b], (double)arrTotal[b] / nGames);
+  if(pBase != NULL)
+    TBL_Free(&Base);
+  return nFailed > 0;
+}
+
+//----------------------------------- END --------------------------------------
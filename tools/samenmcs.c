@@ -0,0 +1,366 @@
+/*********************************************************************************/
+/*!
+ * \file      samenmcs.c
+ *
+ * \brief     The Same Game v0.1 --> NESTED MONTE CARLO TOOL File
+ *
+ * \details   Host tool which plays numbered games for the highest score with
+ * \n         a Nested Monte Carlo Search. Level 0 is a random playout, level
+ * \n         n tries every move with a level n - 1 search and follows the
+ * \n         best line found so far. The playouts only work on boards on the
+ * \n         stack, nothing is allocated while searching.
+ * \n         The threads search the same board independently with their own
+ * \n         board copy and random stream (root parallelization) and start
+ * \n         over until the time of the board is over, the best line of all
+ * \n         of them is kept. Several thread counts could be given to report
+ * \n         the playouts per second of each core and the scaling against
+ * \n         the first thread count.
+ * \n
+ * \n         samenmcs [-l level] [-s seconds per board] [-t threads[,threads...]]
+ * \n                  [-g first game] [-n games] [-c columns] [-r rows]
+ * \n                  [-k colors] [-v]
+ *
+ * \note      Hardware:    Linux host with pthreads
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "samegame.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+#define TOOL_MAXTHREADS  256
+#define TOOL_MAXRUNS      32
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // one search thread with its own board
+  pthread_t Thread;
+  SAGA_Board Board;                    // copy of the board to play
+  int *pStop;                          // stop flag, shared
+  int nLevel;                          // nesting level
+  uint64_t nRandom;                    // state of the random stream
+  uint64_t nPlayouts;                  // random games played
+  int nBestScore;                      // best game of the thread
+  int nBestMoves;
+  SAGA_Cell arrBest[SAGA_MAXGROUPS];
+}TOOL_Worker;
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Random                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Random number below a limit
+ *
+ * \details   Splitmix64 stream of the worker, the board copies of the search
+ * \n         keep their own state untouched.
+ *
+ * \param     pWorker --> worker, nLimit --> number of choices
+ *
+ * \return    0 .. nLimit - 1
+ */
+/*===============================================================================*/
+static inline int TOOL_Random(TOOL_Worker *pWorker, int nLimit)
+{
+  uint64_t z = (pWorker->nRandom += 0x9E3779B97F4A7C15ull);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  z ^= z >> 31;
+  return (int)(((z >> 32) * (uint64_t)nLimit) >> 32);
+}
+
+//*==============================================================================*/
+/*  TOOL_Playout                                                                 */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Random game until no move is left
+ *
+ * \param     pWorker --> worker, pStart --> position to play from,
+ * \n         pMoves --> moves of the game, pCount --> number of them
+ *
+ * \return    final score
+ */
+/*===============================================================================*/
+static int TOOL_Playout(TOOL_Worker *pWorker, const SAGA_Board *pStart, SAGA_Cell *pMoves,
+                        int *pCount)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Board Board;
+  int i, nGroups, nCount = 0;
+
+  SAGA_BoardCopy(&Board, pStart);
+  while((nGroups = SAGA_BoardEnumerateMoves(&Board, arrGroups, SAGA_MAXGROUPS, NULL)) > 0)
+  {
+    i = TOOL_Random(pWorker, nGroups);
+    pMoves[nCount].row = arrGroups[i].row;
+    pMoves[nCount++].col = arrGroups[i].col;
+    SAGA_BoardDeleteBlocks(&Board, arrGroups[i].row, arrGroups[i].col);
+  }
+  pWorker->nPlayouts++;
+  *pCount = nCount;
+  return Board.nScore;
+}
+
+//*==============================================================================*/
+/*  TOOL_Nested                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Nested Monte Carlo Search of a position
+ *
+ * \details   Every move of the position is rated with a search one level
+ * \n         lower, then the first move of the best game seen so far is
+ * \n         played, until no move is left. When the stop flag is set the
+ * \n         best game so far is returned, it is always a complete game.
+ *
+ * \param     pWorker --> worker, pStart --> position to search,
+ * \n         nLevel --> nesting level, pMoves --> moves of the best game,
+ * \n         pCount --> number of them
+ *
+ * \return    final score of the best game
+ */
+/*===============================================================================*/
+static int TOOL_Nested(TOOL_Worker *pWorker, const SAGA_Board *pStart, int nLevel,
+                       SAGA_Cell *pMoves, int *pCount)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Cell arrLine[SAGA_MAXGROUPS];
+  SAGA_Board Board, Child;
+  int i, nGroups, nScore, nLine, nPlayed = 0, nBestScore = -1, nBestMoves = 0;
+
+  if(nLevel == 0)
+    return TOOL_Playout(pWorker, pStart, pMoves, pCount);
+
+  SAGA_BoardCopy(&Board, pStart);
+  while((nGroups = SAGA_BoardEnumerateMoves(&Board, arrGroups, SAGA_MAXGROUPS, NULL)) > 0)
+  {
+    for(i = 0; i < nGroups; i++)
+    {
+      SAGA_BoardCopy(&Child, &Board);
+      SAGA_BoardDeleteBlocks(&Child, arrGroups[i].row, arrGroups[i].col);
+      nScore = TOOL_Nested(pWorker, &Child, nLevel - 1, arrLine, &nLine);
+      if(nScore > nBestScore)
+      {
+        nBestScore = nScore;
+        pMoves[nPlayed].row = arrGroups[i].row;
+        pMoves[nPlayed].col = arrGroups[i].col;
+        memcpy(&pMoves[nPlayed + 1], arrLine, nLine * sizeof(SAGA_Cell));
+        nBestMoves = nPlayed + 1 + nLine;
+      }
+      if(__atomic_load_n(pWorker->pStop, __ATOMIC_RELAXED))
+      {
+        *pCount = nBestMoves;
+        return nBestScore;
+      }
+    }
+    //  Follow the best game
+    SAGA_BoardDeleteBlocks(&Board, pMoves[nPlayed].row, pMoves[nPlayed].col);
+    nPlayed++;
+  }
+  *pCount = nPlayed;
+  return Board.nScore;
+}
+
+//*==============================================================================*/
+/*  TOOL_Run                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Thread function of a worker
+ *
+ * \details   Search the board again and again until the stop flag is set.
+ *
+ * \param     pArg --> worker
+ *
+ * \return    NULL
+ */
+/*===============================================================================*/
+static void *TOOL_Run(void *pArg)
+{
+  TOOL_Worker *pWorker = pArg;
+  SAGA_Cell arrMoves[SAGA_MAXGROUPS];
+  int nScore, nMoves;
+
+  pWorker->nPlayouts = 0;
+  pWorker->nBestScore = -1;
+  pWorker->nBestMoves = 0;
+  do
+  {
+    nScore = TOOL_Nested(pWorker, &pWorker->Board, pWorker->nLevel, arrMoves, &nMoves);
+    if(nScore > pWorker->nBestScore)
+    {
+      pWorker->nBestScore = nScore;
+      pWorker->nBestMoves = nMoves;
+      memcpy(pWorker->arrBest, arrMoves, nMoves * sizeof(SAGA_Cell));
+    }
+  }while(!__atomic_load_n(pWorker->pStop, __ATOMIC_RELAXED));
+  return NULL;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Play all games with every thread count, report the scores,
+ * \n         the playouts per second and core and the scaling efficiency
+ * \n         against the first thread count. The best line of each game is
+ * \n         checked with the engine.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if all lines of play are valid
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static TOOL_Worker arrWorkers[TOOL_MAXTHREADS];
+  int arrThreads[TOOL_MAXRUNS] = { (int)sysconf(_SC_NPROCESSORS_ONLN) };
+  struct timespec Sleep;
+  SAGA_Board Board, Replay;
+  TOOL_Worker *pBest;
+  char *pThreads;
+  uint64_t nGame, nFirst = 1, nPlayouts;
+  int nLevel = 2, nGames = 10, nColumns = NUMOFCOLUMN, nRows = NUMOFROWS, nColors = NUMOFCOLORS;
+  int nRuns = 1, bVerbose = 0, nInvalid = 0, nStop, nThreads, nCleared, r, i, nOpt;
+  double fSeconds = 1, fStart, fTime, fTotal, fRate, fFirstRate = 0;
+  long long nTotal;
+
+  while((nOpt = getopt(argc, argv, "l:s:t:g:n:c:r:k:v")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'l': nLevel = atoi(optarg); break;
+      case 's': fSeconds = atof(optarg); break;
+      case 't':
+        for(nRuns = 0, pThreads = strtok(optarg, ","); pThreads != NULL && nRuns < TOOL_MAXRUNS;
+            pThreads = strtok(NULL, ","))
+          arrThreads[nRuns++] = atoi(pThreads);
+        break;
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      case 'v': bVerbose = 1; break;
+      default:
+        fprintf(stderr, "usage: %s [-l level] [-s seconds per board] [-t threads[,threads...]] "
+                "[-g first game] [-n games] [-c columns] [-r rows] [-k colors] [-v]\n", argv[0]);
+        return 2;
+    }
+  }
+  for(r = 0; r < nRuns; r++)
+    if(arrThreads[r] < 1 || arrThreads[r] > TOOL_MAXTHREADS)
+      nRuns = 0;
+  if(nRuns == 0 || nLevel < 0 || fSeconds <= 0 || !SAGA_BoardIsValidSize(nColumns, nRows, nColors))
+  {
+    fprintf(stderr, "%s: board, level, time or thread count out of range\n", argv[0]);
+    return 2;
+  }
+  Sleep.tv_sec = (time_t)fSeconds;
+  Sleep.tv_nsec = (long)((fSeconds - Sleep.tv_sec) * 1e9);
+
+  for(r = 0; r < nRuns; r++)
+  {
+    nThreads = arrThreads[r];
+    nTotal = 0;
+    nCleared = 0;
+    nPlayouts = 0;
+    fTotal = 0;
+    for(nGame = nFirst; nGame < nFirst + nGames; nGame++)
+    {
+      SAGA_BoardInit(&Board, nColumns, nRows, nColors);
+      SAGA_BoardSetupGame(&Board, nGame);
+      nStop = 0;
+      fStart = TOOL_Now();
+      for(i = 0; i < nThreads; i++)
+      {
+        SAGA_BoardCopy(&arrWorkers[i].Board, &Board);
+        arrWorkers[i].pStop = &nStop;
+        arrWorkers[i].nLevel = nLevel;
+        arrWorkers[i].nRandom = nGame * 0x100000001B3ull + i;
+        pthread_create(&arrWorkers[i].Thread, NULL, TOOL_Run, &arrWorkers[i]);
+      }
+      nanosleep(&Sleep, NULL);
+      __atomic_store_n(&nStop, 1, __ATOMIC_RELAXED);
+      pBest = &arrWorkers[0];
+      for(i = 0; i < nThreads; i++)
+      {
+        pthread_join(arrWorkers[i].Thread, NULL);
+        nPlayouts += arrWorkers[i].nPlayouts;
+        if(arrWorkers[i].nBestScore > pBest->nBestScore)
+          pBest = &arrWorkers[i];
+      }
+      fTime = TOOL_Now() - fStart;
+
+      //  Play the line again to check it
+      SAGA_BoardCopy(&Replay, &Board);
+      for(i = 0; i < pBest->nBestMoves; i++)
+        if(SAGA_BoardDeleteBlocks(&Replay, pBest->arrBest[i].row, pBest->arrBest[i].col) < 0)
+          break;
+      if(i < pBest->nBestMoves || !SAGA_BoardIsGameOver(&Replay) || Replay.nScore != pBest->nBestScore)
+        nInvalid++;
+      nTotal += Replay.nScore;
+      nCleared += Replay.nRemaining == 0;
+      fTotal += fTime;
+      if(bVerbose)
+      {
+        printf("game %llu on %d threads: score %d in %d moves%s%s\n", (unsigned long long)nGame,
+               nThreads, Replay.nScore, pBest->nBestMoves, Replay.nRemaining == 0 ? ", cleared" : "",
+               i < pBest->nBestMoves || Replay.nScore != pBest->nBestScore ? ", INVALID" : "");
+        for(i = 0; i < pBest->nBestMoves; i++)
+          printf(" %d,%d", pBest->arrBest[i].row, pBest->arrBest[i].col);
+        printf("\n");
+      }
+    }
+
+    //  The scaling compares the rate of a core with the one of the first run
+    fRate = nPlayouts / fTotal / nThreads;
+    if(r == 0)
+      fFirstRate = fRate;
+    printf("%d threads: %d games %dx%d with %d colors, level %d, %.2f s per game, average score "
+           "%.1f, %d cleared, %.0f playouts/s per core, scaling %.0f%%\n", nThreads, nGames,
+           nColumns, nRows, nColors, nLevel, fTotal / nGames, (double)nTotal / nGames, nCleared,
+           fRate, 100 * fRate / fFirstRate);
+    fflush(stdout);
+  }
+  return nInvalid > 0;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,307 @@
+/*********************************************************************************/
+/*!
+ * \file      samepers.c
+ *
+ * \brief     The Same Game v0.1 --> PERSISTENT BOARD TEST TOOL File
+ *
+ * \details   Host tool which checks the persistent boards against the
+ * \n         engine and times both. From every numbered game all lines of
+ * \n         play up to the given depth are walked, every child is built as
+ * \n         a persistent board from its persistent parent and by copying
+ * \n         the parent board and playing the move. Both must hold the same
+ * \n         blocks, score and hash and agree whether the game is over. After
+ * \n         the walk of a game no column of the pool may be in use. Then
+ * \n         all children of the positions of random lines of play are built
+ * \n         both ways, the fastest pass counts.
+ * \n
+ * \n         samepers [-g first game] [-n games] [-d depth] [-p passes]
+ * \n                  [-c columns] [-r rows] [-k colors]
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "persist.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// how a pass builds the children
+#define TOOL_COPY      0
+#define TOOL_PERS      1
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Same                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compare a persistent board with a board
+ *
+ * \param     pPool --> pool, pPers --> persistent board, pBoard --> board
+ *
+ * \return    true if they hold the same position
+ */
+/*===============================================================================*/
+static bool TOOL_Same(const PERS_Pool *pPool, const PERS_Board *pPers, const SAGA_Board *pBoard)
+{
+  SAGA_Board Copy;
+
+  PERS_ToBoard(pPool, pPers, &Copy);
+  return Copy.nRemaining == pBoard->nRemaining && Copy.nUsedColumns == pBoard->nUsedColumns &&
+         Copy.nScore == pBoard->nScore && Copy.nHash == pBoard->nHash &&
+         Copy.nPairs == pBoard->nPairs &&
+         memcmp(Copy.arrHeights, pBoard->arrHeights, sizeof(Copy.arrHeights)) == 0 &&
+         memcmp(Copy.arrCells, pBoard->arrCells, sizeof(Copy.arrCells)) == 0 &&
+         PERS_IsGameOver(pPool, pPers) == SAGA_BoardIsGameOver(pBoard);
+}
+
+//*==============================================================================*/
+/*  TOOL_Walk                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compare all children of a position down to a depth
+ *
+ * \param     pPool --> pool, pPers --> persistent position, pBoard --> the
+ * \n         same position as a board, nDepth --> levels left,
+ * \n         nGame --> game number for the report, pNodes --> children
+ * \n         are counted here
+ *
+ * \return    number of differences
+ */
+/*===============================================================================*/
+static int TOOL_Walk(PERS_Pool *pPool, const PERS_Board *pPers, const SAGA_Board *pBoard,
+                     int nDepth, uint64_t nGame, long long *pNodes)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Board Child;
+  PERS_Board PersChild;
+  int i, nGroups, nCount, nWrong = 0;
+
+  if(nDepth == 0)
+    return 0;
+  nGroups = SAGA_BoardEnumerateMoves(pBoard, arrGroups, SAGA_MAXGROUPS, NULL);
+  for(i = 0; i < nGroups; i++)
+  {
+    SAGA_BoardCopy(&Child, pBoard);
+    nCount = SAGA_BoardDeleteBlocks(&Child, arrGroups[i].row, arrGroups[i].col);
+    if(PERS_DeleteBlocks(pPool, pPers, arrGroups[i].row, arrGroups[i].col, &PersChild) != nCount ||
+       !TOOL_Same(pPool, &PersChild, &Child))
+    {
+      printf("game %llu: move %d,%d differs with %d blocks left\n", (unsigned long long)nGame,
+             arrGroups[i].row, arrGroups[i].col, pBoard->nRemaining);
+      nWrong++;
+    }
+    else
+      nWrong += TOOL_Walk(pPool, &PersChild, &Child, nDepth - 1, nGame, pNodes);
+    PERS_Release(pPool, &PersChild);
+    (*pNodes)++;
+  }
+  return nWrong;
+}
+
+//*==============================================================================*/
+/*  TOOL_Pass                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Build all children of all positions once
+ *
+ * \details   With TOOL_PERS the children are built from the persistent
+ * \n         positions and released again, the new columns are counted.
+ *
+ * \param     pPool --> pool, pPositions, pPers --> positions in both forms,
+ * \n         pMoves --> taps of the moves, pStarts --> first move of each
+ * \n         position and the end, nPositions --> number of positions,
+ * \n         nWork --> TOOL_COPY or TOOL_PERS, pColumns --> new columns
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Pass(PERS_Pool *pPool, const SAGA_Board *pPositions, const PERS_Board *pPers,
+                        const SAGA_Cell *pMoves, const int *pStarts, int nPositions, int nWork,
+                        long long *pColumns)
+{
+  SAGA_Board Child;
+  PERS_Board PersChild;
+  uint32_t nUsed = pPool->nUsed;
+  double fStart = TOOL_Now();
+  int i, m;
+
+  *pColumns = 0;
+  for(i = 0; i < nPositions; i++)
+    for(m = pStarts[i]; m < pStarts[i + 1]; m++)
+      if(nWork == TOOL_COPY)
+      {
+        SAGA_BoardCopy(&Child, &pPositions[i]);
+        SAGA_BoardDeleteBlocks(&Child, pMoves[m].row, pMoves[m].col);
+      }
+      else
+      {
+        PERS_DeleteBlocks(pPool, &pPers[i], pMoves[m].row, pMoves[m].col, &PersChild);
+        *pColumns += pPool->nUsed - nUsed;
+        PERS_Release(pPool, &PersChild);
+      }
+  return TOOL_Now() - fStart;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Walk the games to the depth and compare every child, then time
+ *            the children of random lines of play built both ways.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if every child matches the engine and no column is left
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Board Board, *pPositions;
+  PERS_Board Pers, *pPers;
+  PERS_Pool Pool;
+  SAGA_Cell *pMoves;
+  int *pStarts;
+  uint64_t nGame, nFirst = 1;
+  long long nNodes = 0, nColumns = 0;
+  double arrTimes[2], fTime;
+  int nGames = 300, nDepth = 3, nPasses = 5, nWidth = NUMOFCOLUMN, nRows = NUMOFROWS;
+  int nColors = NUMOFCOLORS, nPositions = 0, nMoves = 0, nWrong = 0, nGroups, i, p, w, nOpt;
+
+  while((nOpt = getopt(argc, argv, "g:n:d:p:c:r:k:")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'd': nDepth = atoi(optarg); break;
+      case 'p': nPasses = atoi(optarg); break;
+      case 'c': nWidth = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-g first game] [-n games] [-d depth] [-p passes] "
+                "[-c columns] [-r rows] [-k colors]\n", argv[0]);
+        return 2;
+    }
+  }
+  if(nGames < 1 || nDepth < 1 || nPasses < 1 || !SAGA_BoardIsValidSize(nWidth, nRows, nColors))
+  {
+    fprintf(stderr, "%s: board, games, depth or passes out of range\n", argv[0]);
+    return 2;
+  }
+  //  A line of play has at most one position per two blocks and the end
+  nPositions = nGames * (nWidth * nRows / 2 + 1);
+  pPositions = malloc((size_t)nPositions * sizeof(SAGA_Board));
+  pPers = malloc((size_t)nPositions * sizeof(PERS_Board));
+  pStarts = malloc((size_t)(nPositions + 1) * sizeof(int));
+  pMoves = malloc((size_t)nPositions * SAGA_MAXGROUPS * sizeof(SAGA_Cell));
+  if(pPositions == NULL || pPers == NULL || pStarts == NULL || pMoves == NULL ||
+     !PERS_PoolInit(&Pool, 1024))
+  {
+    fprintf(stderr, "%s: no memory for %d games\n", argv[0], nGames);
+    return 2;
+  }
+
+  //  Every line of play from the start down to the depth
+  for(nGame = nFirst; nGame < nFirst + nGames; nGame++)
+  {
+    SAGA_BoardInit(&Board, nWidth, nRows, nColors);
+    SAGA_BoardSetupGame(&Board, nGame);
+    PERS_FromBoard(&Pool, &Pers, &Board);
+    nWrong += !TOOL_Same(&Pool, &Pers, &Board);
+    nWrong += TOOL_Walk(&Pool, &Pers, &Board, nDepth, nGame, &nNodes);
+    PERS_Release(&Pool, &Pers);
+    if(Pool.nUsed != 0)
+    {
+      printf("game %llu: %u columns still in use\n", (unsigned long long)nGame, Pool.nUsed);
+      nWrong++;
+    }
+  }
+  printf("%d games %dx%d with %d colors, %lld children down to depth %d, %d differences\n",
+         nGames, nWidth, nRows, nColors, nNodes, nDepth, nWrong);
+
+  //  The positions of random lines of play with all their moves
+  for(nGame = nFirst, nPositions = 0; nGame < nFirst + nGames; nGame++)
+  {
+    SAGA_BoardInit(&Board, nWidth, nRows, nColors);
+    SAGA_BoardSetupGame(&Board, nGame);
+    while((nGroups = SAGA_BoardEnumerateMoves(&Board, arrGroups, SAGA_MAXGROUPS, NULL)) > 0)
+    {
+      SAGA_BoardCopy(&pPositions[nPositions], &Board);
+      PERS_FromBoard(&Pool, &pPers[nPositions], &Board);
+      pStarts[nPositions++] = nMoves;
+      for(i = 0; i < nGroups; i++)
+      {
+        pMoves[nMoves].row = arrGroups[i].row;
+        pMoves[nMoves++].col = arrGroups[i].col;
+      }
+      i = SAGA_BoardRandom(&Board) % nGroups;
+      SAGA_BoardDeleteBlocks(&Board, arrGroups[i].row, arrGroups[i].col);
+    }
+  }
+  pStarts[nPositions] = nMoves;
+
+  arrTimes[TOOL_COPY] = arrTimes[TOOL_PERS] = 1e30;
+  for(p = 0; p < nPasses; p++)
+    for(w = TOOL_COPY; w <= TOOL_PERS; w++)
+      if((fTime = TOOL_Pass(&Pool, pPositions, pPers, pMoves, pStarts, nPositions, w,
+                            &nColumns)) < arrTimes[w])
+        arrTimes[w] = fTime;
+  nMoves = nMoves > 0 ? nMoves : 1;
+  printf("%d positions, %d children, %.2f new columns per child, best of %d passes\n",
+         nPositions, nMoves, (double)nColumns / nMoves, nPasses);
+  printf("board copy   %6.1f ns per child, %d bytes\n", arrTimes[TOOL_COPY] * 1e9 / nMoves,
+         (int)sizeof(SAGA_Board));
+  printf("persistent   %6.1f ns per child, %.0f bytes\n", arrTimes[TOOL_PERS] * 1e9 / nMoves,
+         sizeof(PERS_Board) + (double)nColumns / nMoves * sizeof(PERS_Column));
+
+  for(i = 0; i < nPositions; i++)
+    PERS_Release(&Pool, &pPers[i]);
+  if(Pool.nUsed != 0)
+    nWrong++;
+  PERS_PoolFree(&Pool);
+  free(pPositions);
+  free(pPers);
+  free(pStarts);
+  free(pMoves);
+  return nWrong > 0;
+}
+
+//----------------------------------- END --------------------------------------
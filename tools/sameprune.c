@@ -0,0 +1,326 @@
+/*********************************************************************************/
+/*!
+ * \file      sameprune.c
+ *
+ * \brief     The Same Game v0.1 --> PRUNING TOOL File
+ *
+ * \details   Host tool which measures how many nodes the analysis saves. For
+ * \n         numbered games two exact searches are run twice, once plain and
+ * \n         once cut by the analysis: a depth first search whether the
+ * \n         board could be cleared, which stops at dead positions, and a
+ * \n         branch and bound search for the best score, which stops where
+ * \n         the upper bound can't beat the best game so far. Both runs
+ * \n         must come to the same result, otherwise a cut was wrong.
+ * \n         There is no table of positions, so small boards are best.
+ * \n
+ * \n         sameprune [-g first game] [-n games] [-c columns] [-r rows]
+ * \n                   [-k colors] [-l node limit] [-v]
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "analysis.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// results of a search which ran into the node limit
+#define TOOL_STOPPED  -1
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // state of one search
+  SAGA_Board Board;                    // position of the search
+  SAGA_Journal Journal;                // moves to the position
+  SAGA_Group *pGroups;                 // one list of moves for each depth
+  bool bPrune;                         // cut with the analysis
+  uint64_t nNodes;                     // positions searched
+  uint64_t nLimit;                     // give up after this many positions
+  int nBest;                           // best final score so far
+}TOOL_Search;
+
+typedef struct {  // totals of one kind of search
+  uint64_t arrNodes[2];                // positions, plain and cut
+  double arrTimes[2];                  // seconds, plain and cut
+  int arrStopped[2];                   // searches which hit the limit
+}TOOL_Totals;
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Clear                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Could the position be cleared?
+ *
+ * \details   Plain depth first search over every move. The plain search
+ * \n         only stops where there is no move, the cut one as soon as the
+ * \n         analysis proves the position dead.
+ *
+ * \param     pSearch --> search state, nDepth --> moves made so far
+ *
+ * \return    1 if cleared, 0 if dead, TOOL_STOPPED at the node limit
+ */
+/*===============================================================================*/
+static int TOOL_Clear(TOOL_Search *pSearch, int nDepth)
+{
+  SAGA_Board *pBoard = &pSearch->Board;
+  SAGA_Group *pGroups = &pSearch->pGroups[nDepth * SAGA_MAXGROUPS];
+  int i, nGroups, nResult;
+
+  if(pBoard->nRemaining == 0)
+    return 1;
+  if(pSearch->nNodes++ >= pSearch->nLimit)
+    return TOOL_STOPPED;
+  if(pSearch->bPrune && ANA_IsDead(pBoard))
+    return 0;
+
+  nGroups = SAGA_BoardEnumerateMoves(pBoard, pGroups, SAGA_MAXGROUPS, NULL);
+  for(i = 0; i < nGroups; i++)
+  {
+    SAGA_BoardMakeMove(pBoard, pGroups[i].row, pGroups[i].col, &pSearch->Journal);
+    nResult = TOOL_Clear(pSearch, nDepth + 1);
+    SAGA_BoardUnmakeMove(pBoard, &pSearch->Journal);
+    if(nResult != 0)
+      return nResult;
+  }
+  return 0;
+}
+
+//*==============================================================================*/
+/*  TOOL_Best                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Best final score of the position
+ *
+ * \details   Depth first search over every move which keeps the best score
+ * \n         of all finished games. The cut search skips a position whose
+ * \n         score plus the upper bound of the analysis isn't more than the
+ * \n         best score so far.
+ *
+ * \param     pSearch --> search state, nDepth --> moves made so far
+ *
+ * \return    0, TOOL_STOPPED at the node limit
+ */
+/*===============================================================================*/
+static int TOOL_Best(TOOL_Search *pSearch, int nDepth)
+{
+  SAGA_Board *pBoard = &pSearch->Board;
+  SAGA_Group *pGroups = &pSearch->pGroups[nDepth * SAGA_MAXGROUPS];
+  int i, nGroups, nResult;
+
+  if(pSearch->nNodes++ >= pSearch->nLimit)
+    return TOOL_STOPPED;
+  if(pBoard->nPairs == 0)
+  {
+    if(pBoard->nScore > pSearch->nBest)
+      pSearch->nBest = pBoard->nScore;
+    return 0;
+  }
+  if(pSearch->bPrune && pBoard->nScore + ANA_GetUpperBound(pBoard) <= pSearch->nBest)
+    return 0;
+
+  nGroups = SAGA_BoardEnumerateMoves(pBoard, pGroups, SAGA_MAXGROUPS, NULL);
+  for(i = 0; i < nGroups; i++)
+  {
+    SAGA_BoardMakeMove(pBoard, pGroups[i].row, pGroups[i].col, &pSearch->Journal);
+    nResult = TOOL_Best(pSearch, nDepth + 1);
+    SAGA_BoardUnmakeMove(pBoard, &pSearch->Journal);
+    if(nResult != 0)
+      return nResult;
+  }
+  return 0;
+}
+
+//*==============================================================================*/
+/*  TOOL_Run                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Run one search of a board
+ *
+ * \param     pSearch --> search state, pBoard --> board, bBest --> score
+ * \n         search instead of the clear search, bPrune --> cut with the
+ * \n         analysis, pTotals --> totals of the kind of search
+ *
+ * \return    result of the clear search or the best score,
+ * \n         TOOL_STOPPED at the node limit
+ */
+/*===============================================================================*/
+static int TOOL_Run(TOOL_Search *pSearch, const SAGA_Board *pBoard, bool bBest, bool bPrune,
+                    TOOL_Totals *pTotals)
+{
+  double fStart = TOOL_Now();
+  int nResult;
+
+  SAGA_BoardCopy(&pSearch->Board, pBoard);
+  SAGA_JournalClear(&pSearch->Journal);
+  pSearch->bPrune = bPrune;
+  pSearch->nNodes = 0;
+  pSearch->nBest = -1;
+  if(bBest)
+  {
+    nResult = TOOL_Best(pSearch, 0);
+    if(nResult != TOOL_STOPPED)
+      nResult = pSearch->nBest;
+  }
+  else
+    nResult = TOOL_Clear(pSearch, 0);
+
+  pTotals->arrNodes[bPrune] += pSearch->nNodes;
+  pTotals->arrTimes[bPrune] += TOOL_Now() - fStart;
+  pTotals->arrStopped[bPrune] += nResult == TOOL_STOPPED;
+  return nResult;
+}
+
+//*==============================================================================*/
+/*  TOOL_Report                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Print the totals of one kind of search
+ *
+ * \param     pName --> kind of search, pTotals --> totals
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Report(const char *pName, const TOOL_Totals *pTotals)
+{
+  printf("%s: %llu nodes in %.2f s plain, %llu nodes in %.2f s cut, %.1f%% fewer nodes, "
+         "%d and %d searches hit the limit\n", pName,
+         (unsigned long long)pTotals->arrNodes[0], pTotals->arrTimes[0],
+         (unsigned long long)pTotals->arrNodes[1], pTotals->arrTimes[1],
+         pTotals->arrNodes[0] ? 100.0 - 100.0 * pTotals->arrNodes[1] / pTotals->arrNodes[0] : 0.0,
+         pTotals->arrStopped[0], pTotals->arrStopped[1]);
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Search every game plain and cut, compare the results and report
+ * \n         the nodes of both.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if all results agree
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static TOOL_Search Search;
+  TOOL_Totals Clear = { 0 }, Best = { 0 };
+  SAGA_Board Board;
+  uint64_t nGame, nFirst = 1, nLimit = 10000000;
+  int nGames = 20, nColumns = 6, nRows = 5, nColors = NUMOFCOLORS, bVerbose = 0;
+  int nFailed = 0, nPlain, nCut, nOpt;
+
+  while((nOpt = getopt(argc, argv, "g:n:c:r:k:l:v")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      case 'l': nLimit = strtoull(optarg, NULL, 0); break;
+      case 'v': bVerbose = 1; break;
+      default:
+        fprintf(stderr, "usage: %s [-g first game] [-n games] [-c columns] [-r rows] [-k colors] "
+                "[-l node limit] [-v]\n", argv[0]);
+        return 2;
+    }
+  }
+  if(!SAGA_BoardIsValidSize(nColumns, nRows, nColors) || nLimit == 0)
+  {
+    fprintf(stderr, "%s: board or node limit out of range\n", argv[0]);
+    return 2;
+  }
+  //  A move removes at least two blocks, that limits the depth
+  Search.pGroups = malloc((nColumns * nRows / 2 + 1) * SAGA_MAXGROUPS * sizeof(SAGA_Group));
+  if(Search.pGroups == NULL)
+  {
+    fprintf(stderr, "%s: no memory for the move lists\n", argv[0]);
+    return 2;
+  }
+  Search.nLimit = nLimit;
+
+  for(nGame = nFirst; nGame < nFirst + nGames; nGame++)
+  {
+    SAGA_BoardInit(&Board, nColumns, nRows, nColors);
+    SAGA_BoardSetupGame(&Board, nGame);
+
+    //  Results of searches which hit the limit can't be compared
+    nPlain = TOOL_Run(&Search, &Board, false, false, &Clear);
+    nCut = TOOL_Run(&Search, &Board, false, true, &Clear);
+    if(nPlain != TOOL_STOPPED && nCut != TOOL_STOPPED && nPlain != nCut)
+    {
+      printf("game %llu: WRONG cut, the plain search says %s\n", (unsigned long long)nGame,
+             nPlain ? "cleared" : "dead");
+      nFailed++;
+    }
+    if(bVerbose)
+      printf("game %llu: %s", (unsigned long long)nGame,
+             nCut == TOOL_STOPPED ? "unknown" : nCut ? "cleared" : "dead");
+
+    nPlain = TOOL_Run(&Search, &Board, true, false, &Best);
+    nCut = TOOL_Run(&Search, &Board, true, true, &Best);
+    if(nPlain != TOOL_STOPPED && nCut != TOOL_STOPPED && nPlain != nCut)
+    {
+      printf("game %llu: WRONG cut, best score %d instead of %d\n", (unsigned long long)nGame,
+             nCut, nPlain);
+      nFailed++;
+    }
+    if(bVerbose)
+    {
+      if(nCut == TOOL_STOPPED)
+        printf(", best score unknown\n");
+      else
+        printf(", best score %d\n", nCut);
+    }
+  }
+
+  printf("%d games %dx%d with %d colors, limit of %llu nodes\n", nGames, nColumns, nRows, nColors,
+         (unsigned long long)nLimit);
+  TOOL_Report("clear", &Clear);
+  TOOL_Report("score", &Best);
+  free(Search.pGroups);
+  return nFailed > 0;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,765 @@
+/*********************************************************************************/
+/*!
+ * \file      sameseed.c
+ *
+ * \brief     The Same Game v0.1 --> SEED SWEEP TOOL File
+ *
+ * \details   Host tool which plays a range of numbered games with one of the
+ * \n         solvers and writes one result per game: whether it was
+ * \n         cleared, the best score, the nodes and the time. The greedy
+ * \n         solver always taps the largest group, the beam solver keeps
+ * \n         the best width positions of every layer and the exact solver
+ * \n         proves whether the board could be cleared.
+ * \n         Every thread owns a range of games and takes them from the
+ * \n         bottom, an idle thread steals the top half of the largest
+ * \n         range of another one, so a slow board never holds up the
+ * \n         rest. The results are written in the order of the games
+ * \n         through a window of TOOL_WINDOW slots, so the memory doesn't
+ * \n         grow with the range. The binary output is a shard of
+ * \n         seedfile.h, which sameshard merges with others. With an
+ * \n         output file a checkpoint is written every few seconds, -R
+ * \n         continues an interrupted sweep from it.
+ * \n
+ * \n         sameseed [-g first game] [-n games] [-c columns] [-r rows]
+ * \n                  [-k colors] [-s greedy|beam|exact] [-w beam width]
+ * \n                  [-l seconds per board] [-b table bits] [-t threads]
+ * \n                  [-f bin|csv] [-o file] [-i checkpoint seconds] [-R]
+ * \n                  [-v]
+ *
+ * \note      Hardware:    Linux host with pthreads
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include "solver.h"
+#include "seedfile.h"
+#include "beam.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+#define TOOL_MAXTHREADS  256
+// results between the oldest unwritten game and the newest one handed out
+#define TOOL_WINDOW      65536
+
+#define TOOL_BIN     0
+#define TOOL_CSV     1
+
+// own games of a thread, offsets lo .. hi - 1 packed into one word
+#define TOOL_RANGE(lo, hi)  ((uint64_t)(hi) << 32 | (uint32_t)(lo))
+#define TOOL_LO(range)      ((uint32_t)(range))
+#define TOOL_HI(range)      ((uint32_t)((range) >> 32))
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // state of an unfinished sweep, rewritten every few seconds
+  SEED_Header Header;                  // parameters of the whole sweep
+  int32_t nFormat;                     // TOOL_BIN or TOOL_CSV
+  uint32_t nReserved;
+  uint64_t nNext;                      // first game without a result in the output
+  uint64_t nOffset;                    // size of the output up to this game
+}TOOL_Checkpoint;
+
+typedef struct {  // summary of the written results
+  uint64_t nGames, nCleared, nUnknown, nNodes;
+  long long nScore;
+}TOOL_Total;
+
+struct TOOL_Sweep;
+
+typedef struct {  // search thread with its own range of games
+  pthread_t Thread;
+  struct TOOL_Sweep *pSweep;
+  uint64_t nRange;                     // own offsets, see TOOL_RANGE
+  int64_t nStart;                      // start of the current game in us, 0 if idle
+  int nStop;                           // stop flag of the exact solver
+  uint64_t nSteals;                    // ranges taken from other threads
+  SOLV_Table Table;                    // dead positions of the exact solver
+  BEAM_Search Beam;                    // beam layers of width positions
+  SAGA_Group arrGroups[SAGA_MAXGROUPS];
+  SAGA_Cell arrSolution[SAGA_MAXGROUPS];
+}TOOL_Worker;
+
+typedef struct TOOL_Sweep {  // state shared by all threads
+  SEED_Header Header;                  // parameters of the sweep
+  uint64_t nFirst;                     // first game of this run, offset 0
+  uint32_t nCount;                     // games of this run
+  uint32_t nNext;                      // first offset which wasn't handed out
+  uint32_t nWritten;                   // results written in the order of the games
+  uint32_t nChunk;                     // offsets handed out at once
+  int64_t nLimit;                      // time limit per game in us, 0 for none
+  int nThreads;
+  TOOL_Worker *pWorkers;
+  SEED_Record *pRecords;               // TOOL_WINDOW results, slot offset % TOOL_WINDOW
+  unsigned char *pReady;               // result of a slot is ready to be written
+}TOOL_Sweep;
+
+/*-------------------------------------------------------------------------------*/
+/*  Global variables                                                             */
+/*-------------------------------------------------------------------------------*/
+static volatile sig_atomic_t m_bQuit;  // SIGINT or SIGTERM, stop after a checkpoint
+
+static const char *m_arrSolvers[] = { "greedy", "beam", "exact" };
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Quit                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Signal handler, let the sweep stop at the next checkpoint
+ *
+ * \param     nSignal --> signal number
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Quit(int nSignal)
+{
+  (void)nSignal;
+  m_bQuit = 1;
+}
+
+//*==============================================================================*/
+/*  TOOL_Greedy                                                                  */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Play a board by always tapping the largest group
+ *
+ * \details   The first of equal groups, the lowest of the leftmost column,
+ * \n         is tapped.
+ *
+ * \param     pWorker --> thread, pBoard --> board, played to the end,
+ * \n         pRecord --> result
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Greedy(TOOL_Worker *pWorker, SAGA_Board *pBoard, SEED_Record *pRecord)
+{
+  int i, nGroups, nBest;
+
+  while((nGroups = SAGA_BoardEnumerateMoves(pBoard, pWorker->arrGroups, SAGA_MAXGROUPS, NULL)) > 0)
+  {
+    for(i = 1, nBest = 0; i < nGroups; i++)
+      if(pWorker->arrGroups[i].size > pWorker->arrGroups[nBest].size)
+        nBest = i;
+    SAGA_BoardDeleteBlocks(pBoard, pWorker->arrGroups[nBest].row, pWorker->arrGroups[nBest].col);
+    pRecord->nMoves++;
+  }
+  pRecord->nNodes = pRecord->nMoves + 1;
+  pRecord->nScore = pBoard->nScore;
+  pRecord->nClear = pBoard->nRemaining == 0;
+}
+
+//*==============================================================================*/
+/*  TOOL_Beam                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Beam search of a board in one thread
+ *
+ * \details   The layers of beam.c, so the score is the one of samebeam
+ * \n         with the same width. Only the score of the best finished game
+ * \n         is kept, not its line.
+ *
+ * \param     pWorker --> thread with the layers, pBoard --> board,
+ * \n         pRecord --> result
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Beam(TOOL_Worker *pWorker, const SAGA_Board *pBoard, SEED_Record *pRecord)
+{
+  BEAM_Search *pBeam = &pWorker->Beam;
+  int nDepth;
+
+  pRecord->nScore = -1;
+  BEAM_Start(pBeam, pBoard);
+  for(nDepth = 0; pBeam->nNodes > 0; nDepth++)
+  {
+    pRecord->nNodes += BEAM_Step(pBeam);
+    if(pBeam->nBestScore > pRecord->nScore)
+    {
+      pRecord->nScore = pBeam->nBestScore;
+      pRecord->nMoves = nDepth;
+    }
+    if(pBeam->bCleared)
+      pRecord->nClear = 1;
+  }
+}
+
+//*==============================================================================*/
+/*  TOOL_Exact                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Prove whether a board could be cleared
+ *
+ * \details   The table of dead positions is cleared for every board, so the
+ * \n         nodes don't depend on the boards the thread solved before. The
+ * \n         main thread sets the stop flag after the time limit, a stop
+ * \n         before it is left from the board before and the board is
+ * \n         solved again.
+ *
+ * \param     pWorker --> thread, pBoard --> board, pRecord --> result
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Exact(TOOL_Worker *pWorker, const SAGA_Board *pBoard, SEED_Record *pRecord)
+{
+  SOLV_Stats Stats;
+  SAGA_Board Replay;
+  int64_t nLimit = pWorker->pSweep->nLimit;
+  int i, nResult;
+
+  do
+  {
+    SOLV_TableClear(&pWorker->Table);
+    __atomic_store_n(&pWorker->nStop, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&pWorker->nStart, (int64_t)(TOOL_Now() * 1e6), __ATOMIC_RELEASE);
+    nResult = SOLV_Solve(pBoard, &pWorker->Table, 0, &pWorker->nStop, pWorker->arrSolution, &Stats);
+  }
+  while(nResult == SOLV_STOPPED && !m_bQuit &&
+        TOOL_Now() * 1e6 - __atomic_load_n(&pWorker->nStart, __ATOMIC_RELAXED) < nLimit);
+  __atomic_store_n(&pWorker->nStart, 0, __ATOMIC_RELEASE);
+
+  pRecord->nNodes = Stats.nNodes;
+  if(nResult >= 0)
+  {
+    SAGA_BoardCopy(&Replay, pBoard);
+    for(i = 0; i < nResult; i++)
+      SAGA_BoardDeleteBlocks(&Replay, pWorker->arrSolution[i].row, pWorker->arrSolution[i].col);
+    pRecord->nScore = Replay.nScore;
+    pRecord->nMoves = nResult;
+    pRecord->nClear = 1;
+  }
+  else
+    pRecord->nClear = nResult == SOLV_DEAD ? 0 : -1;
+}
+
+//*==============================================================================*/
+/*  TOOL_Pop                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Take the lowest game of the own range
+ *
+ * \param     pWorker --> thread, pOffset --> offset of the game
+ *
+ * \return    false if the range is empty
+ */
+/*===============================================================================*/
+static bool TOOL_Pop(TOOL_Worker *pWorker, uint32_t *pOffset)
+{
+  uint64_t nRange = __atomic_load_n(&pWorker->nRange, __ATOMIC_ACQUIRE);
+
+  do
+  {
+    if(TOOL_LO(nRange) >= TOOL_HI(nRange))
+      return false;
+  }
+  while(!__atomic_compare_exchange_n(&pWorker->nRange, &nRange,
+                                     TOOL_RANGE(TOOL_LO(nRange) + 1, TOOL_HI(nRange)), true,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+  *pOffset = TOOL_LO(nRange);
+  return true;
+}
+
+//*==============================================================================*/
+/*  TOOL_Steal                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Take the top half of the largest range of another thread
+ *
+ * \details   Only called with an empty own range. The owner takes from the
+ * \n         bottom and the thieves from the top of the same word, a game
+ * \n         leaves a range only by its owner, so a range never comes back
+ * \n         and the compare and swap can't be fooled.
+ *
+ * \param     pWorker --> thread
+ *
+ * \return    false if there was nothing to steal
+ */
+/*===============================================================================*/
+static bool TOOL_Steal(TOOL_Worker *pWorker)
+{
+  TOOL_Sweep *pSweep = pWorker->pSweep;
+  TOOL_Worker *pVictim;
+  uint64_t nRange;
+  uint32_t nMiddle;
+  int i, nBest, nSize, nBestSize;
+
+  for(;;)
+  {
+    for(i = 0, nBest = -1, nBestSize = 0; i < pSweep->nThreads; i++)
+    {
+      nRange = __atomic_load_n(&pSweep->pWorkers[i].nRange, __ATOMIC_RELAXED);
+      nSize = TOOL_HI(nRange) - TOOL_LO(nRange);
+      if(&pSweep->pWorkers[i] != pWorker && nSize > nBestSize)
+      {
+        nBest = i;
+        nBestSize = nSize;
+      }
+    }
+    if(nBest < 0)
+      return false;
+
+    pVictim = &pSweep->pWorkers[nBest];
+    nRange = __atomic_load_n(&pVictim->nRange, __ATOMIC_ACQUIRE);
+    if(TOOL_LO(nRange) >= TOOL_HI(nRange))
+      continue;
+    nMiddle = TOOL_LO(nRange) + (TOOL_HI(nRange) - TOOL_LO(nRange)) / 2;
+    if(__atomic_compare_exchange_n(&pVictim->nRange, &nRange, TOOL_RANGE(TOOL_LO(nRange), nMiddle),
+                                   false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+      __atomic_store_n(&pWorker->nRange, TOOL_RANGE(nMiddle, TOOL_HI(nRange)), __ATOMIC_RELEASE);
+      pWorker->nSteals++;
+      return true;
+    }
+  }
+}
+
+//*==============================================================================*/
+/*  TOOL_Grab                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Take a new chunk of games
+ *
+ * \details   Only called with an empty own range. No game is handed out
+ * \n         more than TOOL_WINDOW after the oldest unwritten one, its
+ * \n         slot would still be in use.
+ *
+ * \param     pWorker --> thread
+ *
+ * \return    1 if a chunk was taken, 0 if the window is full, -1 if all
+ * \n         games were handed out
+ */
+/*===============================================================================*/
+static int TOOL_Grab(TOOL_Worker *pWorker)
+{
+  TOOL_Sweep *pSweep = pWorker->pSweep;
+  uint32_t nNext = __atomic_load_n(&pSweep->nNext, __ATOMIC_RELAXED), nEnd;
+
+  do
+  {
+    if(nNext >= pSweep->nCount)
+      return -1;
+    nEnd = pSweep->nCount - nNext < pSweep->nChunk ? pSweep->nCount : nNext + pSweep->nChunk;
+    if(nEnd - __atomic_load_n(&pSweep->nWritten, __ATOMIC_ACQUIRE) > TOOL_WINDOW)
+      return 0;
+  }
+  while(!__atomic_compare_exchange_n(&pSweep->nNext, &nNext, nEnd, true, __ATOMIC_RELAXED,
+                                     __ATOMIC_RELAXED));
+  __atomic_store_n(&pWorker->nRange, TOOL_RANGE(nNext, nEnd), __ATOMIC_RELEASE);
+  return 1;
+}
+
+//*==============================================================================*/
+/*  TOOL_Run                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Thread function of a worker
+ *
+ * \details   Solve the own games, then steal, then take a new chunk. The
+ * \n         thread ends when there is nothing left to take. A game which
+ * \n         was stopped by a signal gets no result, it is solved again
+ * \n         when the sweep continues.
+ *
+ * \param     pArg --> worker
+ *
+ * \return    NULL
+ */
+/*===============================================================================*/
+static void *TOOL_Run(void *pArg)
+{
+  TOOL_Worker *pWorker = pArg;
+  TOOL_Sweep *pSweep = pWorker->pSweep;
+  struct timespec Sleep = { 0, 100000 };
+  SEED_Record *pRecord;
+  SAGA_Board Board;
+  uint32_t nOffset;
+  double fStart;
+  int nGrab;
+
+  while(!m_bQuit)
+  {
+    if(!TOOL_Pop(pWorker, &nOffset))
+    {
+      if(TOOL_Steal(pWorker))
+        continue;
+      if((nGrab = TOOL_Grab(pWorker)) < 0)
+        break;
+      if(nGrab == 0)
+        nanosleep(&Sleep, NULL);
+      continue;
+    }
+
+    pRecord = &pSweep->pRecords[nOffset % TOOL_WINDOW];
+    memset(pRecord, 0, sizeof(SEED_Record));
+    pRecord->nSeed = pSweep->nFirst + nOffset;
+    SAGA_BoardInit(&Board, pSweep->Header.nColumns, pSweep->Header.nRows, pSweep->Header.nColors);
+    SAGA_BoardSetupGame(&Board, pRecord->nSeed);
+    fStart = TOOL_Now();
+    if(pSweep->Header.nSolver == SEED_GREEDY)
+      TOOL_Greedy(pWorker, &Board, pRecord);
+    else if(pSweep->Header.nSolver == SEED_BEAM)
+      TOOL_Beam(pWorker, &Board, pRecord);
+    else
+      TOOL_Exact(pWorker, &Board, pRecord);
+    pRecord->nMicros = (uint32_t)((TOOL_Now() - fStart) * 1e6);
+    if(m_bQuit)
+      break;
+    __atomic_store_n(&pSweep->pReady[nOffset % TOOL_WINDOW], 1, __ATOMIC_RELEASE);
+  }
+  return NULL;
+}
+
+//*==============================================================================*/
+/*  TOOL_Write                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Write all results which are next in the order of the games
+ *
+ * \details   A slot is freed before the written count says so, the window
+ * \n         moves on with the count.
+ *
+ * \param     pSweep --> sweep, pOut --> output, nFormat --> TOOL_BIN or
+ * \n         TOOL_CSV, pTotal --> summary of the written results
+ *
+ * \return    number of results written
+ */
+/*===============================================================================*/
+static uint32_t TOOL_Write(TOOL_Sweep *pSweep, FILE *pOut, int nFormat, TOOL_Total *pTotal)
+{
+  const SEED_Record *pRecord;
+  uint32_t nWritten = pSweep->nWritten, nSlot, nCount = 0;
+
+  while(nWritten < pSweep->nCount)
+  {
+    nSlot = nWritten % TOOL_WINDOW;
+    if(!__atomic_load_n(&pSweep->pReady[nSlot], __ATOMIC_ACQUIRE))
+      break;
+    pRecord = &pSweep->pRecords[nSlot];
+    if(nFormat == TOOL_BIN)
+      fwrite(pRecord, sizeof(SEED_Record), 1, pOut);
+    else
+      fprintf(pOut, "%llu,%d,%d,%u,%llu,%u\n", (unsigned long long)pRecord->nSeed, pRecord->nClear,
+              pRecord->nScore, pRecord->nMoves, (unsigned long long)pRecord->nNodes,
+              pRecord->nMicros);
+    pTotal->nGames++;
+    pTotal->nCleared += pRecord->nClear > 0;
+    pTotal->nUnknown += pRecord->nClear < 0;
+    pTotal->nNodes += pRecord->nNodes;
+    pTotal->nScore += pRecord->nScore;
+    __atomic_store_n(&pSweep->pReady[nSlot], 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&pSweep->nWritten, ++nWritten, __ATOMIC_RELEASE);
+    nCount++;
+  }
+  return nCount;
+}
+
+//*==============================================================================*/
+/*  TOOL_Save                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Save how far the sweep got
+ *
+ * \details   The output is synced first, then the checkpoint is written to
+ * \n         a new file which replaces the old one, so there is always a
+ * \n         valid checkpoint for the data on the disk.
+ *
+ * \param     pSweep --> sweep, pOut --> output, pPath --> checkpoint file,
+ * \n         nFormat --> TOOL_BIN or TOOL_CSV
+ *
+ * \return    false if it couldn't be written
+ */
+/*===============================================================================*/
+static bool TOOL_Save(const TOOL_Sweep *pSweep, FILE *pOut, const char *pPath, int nFormat)
+{
+  TOOL_Checkpoint Checkpoint = { 0 };
+  char arrTemp[4096];
+  FILE *pFile;
+  bool bOk;
+
+  if(fflush(pOut) != 0 || fsync(fileno(pOut)) != 0)
+    return false;
+  Checkpoint.Header = pSweep->Header;
+  Checkpoint.nFormat = nFormat;
+  Checkpoint.nNext = pSweep->nFirst + pSweep->nWritten;
+  Checkpoint.nOffset = ftello(pOut);
+
+  snprintf(arrTemp, sizeof(arrTemp), "%s.tmp", pPath);
+  pFile = fopen(arrTemp, "wb");
+  if(pFile == NULL)
+    return false;
+  bOk = fwrite(&Checkpoint, sizeof(Checkpoint), 1, pFile) == 1 && fflush(pFile) == 0 &&
+        fsync(fileno(pFile)) == 0;
+  bOk = fclose(pFile) == 0 && bOk;
+  return bOk && rename(arrTemp, pPath) == 0;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Set up or continue the sweep, start the threads and write the
+ * \n         results while they run. The main thread also stops exact
+ * \n         searches after the time limit and writes the checkpoints.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if the sweep is complete, 1 if it was interrupted or the
+ * \n         checkpoint failed
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static TOOL_Worker arrWorkers[TOOL_MAXTHREADS];
+  static TOOL_Sweep Sweep;
+  struct timespec Sleep = { 0, 1000000 };
+  TOOL_Checkpoint Checkpoint;
+  SEED_Header *pHeader = &Sweep.Header;
+  TOOL_Total Total = { 0 };
+  const char *pOutput = NULL;
+  char arrPath[4096];
+  FILE *pOut = stdout, *pFile;
+  uint64_t nFirst = 1, nCount = 1000, nSteals = 0;
+  int nColumns = NUMOFCOLUMN, nRows = NUMOFROWS, nColors = NUMOFCOLORS, nSolver = SEED_GREEDY;
+  int nWidth = 100, nBits = 16, nThreads = sysconf(_SC_NPROCESSORS_ONLN), nFormat = TOOL_CSV;
+  int bResume = 0, bVerbose = 0, bOk = 1, nOpt, i;
+  int64_t nStart;
+  double fLimit = 0, fInterval = 10, fStart, fSaved;
+
+  while((nOpt = getopt(argc, argv, "g:n:c:r:k:s:w:l:b:t:f:o:i:Rv")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nCount = strtoull(optarg, NULL, 0); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      case 's':
+        for(nSolver = 0; nSolver <= SEED_EXACT; nSolver++)
+          if(strcmp(optarg, m_arrSolvers[nSolver]) == 0)
+            break;
+        break;
+      case 'w': nWidth = atoi(optarg); break;
+      case 'l': fLimit = atof(optarg); break;
+      case 'b': nBits = atoi(optarg); break;
+      case 't': nThreads = atoi(optarg); break;
+      case 'f':
+        nFormat = strcmp(optarg, "bin") == 0 ? TOOL_BIN : -1;
+        nFormat = strcmp(optarg, "csv") == 0 ? TOOL_CSV : nFormat;
+        break;
+      case 'o': pOutput = optarg; break;
+      case 'i': fInterval = atof(optarg); break;
+      case 'R': bResume = 1; break;
+      case 'v': bVerbose = 1; break;
+      default:
+        fprintf(stderr, "usage: %s [-g first game] [-n games] [-c columns] [-r rows] [-k colors] "
+                "[-s greedy|beam|exact] [-w beam width] [-l seconds per board] [-b table bits] "
+                "[-t threads] [-f bin|csv] [-o file] [-i checkpoint seconds] [-R] [-v]\n", argv[0]);
+        return 2;
+    }
+  }
+
+  //  A resumed sweep takes all parameters but the threads from its checkpoint
+  if(bResume)
+  {
+    if(pOutput == NULL)
+    {
+      fprintf(stderr, "%s: -R needs the output file of the sweep\n", argv[0]);
+      return 2;
+    }
+    snprintf(arrPath, sizeof(arrPath), "%s.ckpt", pOutput);
+    pFile = fopen(arrPath, "rb");
+    if(pFile == NULL || fread(&Checkpoint, sizeof(Checkpoint), 1, pFile) != 1 ||
+       memcmp(Checkpoint.Header.arrMagic, SEED_MAGIC, sizeof(Checkpoint.Header.arrMagic)) != 0 ||
+       Checkpoint.Header.nVersion != SEED_VERSION)
+    {
+      fprintf(stderr, "%s: %s is no checkpoint of a sweep\n", argv[0], arrPath);
+      return 2;
+    }
+    fclose(pFile);
+    *pHeader = Checkpoint.Header;
+    nFormat = Checkpoint.nFormat;
+    nFirst = Checkpoint.nNext;
+    nCount = pHeader->nFirst + pHeader->nCount - Checkpoint.nNext;
+    nColumns = pHeader->nColumns;
+    nRows = pHeader->nRows;
+    nColors = pHeader->nColors;
+    nSolver = pHeader->nSolver;
+    nBits = pHeader->nBits;
+    nWidth = pHeader->nSolver == SEED_BEAM ? (int)pHeader->nParam : nWidth;
+    fLimit = pHeader->nSolver == SEED_EXACT ? pHeader->nParam * 1e-3 : fLimit;
+  }
+  if(!SAGA_BoardIsValidSize(nColumns, nRows, nColors) ||
+     nSolver > SEED_EXACT || nWidth < 1 || fLimit < 0 || nBits < 2 || nBits > 40 ||
+     nThreads < 1 || nThreads > TOOL_MAXTHREADS || nFormat < 0 || nCount > UINT32_MAX ||
+     (nFormat == TOOL_BIN && pOutput == NULL))
+  {
+    fprintf(stderr, "%s: parameters out of range, at most 2^32 - 1 games at once, binary results "
+            "need an output file\n", argv[0]);
+    return 2;
+  }
+  if(!bResume)
+  {
+    memcpy(pHeader->arrMagic, SEED_MAGIC, sizeof(pHeader->arrMagic));
+    pHeader->nVersion = SEED_VERSION;
+    pHeader->nColumns = nColumns;
+    pHeader->nRows = nRows;
+    pHeader->nColors = nColors;
+    pHeader->nSolver = nSolver;
+    pHeader->nBits = nBits;
+    pHeader->nParam = nSolver == SEED_BEAM ? (uint32_t)nWidth : (uint32_t)(fLimit * 1e3);
+    pHeader->nFirst = nFirst;
+    pHeader->nCount = nCount;
+  }
+
+  //  A new output starts with its header, a resumed one loses what came after the checkpoint
+  if(pOutput != NULL)
+  {
+    pOut = fopen(pOutput, bResume ? "r+b" : "wb");
+    if(pOut == NULL || (bResume && (ftruncate(fileno(pOut), Checkpoint.nOffset) != 0 ||
+                                    fseeko(pOut, 0, SEEK_END) != 0)))
+    {
+      fprintf(stderr, "%s: can't open %s\n", argv[0], pOutput);
+      return 2;
+    }
+    snprintf(arrPath, sizeof(arrPath), "%s.ckpt", pOutput);
+  }
+  if(!bResume)
+  {
+    if(nFormat == TOOL_BIN)
+      fwrite(pHeader, sizeof(SEED_Header), 1, pOut);
+    else
+      fprintf(pOut, "seed,clear,score,moves,nodes,us\n");
+  }
+
+  Sweep.nFirst = nFirst;
+  Sweep.nCount = (uint32_t)nCount;
+  Sweep.nChunk = TOOL_WINDOW / (4 * nThreads);
+  Sweep.nLimit = (int64_t)(fLimit * 1e6);
+  Sweep.nThreads = nThreads;
+  Sweep.pWorkers = arrWorkers;
+  Sweep.pRecords = calloc(TOOL_WINDOW, sizeof(SEED_Record));
+  Sweep.pReady = calloc(TOOL_WINDOW, 1);
+  for(i = 0; i < nThreads; i++)
+  {
+    arrWorkers[i].pSweep = &Sweep;
+    if(nSolver == SEED_EXACT)
+      bOk &= SOLV_TableInit(&arrWorkers[i].Table, nBits);
+    if(nSolver == SEED_BEAM)
+      bOk &= BEAM_Init(&arrWorkers[i].Beam, nWidth);
+  }
+  if(!bOk || Sweep.pRecords == NULL || Sweep.pReady == NULL)
+  {
+    fprintf(stderr, "%s: out of memory\n", argv[0]);
+    return 2;
+  }
+
+  signal(SIGINT, TOOL_Quit);
+  signal(SIGTERM, TOOL_Quit);
+  for(i = 0; i < nThreads; i++)
+    pthread_create(&arrWorkers[i].Thread, NULL, TOOL_Run, &arrWorkers[i]);
+
+  //  Write the results in order, stop long searches and save the progress
+  fStart = fSaved = TOOL_Now();
+  while(Sweep.nWritten < Sweep.nCount && !m_bQuit)
+  {
+    if(TOOL_Write(&Sweep, pOut, nFormat, &Total) > 0)
+      continue;
+    nanosleep(&Sleep, NULL);
+    for(i = 0; Sweep.nLimit > 0 && i < nThreads; i++)
+    {
+      nStart = __atomic_load_n(&arrWorkers[i].nStart, __ATOMIC_ACQUIRE);
+      if(nStart != 0 && TOOL_Now() * 1e6 - nStart >= Sweep.nLimit)
+        __atomic_store_n(&arrWorkers[i].nStop, 1, __ATOMIC_RELAXED);
+    }
+    if(TOOL_Now() - fSaved >= fInterval)
+    {
+      if(pOutput != NULL && !TOOL_Save(&Sweep, pOut, arrPath, nFormat))
+        fprintf(stderr, "%s: can't write the checkpoint %s\n", argv[0], arrPath);
+      if(bVerbose)
+        fprintf(stderr, "%llu of %llu games, %.0f games/s\n", (unsigned long long)Total.nGames,
+                (unsigned long long)nCount, Total.nGames / (TOOL_Now() - fStart));
+      fSaved = TOOL_Now();
+    }
+  }
+
+  //  On a signal the searches are stopped, their games come again with -R
+  for(i = 0; m_bQuit && i < nThreads; i++)
+    __atomic_store_n(&arrWorkers[i].nStop, 1, __ATOMIC_RELAXED);
+  for(i = 0; i < nThreads; i++)
+  {
+    pthread_join(arrWorkers[i].Thread, NULL);
+    nSteals += arrWorkers[i].nSteals;
+  }
+  TOOL_Write(&Sweep, pOut, nFormat, &Total);
+  if(pOutput != NULL && !TOOL_Save(&Sweep, pOut, arrPath, nFormat))
+  {
+    fprintf(stderr, "%s: can't write the checkpoint %s\n", argv[0], arrPath);
+    bOk = 0;
+  }
+  if(pOutput != NULL)
+    fclose(pOut);
+  else
+    fflush(pOut);
+
+  fprintf(stderr, "%llu games %dx%d with %d colors, %s on %d threads: %llu cleared, %llu unknown, "
+          "average score %.1f\n", (unsigned long long)Total.nGames, nColumns, nRows, nColors,
+          m_arrSolvers[nSolver], nThreads, (unsigned long long)Total.nCleared,
+          (unsigned long long)Total.nUnknown,
+          Total.nGames > 0 ? (double)Total.nScore / Total.nGames : 0);
+  fprintf(stderr, "%.3f s, %.0f games/s, %llu nodes, %llu steals%s\n", TOOL_Now() - fStart,
+          Total.nGames / (TOOL_Now() - fStart), (unsigned long long)Total.nNodes,
+          (unsigned long long)nSteals,
+          Sweep.nWritten < Sweep.nCount ? ", INTERRUPTED, continue with -R" : "");
+  for(i = 0; i < nThreads; i++)
+  {
+    if(nSolver == SEED_EXACT)
+      SOLV_TableFree(&arrWorkers[i].Table);
+    BEAM_Free(&arrWorkers[i].Beam);
+  }
+  free(Sweep.pRecords);
+  free(Sweep.pReady);
+  return !bOk || Sweep.nWritten < Sweep.nCount;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,590 @@
+/*********************************************************************************/
+/*!
+ * \file      sameshard.c
+ *
+ * \brief     The Same Game v0.1 --> SHARD TOOL File
+ *
+ * \details   Host tool which splits a sweep of sameseed across processes
+ * \n         and hosts and puts the results together again.
+ * \n         plan prints one sameseed command per shard, each one writes a
+ * \n         binary shard of its own range and could be continued with -R
+ * \n         on its own. merge reads the shards in one pass, always taking
+ * \n         the lowest game of all of them, and writes the database of
+ * \n         seedfile.h. Only a small buffer per shard is held, so the memory
+ * \n         doesn't grow with the sweep. find looks games up in a
+ * \n         database by its index, diff compares two shards or databases
+ * \n         without the times, e.g. a sharded sweep against one process.
+ * \n
+ * \n         sameshard plan -g first game -n games -p shards -o prefix
+ * \n                        [-- sameseed options]
+ * \n         sameshard merge -o database shard...
+ * \n         sameshard find database game...
+ * \n         sameshard diff file file
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "seedfile.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+#define TOOL_MAXSHARDS  1024
+// read buffer of every shard
+#define TOOL_BUFFER     65536
+// differences printed by diff
+#define TOOL_MAXDIFFS   10
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // shard or database read record by record
+  const char *pPath;
+  FILE *pFile;
+  SEED_Header Header;                  // parameters of the games
+  uint64_t nRecords;                   // records in the file
+  uint64_t nRead;                      // records read so far
+  SEED_Record Record;                  // last record read
+}TOOL_Input;
+
+//*==============================================================================*/
+/*  TOOL_Open                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Open a shard or a database for reading
+ *
+ * \details   The records of a shard are counted from the file size, an
+ * \n         interrupted shard has less of them than its header says.
+ *
+ * \param     pInput --> input, pPath --> file name
+ *
+ * \return    false if the file is missing or no result file
+ */
+/*===============================================================================*/
+static bool TOOL_Open(TOOL_Input *pInput, const char *pPath)
+{
+  SEED_Database Database;
+  struct stat Stat;
+  char arrMagic[4];
+
+  memset(pInput, 0, sizeof(TOOL_Input));
+  pInput->pPath = pPath;
+  pInput->pFile = fopen(pPath, "rb");
+  if(pInput->pFile == NULL || fstat(fileno(pInput->pFile), &Stat) != 0 ||
+     fread(arrMagic, sizeof(arrMagic), 1, pInput->pFile) != 1)
+    return false;
+  rewind(pInput->pFile);
+  if(memcmp(arrMagic, SEED_MAGIC, sizeof(arrMagic)) == 0)
+  {
+    if(fread(&pInput->Header, sizeof(SEED_Header), 1, pInput->pFile) != 1)
+      return false;
+    pInput->nRecords = (Stat.st_size - sizeof(SEED_Header)) / sizeof(SEED_Record);
+  }
+  else if(memcmp(arrMagic, SEED_DBMAGIC, sizeof(arrMagic)) == 0)
+  {
+    if(fread(&Database, sizeof(Database), 1, pInput->pFile) != 1)
+      return false;
+    pInput->Header = Database.Sweep;
+    pInput->nRecords = Database.nRecords;
+  }
+  else
+    return false;
+  setvbuf(pInput->pFile, NULL, _IOFBF, TOOL_BUFFER);
+  return pInput->Header.nVersion == SEED_VERSION;
+}
+
+//*==============================================================================*/
+/*  TOOL_Read                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Read the next record of an input
+ *
+ * \param     pInput --> input
+ *
+ * \return    false at the end
+ */
+/*===============================================================================*/
+static bool TOOL_Read(TOOL_Input *pInput)
+{
+  if(pInput->nRead >= pInput->nRecords ||
+     fread(&pInput->Record, sizeof(SEED_Record), 1, pInput->pFile) != 1)
+    return false;
+  pInput->nRead++;
+  return true;
+}
+
+//*==============================================================================*/
+/*  TOOL_SameGames                                                               */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Check if two sweeps played the games the same way
+ *
+ * \param     pA, pB --> headers
+ *
+ * \return    true if the boards and the solvers are equal
+ */
+/*===============================================================================*/
+static bool TOOL_SameGames(const SEED_Header *pA, const SEED_Header *pB)
+{
+  return pA->nColumns == pB->nColumns && pA->nRows == pB->nRows && pA->nColors == pB->nColors &&
+         pA->nSolver == pB->nSolver && pA->nBits == pB->nBits && pA->nParam == pB->nParam;
+}
+
+//*==============================================================================*/
+/*  TOOL_SameResult                                                              */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Check if two records have the same result
+ *
+ * \details   The time depends on the host and the load, it is ignored.
+ *
+ * \param     pA, pB --> records
+ *
+ * \return    true if everything but the time is equal
+ */
+/*===============================================================================*/
+static bool TOOL_SameResult(const SEED_Record *pA, const SEED_Record *pB)
+{
+  return pA->nSeed == pB->nSeed && pA->nNodes == pB->nNodes && pA->nScore == pB->nScore &&
+         pA->nClear == pB->nClear && pA->nMoves == pB->nMoves;
+}
+
+//*==============================================================================*/
+/*  TOOL_Print                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Print a record like the CSV of sameseed
+ *
+ * \param     pRecord --> record
+ *
+ * \return    none
+ */
+/*===============================================================================*/
+static void TOOL_Print(const SEED_Record *pRecord)
+{
+  printf("%llu,%d,%d,%u,%llu,%u\n", (unsigned long long)pRecord->nSeed, pRecord->nClear,
+         pRecord->nScore, pRecord->nMoves, (unsigned long long)pRecord->nNodes, pRecord->nMicros);
+}
+
+//*==============================================================================*/
+/*  TOOL_Plan                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Print the commands of all shards
+ *
+ * \details   The games are split into shards of equal size. More shards
+ * \n         than processes keep all of them busy until the end, a free
+ * \n         process just takes the next command, e.g. with xargs -P.
+ *
+ * \param     argc, argv --> arguments after plan
+ *
+ * \return    exit code
+ */
+/*===============================================================================*/
+static int TOOL_Plan(int argc, char **argv)
+{
+  const char *pPrefix = NULL;
+  uint64_t nFirst = 1, nCount = 0, nSize, nRest, nStart, k;
+  int nShards = 0, nOpt, i;
+
+  while((nOpt = getopt(argc, argv, "g:n:p:o:")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nCount = strtoull(optarg, NULL, 0); break;
+      case 'p': nShards = atoi(optarg); break;
+      case 'o': pPrefix = optarg; break;
+      default: return 2;
+    }
+  }
+  if(nCount == 0 || nShards < 1 || (uint64_t)nShards > nCount || nShards > TOOL_MAXSHARDS ||
+     pPrefix == NULL || nCount / nShards >= UINT32_MAX)
+  {
+    fprintf(stderr, "sameshard plan: games, shards or prefix missing or out of range\n");
+    return 2;
+  }
+
+  //  The first shards get one game more if they don't split evenly
+  nSize = nCount / nShards;
+  nRest = nCount % nShards;
+  for(k = 0, nStart = nFirst; k < (uint64_t)nShards; k++)
+  {
+    printf("./sameseed -g %llu -n %llu -f bin -o %s-%04d.bin", (unsigned long long)nStart,
+           (unsigned long long)(nSize + (k < nRest)), pPrefix, (int)k);
+    nStart += nSize + (k < nRest);
+    for(i = optind; i < argc; i++)
+      printf(" %s", argv[i]);
+    printf("\n");
+  }
+  return 0;
+}
+
+//*==============================================================================*/
+/*  TOOL_Merge                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Merge shards into a database
+ *
+ * \details   The inputs are kept in a heap by their next game, the lowest
+ * \n         one is written and replaced by the next record of its input.
+ * \n         A game in several shards, e.g. of a range run twice, is kept
+ * \n         once, it must have the same result everywhere. The index is
+ * \n         collected in a temporary file and put behind the records,
+ * \n         then the header is written with the final counts.
+ *
+ * \param     argc, argv --> arguments after merge
+ *
+ * \return    exit code
+ */
+/*===============================================================================*/
+static int TOOL_Merge(int argc, char **argv)
+{
+  static TOOL_Input arrInputs[TOOL_MAXSHARDS];
+  static int arrHeap[TOOL_MAXSHARDS];
+  SEED_Database Database = { 0 };
+  SEED_Record Last = { 0 };
+  const char *pOutput = NULL;
+  char arrBuffer[TOOL_BUFFER];
+  FILE *pOut, *pIndex;
+  uint64_t nFirst = 0, nDuplicates = 0, nGaps = 0, nOffset;
+  int nInputs, nHeap, nChild, nTop, nConflicts = 0, nOpt, i, j;
+  size_t nSize;
+
+  while((nOpt = getopt(argc, argv, "o:")) != -1)
+  {
+    if(nOpt != 'o')
+      return 2;
+    pOutput = optarg;
+  }
+  nInputs = argc - optind;
+  if(pOutput == NULL || nInputs < 1 || nInputs > TOOL_MAXSHARDS)
+  {
+    fprintf(stderr, "sameshard merge: output or shards missing, at most %d shards\n",
+            TOOL_MAXSHARDS);
+    return 2;
+  }
+
+  //  Every shard must be complete and of the same games
+  for(i = 0; i < nInputs; i++)
+  {
+    if(!TOOL_Open(&arrInputs[i], argv[optind + i]))
+    {
+      fprintf(stderr, "sameshard merge: %s is no shard or database\n", argv[optind + i]);
+      return 2;
+    }
+    if(!TOOL_SameGames(&arrInputs[i].Header, &arrInputs[0].Header))
+    {
+      fprintf(stderr, "sameshard merge: %s has other boards or another solver than %s\n",
+              argv[optind + i], argv[optind]);
+      return 2;
+    }
+    if(memcmp(arrInputs[i].Header.arrMagic, SEED_MAGIC, 4) == 0 &&
+       arrInputs[i].nRecords < arrInputs[i].Header.nCount)
+    {
+      fprintf(stderr, "sameshard merge: %s has %llu of %llu games, continue it with "
+              "./sameseed -R -o %s\n", argv[optind + i], (unsigned long long)arrInputs[i].nRecords,
+              (unsigned long long)arrInputs[i].Header.nCount, argv[optind + i]);
+      return 2;
+    }
+  }
+
+  pOut = fopen(pOutput, "wb");
+  pIndex = tmpfile();
+  if(pOut == NULL || pIndex == NULL)
+  {
+    fprintf(stderr, "sameshard merge: can't create %s\n", pOutput);
+    return 2;
+  }
+  setvbuf(pOut, NULL, _IOFBF, TOOL_BUFFER);
+  fwrite(&Database, sizeof(Database), 1, pOut);
+
+  //  Min heap of the inputs by their next game, the earlier input first
+  for(i = 0, nHeap = 0; i < nInputs; i++)
+  {
+    if(!TOOL_Read(&arrInputs[i]))
+      continue;
+    for(j = nHeap++; j > 0; j = (j - 1) / 2)
+    {
+      nTop = arrHeap[(j - 1) / 2];
+      if(arrInputs[nTop].Record.nSeed < arrInputs[i].Record.nSeed ||
+         (arrInputs[nTop].Record.nSeed == arrInputs[i].Record.nSeed && nTop < i))
+        break;
+      arrHeap[j] = nTop;
+    }
+    arrHeap[j] = i;
+  }
+
+  while(nHeap > 0)
+  {
+    nTop = arrHeap[0];
+    if(Database.nRecords > 0 && arrInputs[nTop].Record.nSeed == Last.nSeed)
+    {
+      nDuplicates++;
+      if(!TOOL_SameResult(&arrInputs[nTop].Record, &Last) && nConflicts++ < TOOL_MAXDIFFS)
+        fprintf(stderr, "sameshard merge: game %llu differs in %s\n",
+                (unsigned long long)Last.nSeed, arrInputs[nTop].pPath);
+    }
+    else
+    {
+      if(Database.nRecords > 0)
+        nGaps += arrInputs[nTop].Record.nSeed - Last.nSeed - 1;
+      else
+        nFirst = arrInputs[nTop].Record.nSeed;
+      if(Database.nRecords % SEED_STRIDE == 0)
+        fwrite(&arrInputs[nTop].Record.nSeed, sizeof(uint64_t), 1, pIndex);
+      fwrite(&arrInputs[nTop].Record, sizeof(SEED_Record), 1, pOut);
+      Last = arrInputs[nTop].Record;
+      Database.nRecords++;
+    }
+
+    //  Sift the next record of the input down, or the last input at its place
+    if(!TOOL_Read(&arrInputs[nTop]))
+      nTop = arrHeap[--nHeap];
+    for(i = 0; (nChild = 2 * i + 1) < nHeap; i = nChild)
+    {
+      if(nChild + 1 < nHeap &&
+         (arrInputs[arrHeap[nChild + 1]].Record.nSeed < arrInputs[arrHeap[nChild]].Record.nSeed ||
+          (arrInputs[arrHeap[nChild + 1]].Record.nSeed == arrInputs[arrHeap[nChild]].Record.nSeed &&
+           arrHeap[nChild + 1] < arrHeap[nChild])))
+        nChild++;
+      if(arrInputs[nTop].Record.nSeed < arrInputs[arrHeap[nChild]].Record.nSeed ||
+         (arrInputs[nTop].Record.nSeed == arrInputs[arrHeap[nChild]].Record.nSeed &&
+          nTop < arrHeap[nChild]))
+        break;
+      arrHeap[i] = arrHeap[nChild];
+    }
+    if(nHeap > 0)
+      arrHeap[i] = nTop;
+  }
+
+  //  The index behind the records, then the header with the counts
+  nOffset = sizeof(Database) + Database.nRecords * sizeof(SEED_Record);
+  rewind(pIndex);
+  while((nSize = fread(arrBuffer, 1, sizeof(arrBuffer), pIndex)) > 0)
+    fwrite(arrBuffer, 1, nSize, pOut);
+  fclose(pIndex);
+  memcpy(Database.arrMagic, SEED_DBMAGIC, sizeof(Database.arrMagic));
+  Database.nStride = SEED_STRIDE;
+  Database.nIndex = nOffset;
+  Database.Sweep = arrInputs[0].Header;
+  Database.Sweep.nFirst = nFirst;
+  Database.Sweep.nCount = Database.nRecords > 0 ? Last.nSeed - nFirst + 1 : 0;
+  for(i = 0; i < nInputs; i++)
+    fclose(arrInputs[i].pFile);
+  if(fseek(pOut, 0, SEEK_SET) != 0 || fwrite(&Database, sizeof(Database), 1, pOut) != 1 ||
+     fclose(pOut) != 0)
+  {
+    fprintf(stderr, "sameshard merge: can't write %s\n", pOutput);
+    return 2;
+  }
+
+  printf("%d shards merged into %s: %llu games from %llu to %llu, %llu missing, %llu duplicates, "
+         "%d conflicts\n", nInputs, pOutput, (unsigned long long)Database.nRecords,
+         (unsigned long long)nFirst, (unsigned long long)Last.nSeed,
+         (unsigned long long)nGaps, (unsigned long long)nDuplicates, nConflicts);
+  return nConflicts > 0;
+}
+
+//*==============================================================================*/
+/*  TOOL_Find                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Look up games in a database
+ *
+ * \details   The file is mapped, a binary search in the index finds the
+ * \n         stride of the game and another one the record in it.
+ *
+ * \param     argc, argv --> arguments after find
+ *
+ * \return    exit code
+ */
+/*===============================================================================*/
+static int TOOL_Find(int argc, char **argv)
+{
+  const SEED_Database *pDatabase;
+  const SEED_Record *pRecords;
+  const uint64_t *pIndex;
+  struct stat Stat;
+  uint64_t nSeed, nEntries, nLow, nHigh, nMiddle;
+  FILE *pFile;
+  void *pData;
+  int nMissing = 0, i;
+
+  if(argc < 3 || (pFile = fopen(argv[1], "rb")) == NULL || fstat(fileno(pFile), &Stat) != 0 ||
+     (size_t)Stat.st_size < sizeof(SEED_Database))
+  {
+    fprintf(stderr, "sameshard find: database missing\n");
+    return 2;
+  }
+  pData = mmap(NULL, Stat.st_size, PROT_READ, MAP_SHARED, fileno(pFile), 0);
+  fclose(pFile);
+  pDatabase = pData;
+  if(pData == MAP_FAILED || memcmp(pDatabase->arrMagic, SEED_DBMAGIC, 4) != 0 ||
+     pDatabase->nStride == 0)
+  {
+    fprintf(stderr, "sameshard find: %s is no database\n", argv[1]);
+    return 2;
+  }
+  pRecords = (const SEED_Record *)(pDatabase + 1);
+  pIndex = (const uint64_t *)((const char *)pData + pDatabase->nIndex);
+  nEntries = (pDatabase->nRecords + pDatabase->nStride - 1) / pDatabase->nStride;
+
+  printf("seed,clear,score,moves,nodes,us\n");
+  for(i = 2; i < argc; i++)
+  {
+    nSeed = strtoull(argv[i], NULL, 0);
+
+    //  Last stride which starts at or below the game
+    for(nLow = 0, nHigh = nEntries; nHigh - nLow > 1; )
+    {
+      nMiddle = (nLow + nHigh) / 2;
+      if(pIndex[nMiddle] <= nSeed)
+        nLow = nMiddle;
+      else
+        nHigh = nMiddle;
+    }
+    nHigh = (nLow + 1) * pDatabase->nStride;
+    nHigh = nHigh < pDatabase->nRecords ? nHigh : pDatabase->nRecords;
+    for(nLow *= pDatabase->nStride; nLow < nHigh; )
+    {
+      nMiddle = (nLow + nHigh) / 2;
+      if(pRecords[nMiddle].nSeed < nSeed)
+        nLow = nMiddle + 1;
+      else
+        nHigh = nMiddle;
+    }
+    if(nLow < pDatabase->nRecords && pRecords[nLow].nSeed == nSeed)
+      TOOL_Print(&pRecords[nLow]);
+    else
+    {
+      fprintf(stderr, "game %llu is not in the database\n", (unsigned long long)nSeed);
+      nMissing++;
+    }
+  }
+  munmap(pData, Stat.st_size);
+  return nMissing > 0;
+}
+
+//*==============================================================================*/
+/*  TOOL_Diff                                                                    */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Compare two shards or databases
+ *
+ * \details   Both are read in the order of the games, the times are not
+ * \n         compared.
+ *
+ * \param     argc, argv --> arguments after diff
+ *
+ * \return    0 if both have the same results
+ */
+/*===============================================================================*/
+static int TOOL_Diff(int argc, char **argv)
+{
+  TOOL_Input A, B;
+  uint64_t nSame = 0, nDiffs = 0;
+  bool bA, bB;
+
+  if(argc != 3 || !TOOL_Open(&A, argv[1]) || !TOOL_Open(&B, argv[2]))
+  {
+    fprintf(stderr, "sameshard diff: two shards or databases needed\n");
+    return 2;
+  }
+  if(!TOOL_SameGames(&A.Header, &B.Header))
+  {
+    printf("%s and %s have other boards or solvers\n", argv[1], argv[2]);
+    return 1;
+  }
+
+  bA = TOOL_Read(&A);
+  bB = TOOL_Read(&B);
+  while(bA || bB)
+  {
+    if(bA && bB && TOOL_SameResult(&A.Record, &B.Record))
+      nSame++;
+    else if(nDiffs++ < TOOL_MAXDIFFS)
+    {
+      printf("< ");
+      if(bA)
+        TOOL_Print(&A.Record);
+      else
+        printf("end\n");
+      printf("> ");
+      if(bB)
+        TOOL_Print(&B.Record);
+      else
+        printf("end\n");
+    }
+
+    //  Step the lower game, or both
+    if(bA && bB && A.Record.nSeed != B.Record.nSeed)
+    {
+      if(A.Record.nSeed < B.Record.nSeed)
+        bA = TOOL_Read(&A);
+      else
+        bB = TOOL_Read(&B);
+    }
+    else
+    {
+      bA = bA && TOOL_Read(&A);
+      bB = bB && TOOL_Read(&B);
+    }
+  }
+  fclose(A.pFile);
+  fclose(B.pFile);
+  printf("%llu games equal, %llu differ\n", (unsigned long long)nSame, (unsigned long long)nDiffs);
+  return nDiffs > 0;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \param     argc, argv
+ *
+ * \return    0 on success
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  int nResult = 2;
+
+  if(argc >= 2 && strcmp(argv[1], "plan") == 0)
+    nResult = TOOL_Plan(argc - 1, argv + 1);
+  else if(argc >= 2 && strcmp(argv[1], "merge") == 0)
+    nResult = TOOL_Merge(argc - 1, argv + 1);
+  else if(argc >= 2 && strcmp(argv[1], "find") == 0)
+    nResult = TOOL_Find(argc - 1, argv + 1);
+  else if(argc >= 2 && strcmp(argv[1], "diff") == 0)
+    nResult = TOOL_Diff(argc - 1, argv + 1);
+  if(nResult == 2)
+    fprintf(stderr, "usage: %s plan -g first game -n games -p shards -o prefix "
+            "[-- sameseed options]\n"
+            "       %s merge -o database shard...\n"
+            "       %s find database game...\n"
+            "       %s diff file file\n", argv[0], argv[0], argv[0], argv[0]);
+  return nResult;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,268 @@
+/*********************************************************************************/
+/*!
+ * \file      samesolve.c
+ *
+ * \brief     The Same Game v0.1 --> SOLVER TOOL File
+ *
+ * \details   Host tool which proves for numbered games whether they could be
+ * \n         cleared. All threads search the same board with another move
+ * \n         order and share one table of dead positions (Lazy SMP), the
+ * \n         first result stops the others. The table is kept from board to
+ * \n         board. Every solution is verified with the engine. An endgame
+ * \n         tablebase of sametb decides the positions with few blocks.
+ * \n
+ * \n         samesolve [-t threads] [-g first game] [-n games]
+ * \n                   [-c columns] [-r rows] [-k colors]
+ * \n                   [-b table bits] [-l seconds per board]
+ * \n                   [-e tablebase] [-x] [-v]
+ * \n
+ * \n         -x keys the table with the exact board hash, which tells
+ * \n         boards with renamed colors apart, to compare the table hits.
+ *
+ * \note      Hardware:    Linux host with pthreads
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "solver.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+#define TOOL_MAXTHREADS  256
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // one search thread
+  pthread_t Thread;
+  const SAGA_Board *pBoard;            // board to solve, shared
+  SOLV_Table *pTable;                  // dead positions, shared
+  int *pStop;                          // stop flag, shared
+  int *pDone;                          // finished threads, shared
+  int nOrder;                          // move order of the thread
+  int nResult;                         // result of SOLV_Solve
+  SAGA_Cell arrSolution[SAGA_MAXGROUPS];
+  SOLV_Stats Stats;
+}TOOL_Worker;
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Run                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Thread function of a worker
+ *
+ * \param     pArg --> worker
+ *
+ * \return    NULL
+ */
+/*===============================================================================*/
+static void *TOOL_Run(void *pArg)
+{
+  TOOL_Worker *pWorker = pArg;
+
+  pWorker->nResult = SOLV_Solve(pWorker->pBoard, pWorker->pTable, pWorker->nOrder,
+                                pWorker->pStop, pWorker->arrSolution, &pWorker->Stats);
+  __atomic_add_fetch(pWorker->pDone, 1, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Solve the games one after the other with all threads and
+ * \n         report each of them and a summary.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if all solutions are valid
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static TOOL_Worker arrWorkers[TOOL_MAXTHREADS];
+  struct timespec Sleep = { 0, 1000000 };
+  SAGA_Board Board;
+  SOLV_Table Table;
+  static TBL_Table Base;
+  const char *pBase = NULL;
+  SOLV_Stats Total = { 0 };
+  TOOL_Worker *pResult;
+  uint64_t nGame, nFirst = 1, nNodes, nProbes, nHits, nEndgames;
+  int nThreads = sysconf(_SC_NPROCESSORS_ONLN), nGames = 100, nColumns = NUMOFCOLUMN;
+  int nRows = NUMOFROWS, nColors = NUMOFCOLORS, nBits = 22, bVerbose = 0, bExact = 0;
+  int nCleared = 0, nDead = 0, nUnknown = 0, nInvalid = 0, nStop, nDone, i, nOpt;
+  double fLimit = 0, fStart, fTime, fTotal = 0, fWorst = 0;
+
+  while((nOpt = getopt(argc, argv, "t:g:n:c:r:k:b:l:e:xv")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 't': nThreads = atoi(optarg); break;
+      case 'g': nFirst = strtoull(optarg, NULL, 0); break;
+      case 'n': nGames = atoi(optarg); break;
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      case 'b': nBits = atoi(optarg); break;
+      case 'l': fLimit = atof(optarg); break;
+      case 'e': pBase = optarg; break;
+      case 'x': bExact = 1; break;
+      case 'v': bVerbose = 1; break;
+      default:
+        fprintf(stderr, "usage: %s [-t threads] [-g first game] [-n games] [-c columns] "
+                "[-r rows] [-k colors] [-b table bits] [-l seconds per board] [-e tablebase] [-x] "
+                "[-v]\n",
+                argv[0]);
+        return 2;
+    }
+  }
+  if(nThreads < 1 || nThreads > TOOL_MAXTHREADS || !SAGA_BoardIsValidSize(nColumns, nRows, nColors))
+  {
+    fprintf(stderr, "%s: board or thread count out of range\n", argv[0]);
+    return 2;
+  }
+  if(!SOLV_TableInit(&Table, nBits))
+  {
+    fprintf(stderr, "%s: no memory for 2^%d table slots\n", argv[0], nBits);
+    return 2;
+  }
+  Table.bExact = bExact;
+  if(pBase != NULL)
+  {
+    if(!TBL_Open(&Base, pBase))
+    {
+      fprintf(stderr, "%s: %s is no tablebase of this game\n", argv[0], pBase);
+      return 2;
+    }
+    Table.pBase = &Base;
+  }
+
+  for(nGame = nFirst; nGame < nFirst + nGames; nGame++)
+  {
+    SAGA_BoardInit(&Board, nColumns, nRows, nColors);
+    SAGA_BoardSetupGame(&Board, nGame);
+    nStop = 0;
+    nDone = 0;
+    fStart = TOOL_Now();
+    for(i = 0; i < nThreads; i++)
+    {
+      arrWorkers[i].pBoard = &Board;
+      arrWorkers[i].pTable = &Table;
+      arrWorkers[i].pStop = &nStop;
+      arrWorkers[i].pDone = &nDone;
+      arrWorkers[i].nOrder = i;
+      pthread_create(&arrWorkers[i].Thread, NULL, TOOL_Run, &arrWorkers[i]);
+    }
+    //  Give up on the board when the time is over
+    while(fLimit > 0 && __atomic_load_n(&nDone, __ATOMIC_ACQUIRE) < nThreads)
+    {
+      if(TOOL_Now() - fStart > fLimit)
+        __atomic_store_n(&nStop, 1, __ATOMIC_RELAXED);
+      nanosleep(&Sleep, NULL);
+    }
+    for(i = 0; i < nThreads; i++)
+      pthread_join(arrWorkers[i].Thread, NULL);
+    fTime = TOOL_Now() - fStart;
+
+    pResult = NULL;
+    nNodes = nProbes = nHits = nEndgames = 0;
+    for(i = 0; i < nThreads; i++)
+    {
+      if(pResult == NULL && arrWorkers[i].nResult != SOLV_STOPPED)
+        pResult = &arrWorkers[i];
+      nNodes += arrWorkers[i].Stats.nNodes;
+      nProbes += arrWorkers[i].Stats.nProbes;
+      nHits += arrWorkers[i].Stats.nHits;
+      nEndgames += arrWorkers[i].Stats.nEndgames;
+    }
+
+    printf("game %llu: ", (unsigned long long)nGame);
+    if(pResult == NULL)
+    {
+      printf("unknown");
+      nUnknown++;
+    }
+    else if(pResult->nResult == SOLV_DEAD)
+    {
+      printf("dead");
+      nDead++;
+    }
+    else if(!SAGA_BoardVerifySolution(&Board, pResult->arrSolution, pResult->nResult))
+    {
+      printf("INVALID solution");
+      nInvalid++;
+    }
+    else
+    {
+      printf("cleared in %d moves", pResult->nResult);
+      nCleared++;
+    }
+    printf(", %.3f s, %llu nodes, %.2f Mnodes/s, table hits %.1f%%, %llu endgames\n", fTime,
+           (unsigned long long)nNodes, nNodes / fTime * 1e-6, nProbes ? 100.0 * nHits / nProbes : 0,
+           (unsigned long long)nEndgames);
+    if(bVerbose && pResult != NULL && pResult->nResult > 0)
+    {
+      for(i = 0; i < pResult->nResult; i++)
+        printf(" %d,%d", pResult->arrSolution[i].row, pResult->arrSolution[i].col);
+      printf("\n");
+    }
+
+    Total.nNodes += nNodes;
+    Total.nProbes += nProbes;
+    Total.nHits += nHits;
+    Total.nEndgames += nEndgames;
+    fTotal += fTime;
+    if(fTime > fWorst)
+      fWorst = fTime;
+  }
+
+  printf("%d boards %dx%d with %d colors on %d threads: %d cleared, %d dead, %d unknown\n",
+         nGames, nColumns, nRows, nColors, nThreads, nCleared, nDead, nUnknown);
+  printf("%.3f s total, %.3f s worst, %.2f Mnodes/s, table hits %.1f%%, %llu endgames\n", fTotal,
+         fWorst, Total.nNodes / fTotal * 1e-6, Total.nProbes ? 100.0 * Total.nHits / Total.nProbes : 0,
+         (unsigned long long)Total.nEndgames);
+  SOLV_TableFree(&Table);
+  if(pBase != NULL)
+    TBL_Free(&Base);
+  return nInvalid > 0;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,231 @@
+/*********************************************************************************/
+/*!
+ * \file      sametb.c
+ *
+ * \brief     The Same Game v0.1 --> TABLEBASE TOOL File
+ *
+ * \details   Host tool which generates the endgame tablebase. All compacted
+ * \n         positions with up to the given number of blocks are numbered
+ * \n         by the tablebase and solved in order of their block count, a
+ * \n         move always leads to a position with fewer blocks which is
+ * \n         already solved. The positions of one block count are split
+ * \n         across the threads. Afterwards random positions are checked
+ * \n         against the exact solver.
+ * \n
+ * \n         sametb [-c columns] [-r rows] [-k colors] [-b blocks]
+ * \n                [-t threads] [-s checks] [-o file]
+ *
+ * \note      Hardware:    Linux host with pthreads
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "tablebase.h"
+#include "solver.h"
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+#define TOOL_MAXTHREADS  256
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // thread solving a slice of the positions with n blocks
+  pthread_t Thread;
+  TBL_Table *pTable;                   // table, shared
+  uint64_t nFirst, nLast;              // slice of the positions
+  uint64_t nClear;                     // positions of the slice which could be cleared
+  uint64_t nErrors;                    // positions whose number didn't come back
+}TOOL_Worker;
+
+//*==============================================================================*/
+/*  TOOL_Now                                                                     */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Monotonic time
+ *
+ * \param     none
+ *
+ * \return    seconds
+ */
+/*===============================================================================*/
+static double TOOL_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+//*==============================================================================*/
+/*  TOOL_Solve                                                                   */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     Thread function, solve a slice of positions
+ *
+ * \details   The empty board is cleared, a position without a move gets 0.
+ * \n         Every other position gets the value of its best move.
+ *
+ * \param     pArg --> worker
+ *
+ * \return    NULL
+ */
+/*===============================================================================*/
+static void *TOOL_Solve(void *pArg)
+{
+  TOOL_Worker *pWorker = pArg;
+  TBL_Table *pTable = pWorker->pTable;
+  SAGA_Board Board;
+  SAGA_Cell Move;
+  uint64_t nIndex;
+  int nValue;
+
+  pWorker->nClear = 0;
+  pWorker->nErrors = 0;
+  for(nIndex = pWorker->nFirst; nIndex < pWorker->nLast; nIndex++)
+  {
+    TBL_SetupBoard(pTable, nIndex, &Board);
+    pWorker->nErrors += TBL_GetIndex(pTable, &Board) != nIndex;
+    if(Board.nRemaining == 0)
+      nValue = TBL_CLEAR;
+    else if((nValue = TBL_GetBestMove(pTable, &Board, &Move)) < 0)
+      nValue = 0;
+    pTable->pValues[nIndex] = nValue;
+    pWorker->nClear += (nValue & TBL_CLEAR) != 0;
+  }
+  return NULL;
+}
+
+//*==============================================================================*/
+/*  main                                                                         */
+/*-------------------------------------------------------------------------------*/
+/*!
+ * \brief     MAIN Function
+ *
+ * \details   Generate the table block count by block count, check it and
+ * \n         write it to the file.
+ *
+ * \param     argc, argv
+ *
+ * \return    0 if the table was checked and written
+ */
+/*===============================================================================*/
+int main(int argc, char **argv)
+{
+  static TOOL_Worker arrWorkers[TOOL_MAXTHREADS];
+  static TBL_Table Table;
+  SAGA_Board Board;
+  SOLV_Table Dead;
+  const char *pPath = "endgame.tb";
+  uint64_t nCount, nClear, nErrors = 0, nIndex;
+  int nThreads = sysconf(_SC_NPROCESSORS_ONLN), nColumns = NUMOFCOLUMN, nRows = NUMOFROWS;
+  int nColors = NUMOFCOLORS, nBlocks = 10, nChecks = 1000, nWrong = 0, nStop, nResult, n, i, nOpt;
+  double fStart, fTime;
+
+  while((nOpt = getopt(argc, argv, "c:r:k:b:t:s:o:")) != -1)
+  {
+    switch(nOpt)
+    {
+      case 'c': nColumns = atoi(optarg); break;
+      case 'r': nRows = atoi(optarg); break;
+      case 'k': nColors = atoi(optarg); break;
+      case 'b': nBlocks = atoi(optarg); break;
+      case 't': nThreads = atoi(optarg); break;
+      case 's': nChecks = atoi(optarg); break;
+      case 'o': pPath = optarg; break;
+      default:
+        fprintf(stderr, "usage: %s [-c columns] [-r rows] [-k colors] [-b blocks] [-t threads] "
+                "[-s checks] [-o file]\n", argv[0]);
+        return 2;
+    }
+  }
+  if(nThreads < 1 || nThreads > TOOL_MAXTHREADS)
+  {
+    fprintf(stderr, "%s: thread count out of range\n", argv[0]);
+    return 2;
+  }
+  if(!TBL_Init(&Table, nColumns, nRows, nColors, nBlocks))
+  {
+    fprintf(stderr, "%s: board out of range or no memory for the table\n", argv[0]);
+    return 2;
+  }
+  printf("%dx%d with %d colors, up to %d blocks: %llu positions, %.1f MB\n", nColumns, nRows,
+         nColors, nBlocks, (unsigned long long)Table.nEntries, Table.nSize / 1048576.0);
+
+  //  Every block count only needs the smaller ones
+  fStart = TOOL_Now();
+  for(n = 0; n <= nBlocks; n++)
+  {
+    nCount = Table.arrFirst[n + 1] - Table.arrFirst[n];
+    for(i = 0; i < nThreads; i++)
+    {
+      arrWorkers[i].pTable = &Table;
+      arrWorkers[i].nFirst = Table.arrFirst[n] + nCount * i / nThreads;
+      arrWorkers[i].nLast = Table.arrFirst[n] + nCount * (i + 1) / nThreads;
+    }
+    for(i = 1; i < nThreads; i++)
+      pthread_create(&arrWorkers[i].Thread, NULL, TOOL_Solve, &arrWorkers[i]);
+    TOOL_Solve(&arrWorkers[0]);
+    for(i = 1; i < nThreads; i++)
+      pthread_join(arrWorkers[i].Thread, NULL);
+
+    for(i = 0, nClear = 0; i < nThreads; i++)
+    {
+      nClear += arrWorkers[i].nClear;
+      nErrors += arrWorkers[i].nErrors;
+    }
+    printf("%2d blocks: %12llu positions, %5.1f%% could be cleared\n", n,
+           (unsigned long long)nCount, 100.0 * nClear / nCount);
+    fflush(stdout);
+  }
+  fTime = TOOL_Now() - fStart;
+  printf("generated in %.1f s on %d threads, %.0f ns per position\n", fTime, nThreads,
+         fTime * 1e9 / Table.nEntries * nThreads);
+
+  //  Random positions must agree with the solver
+  if(nChecks > 0 && SOLV_TableInit(&Dead, 16))
+  {
+    srand(1);
+    for(i = 0; i < nChecks; i++)
+    {
+      nIndex = ((uint64_t)rand() << 31 ^ rand()) % Table.nEntries;
+      TBL_SetupBoard(&Table, nIndex, &Board);
+      nStop = 0;
+      nResult = SOLV_Solve(&Board, &Dead, 0, &nStop, NULL, NULL);
+      if((nResult >= 0) != ((Table.pValues[nIndex] & TBL_CLEAR) != 0))
+        nWrong++;
+    }
+    SOLV_TableFree(&Dead);
+    printf("%d random positions checked with the solver, %d wrong\n", nChecks, nWrong);
+  }
+  if(nErrors > 0)
+    printf("%llu positions got another number back\n", (unsigned long long)nErrors);
+
+  if(nErrors > 0 || nWrong > 0 || !TBL_Save(&Table, pPath))
+  {
+    fprintf(stderr, "%s: table not written\n", argv[0]);
+    TBL_Free(&Table);
+    return 1;
+  }
+  printf("written to %s\n", pPath);
+  TBL_Free(&Table);
+  return 0;
+}
+
+//----------------------------------- END --------------------------------------
@@ -0,0 +1,81 @@
+/*********************************************************************************/
+/*!
+ * \file      seedfile.h
+ *
+ * \brief     The Same Game v0.1 --> SEED RESULTS File
+ *
+ * \details   Binary results of a sweep over numbered games. sameseed writes
+ * \n         a shard, a header and one record for every game of its range
+ * \n         in the order of the games. sameshard merges shards into a
+ * \n         database, the records of all shards sorted by the game number
+ * \n         and an index of every SEED_STRIDE-th game behind them. All
+ * \n         numbers are little endian like the hosts.
+ *
+ * \note      Hardware:    Linux host
+ * \n         IDE:         GCC, see tools/Makefile
+ * \n         Licence:     GNU General Public License V3
+ * \n
+ * \warning   Copyright:   (C) by DiS-tronics Austria
+ *
+ * \author 	  DiS-tronics
+ * \date      October 2026
+ */
+/*********************************************************************************/
+#ifndef SEEDFILE_H
+#define SEEDFILE_H
+
+/*-------------------------------------------------------------------------------*/
+/*  Include files                                                                */
+/*-------------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*-------------------------------------------------------------------------------*/
+/*  Defines                                                                      */
+/*-------------------------------------------------------------------------------*/
+// solvers of a sweep
+#define SEED_GREEDY   0
+#define SEED_BEAM     1
+#define SEED_EXACT    2
+
+#define SEED_MAGIC    "SGSR"            // shard of sameseed
+#define SEED_DBMAGIC  "SGDB"            // database of sameshard
+#define SEED_VERSION  1
+
+// records per index entry of a database
+#define SEED_STRIDE   4096
+
+/*-------------------------------------------------------------------------------*/
+/*  Type definitions                                                             */
+/*-------------------------------------------------------------------------------*/
+typedef struct {  // start of a shard, the records follow
+	char arrMagic[4];                    // SEED_MAGIC
+	uint8_t nVersion;                    // SEED_VERSION
+	uint8_t nColumns, nRows, nColors;    // board of every game
+	uint8_t nSolver;                     // SEED_GREEDY, SEED_BEAM or SEED_EXACT
+	uint8_t nBits;                       // table bits of the exact solver
+	uint8_t arrReserved[2];
+	uint32_t nParam;                     // beam width or time limit in ms of the exact solver
+	uint64_t nFirst;                     // first game of the sweep
+	uint64_t nCount;                     // games of the sweep
+}SEED_Header;
+
+typedef struct {  // result of one game
+	uint64_t nSeed;                      // game number
+	uint64_t nNodes;                     // positions searched
+	uint32_t nMicros;                    // time of the solver
+	int32_t nScore;                      // best score, of the clearing line for the exact solver
+	int8_t nClear;                       // 1 cleared, 0 not cleared or dead, -1 unknown
+	uint8_t nMoves;                      // moves of the best line
+	uint8_t arrReserved[6];
+}SEED_Record;
+
+typedef struct {  // start of a database, the records and the index follow
+	char arrMagic[4];                    // SEED_DBMAGIC
+	uint32_t nStride;                    // SEED_STRIDE
+	uint64_t nRecords;                   // records, sorted by the game number
+	uint64_t nIndex;                     // file offset of the index, one game number per stride
+	SEED_Header Sweep;                   // parameters of the games, the range of all records
+}SEED_Database;
+
+//---------------------------------------------------------------------------------
+#endif // SEEDFILE_H